@@ -2,9 +2,38 @@
 #define _ADDONMANAGER_H_
 
 #include "gpaddon.h"
+#include "enums.pb.h"
 
+#include <type_traits>
 #include <vector>
 
+// Per add-on loop time budget in microseconds, 0 for none
+#ifndef ADDON_BUDGET_US
+#define ADDON_BUDGET_US 0
+#endif
+
+// Run add-ons that keep going over budget less often. Only the phases that don't feed the report
+// are demoted: core0 add-ons keep their preprocess and process every loop, so the inputs they
+// contribute don't drop out in the loops they would skip.
+#ifndef ADDON_DEMOTE_OVER_BUDGET
+#define ADDON_DEMOTE_OVER_BUDGET 0
+#endif
+
+// Loops per call of a demoted add-on
+#ifndef ADDON_DEMOTED_INTERVAL
+#define ADDON_DEMOTED_INTERVAL 8
+#endif
+
+// Consecutive loops over budget before an add-on is reported (and demoted)
+#define ADDON_OVERRUNS_BEFORE_REPORT 4
+
+#define ADDONMGR_NUM_CORES 2
+
+// Add-ons per core whose profile is kept across a reboot into web config
+#define ADDON_PROFILE_MAX_ADDONS 16
+#define ADDON_PROFILE_NAME_LENGTH 32
+#define ADDON_PROFILE_VERSION 1
+
 enum ADDON_PROCESS {
     CORE0_INPUT,
     CORE0_USBREPORT,
@@ -12,24 +41,119 @@ enum ADDON_PROCESS {
     CORE1_LOOP
 };
 
+enum ADDON_PHASE {
+    ADDON_PHASE_PREPROCESS,
+    ADDON_PHASE_PROCESS,
+    ADDON_PHASE_POSTPROCESS,
+    ADDON_PHASE_COUNT
+};
+
+struct AddonPhaseStats {
+    uint32_t lastUs;
+    uint32_t maxUs;
+    uint32_t avgUs16;       // moving average, in 1/16 us
+};
+
+// What the profiler keeps of an add-on, see AddonManager::InitProfile
+struct AddonProfile {
+    char name[ADDON_PROFILE_NAME_LENGTH];
+    AddonPhaseStats phases[ADDON_PHASE_COUNT];
+    uint32_t budgetUs;      // for all phases of one loop, 0 for none
+    uint32_t overruns;      // loops over budget
+    uint16_t interval;      // loops per call
+    bool overBudget;        // reported, and demoted if enabled
+};
+
 struct AddonBlock {
     GPAddon * ptr;
     ADDON_PROCESS process;
+    std::string name;               // cached, name() builds a new string every call
+    AddonProfile * profile;         // the kept profile, or localProfile until there is one
+    AddonProfile localProfile = {};
+    uint32_t loopUs = 0;            // time spent in the current loop
+    uint8_t overrunStreak = 0;
+    bool active = true;             // runs in the current loop
+    uint16_t countdown = 0;
+};
+
+// A phase of one add-on, called directly rather than through the vtable
+typedef void (*AddonPhaseFunction)(GPAddon*, bool);
+
+struct AddonPhaseCall {
+    AddonPhaseFunction function;
+    GPAddon * addon;
+    AddonBlock * block;
+    bool demotable;         // skipped in the loops a demoted add-on doesn't run
+};
+
+// The phases an add-on type implements itself, GPAddon's are empty
+template<class T>
+struct AddonPhases {
+    static const bool hasPreprocess = !std::is_same<decltype(&T::preprocess), void (GPAddon::*)()>::value;
+    static const bool hasProcess = !std::is_same<decltype(&T::process), void (GPAddon::*)()>::value;
+    static const bool hasPostprocess = !std::is_same<decltype(&T::postprocess), void (GPAddon::*)(bool)>::value;
+    static const bool hasReinit = !std::is_same<decltype(&T::reinit), void (GPAddon::*)()>::value;
+
+    static void preprocess(GPAddon* addon, bool) { static_cast<T*>(addon)->T::preprocess(); }
+    static void process(GPAddon* addon, bool) { static_cast<T*>(addon)->T::process(); }
+    static void postprocess(GPAddon* addon, bool sent) { static_cast<T*>(addon)->T::postprocess(sent); }
 };
 
 class AddonManager {
 public:
     AddonManager() {}
     ~AddonManager() {}
-    bool LoadAddon(GPAddon*);
-    bool LoadUSBAddon(GPAddon*);
+
+    // Add-ons are loaded as their own type, to see which phases they implement
+    template<class T>
+    bool LoadAddon(T* addon) {
+        static_assert(std::is_base_of<GPAddon, T>::value && !std::is_same<GPAddon, T>::value,
+            "load add-ons as their own type");
+        const AddonPhaseFunction functions[ADDON_PHASE_COUNT] = {
+            AddonPhases<T>::hasPreprocess ? AddonPhases<T>::preprocess : nullptr,
+            AddonPhases<T>::hasProcess ? AddonPhases<T>::process : nullptr,
+            AddonPhases<T>::hasPostprocess ? AddonPhases<T>::postprocess : nullptr,
+        };
+        return loadAddon(addon, functions, AddonPhases<T>::hasReinit);
+    }
+    template<class T>
+    bool LoadUSBAddon(T* addon) {
+        bool ret = LoadAddon(addon);
+        if ( ret == true )
+            pushUSBListener(addon);
+        return ret;
+    }
     void ReinitializeAddons();
     void PreprocessAddons();
     void ProcessAddons();
     void PostprocessAddons(bool);
     GPAddon * GetAddon(std::string); // hack for NeoPicoLED
+
+    const std::vector<AddonBlock*>& GetAddonBlocks() const { return addons; }
+    // The manager whose add-ons run on the given core, if any
+    static AddonManager * GetManager(uint8_t core) { return core < ADDONMGR_NUM_CORES ? managers[core] : nullptr; }
+
+    // The profiles are kept in uninitialized RAM, so that those of a gamepad mode session can still
+    // be read after rebooting into web config. Called once the input mode is known: starts new
+    // profiles, taking in the add-ons already loaded, unless booting into web config with valid
+    // ones to read.
+    static void InitProfile(InputMode inputMode);
+    static bool IsPreviousBootProfile();
+    static uint8_t GetProfileCount(uint8_t core);
+    static const AddonProfile * GetProfile(uint8_t core, uint8_t index);
 private:
+    bool loadAddon(GPAddon*, const AddonPhaseFunction functions[ADDON_PHASE_COUNT], bool hasReinit);
+    void pushUSBListener(GPAddon*);
+    void runPhase(ADDON_PHASE, bool reportSent);
+    void keepProfile(AddonBlock*, uint8_t core);
+    void startLoop(AddonBlock*);
+    void recordPhase(AddonBlock*, ADDON_PHASE, uint32_t elapsedUs);
+
     std::vector<AddonBlock*> addons;    // addons currently loaded
+    std::vector<AddonPhaseCall> phaseCalls[ADDON_PHASE_COUNT];  // only the add-ons implementing each phase
+    std::vector<GPAddon*> reinitAddons;
+    bool budgeted = false;              // some add-on has a time budget
+    static AddonManager * managers[ADDONMGR_NUM_CORES];
 };
 
 #endif
@@ -137,9 +137,6 @@ public:
     virtual bool available();
     virtual void setup();       // Analog Setup
     virtual void process();     // Analog Process
-    virtual void preprocess() {}
-    virtual void postprocess(bool sent) {}
-    virtual void reinit() {}
     virtual std::string name() { return AnalogName; }
 private:
     float readPin(int stick_num, Pin_t pin, uint16_t center);
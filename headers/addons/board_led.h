@@ -29,9 +29,6 @@ public:
     virtual bool available();
     virtual void setup();       // BoardLed Setup
     virtual void process();     // BoardLed Process
-    virtual void preprocess() {}
-    virtual void postprocess(bool sent) {}
-    virtual void reinit() {}
     virtual std::string name() { return OnBoardLedName; }
 private:
     OnBoardLedMode onBoardLedMode;
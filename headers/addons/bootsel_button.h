@@ -19,10 +19,7 @@ class BootselButtonAddon : public GPAddon {
 public:
     virtual bool available();
     virtual void setup();       // BootselButton Setup
-    virtual void process() {}     // BootselButton Process
     virtual void preprocess();
-    virtual void postprocess(bool sent) {}
-    virtual void reinit() {}
     virtual std::string name() { return BootselButtonName; }
 private:	
     bool isBootselPressed();
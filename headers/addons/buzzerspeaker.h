@@ -131,10 +131,7 @@ class BuzzerSpeakerAddon : public GPAddon
 public:
     virtual bool available();
     virtual void setup();
-    virtual void preprocess() {}
     virtual void process();
-    virtual void postprocess(bool sent) {}
-    virtual void reinit() {}
     virtual std::string name() { return BuzzerSpeakerName; }
 private:
     void processBuzzer();
@@ -215,16 +215,13 @@ class DisplayAddon : public GPAddon
 public:
     virtual bool available();
     virtual void setup();
-    virtual void preprocess() {}
     virtual void process();
-    virtual void postprocess(bool sent) {}
-    virtual void reinit() {}
     virtual std::string name() { return DisplayName; }
 
-    void handleProfileChange(GPEvent* e);
-    void handleSystemRestart(GPEvent* e);
-    void handleMenuNavigation(GPEvent* e);
-    void handleSystemError(GPEvent* e);
+    void handleProfileChange(const GPEvent* e);
+    void handleSystemRestart(const GPEvent* e);
+    void handleMenuNavigation(const GPEvent* e);
+    void handleSystemError(const GPEvent* e);
 private:
     bool updateDisplayScreen();
     void setMenuMappings();
@@ -49,10 +49,7 @@ class DRV8833RumbleAddon : public GPAddon
 public:
     virtual bool available();
     virtual void setup();
-    virtual void preprocess() {}
     virtual void process();
-    virtual void postprocess(bool sent) {}
-    virtual void reinit() {}
     virtual std::string name() { return DRV8833RumbleName; }
 private:
     uint32_t pwmSetFreqDuty(uint slice, uint channel, uint32_t frequency, float duty);
@@ -21,15 +21,11 @@ public:
     virtual bool available();
     virtual void setup();       // Dual Directional Setup
     virtual void process();     // Dual Directional Process
-    virtual void postprocess(bool sent) {}
     virtual void reinit();
     virtual void preprocess();  // Dual Directional Pre-Process (Cheat)
     virtual std::string name() { return DualDirectionalName; }
 private:
     uint8_t gpadToBinary(DpadMode, GamepadState);
-    uint8_t updateDpadDDI(uint8_t dpad, DpadDirection direction);
-    uint8_t filterToFourWayModeDDI(uint8_t dpad);
-    void SOCDDualClean(SOCDMode);
     uint8_t SOCDCombine(SOCDMode, uint8_t);
     uint8_t SOCDGamepadClean(uint8_t, bool isLastWin);
     void OverrideGamepad(Gamepad *, DpadMode, uint8_t);
@@ -37,8 +33,7 @@ private:
     uint8_t dualState;          // Dual Directional State
     DpadDirection lastGPUD; // Gamepad Last Up-Down
     DpadDirection lastGPLR; // Gamepad Last Left-Right
-    DpadDirection lastDualUD; // Dual Last Up-Down
-    DpadDirection lastDualLR; // Gamepad Last Left-Right
+    SOCDState dualSOCD;       // Dual SOCD and 4-way history
     GamepadButtonMapping *mapDpadUp;
     GamepadButtonMapping *mapDpadDown;
     GamepadButtonMapping *mapDpadLeft;
@@ -552,10 +552,7 @@ class HETriggerAddon : public GPAddon {
 public:
     virtual bool available();
     virtual void setup();
-    virtual void process() {}
     virtual void preprocess();
-    virtual void postprocess(bool sent) {}
-    virtual void reinit() {}
     virtual std::string name() { return HETriggerAddonName; }
 private:
     void selectChannel(uint8_t channel);
@@ -140,10 +140,7 @@ class PCF8575Addon : public GPAddon {
 public:
     virtual bool available();
     virtual void setup();
-    virtual void preprocess() {}
     virtual void process();
-    virtual void postprocess(bool sent) {}
-    virtual void reinit() {}
     virtual std::string name() { return PCF8575AddonName; }
 
     std::map<uint8_t, GpioMappingInfo> pinRef;
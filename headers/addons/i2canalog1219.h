@@ -43,10 +43,7 @@ class I2CAnalog1219Input : public GPAddon {
 public:
     virtual bool available();
     virtual void setup();       // Analog Setup
-    virtual void preprocess() {}
     virtual void process();     // Analog Process
-    virtual void postprocess(bool sent) {}
-    virtual void reinit() {}
     virtual std::string name() { return I2CAnalog1219Name; }
 private:
     ADS1219Device * ads;
@@ -36,9 +36,7 @@ class InputMacro : public GPAddon {
 public:
     virtual bool available();   // GPAddon available
     virtual void setup();       // Analog Setup
-    virtual void process() {};     // Analog Process
     virtual void preprocess();
-    virtual void postprocess(bool sent) {}
     virtual void reinit();
     virtual std::string name() { return InputMacroName; }
 private:
@@ -224,10 +224,7 @@ class NeoPicoLEDAddon : public GPAddon {
 public:
     virtual bool available();
     virtual void setup();
-    virtual void preprocess() {}
     virtual void process();
-    virtual void postprocess(bool sent) {}
-    virtual void reinit() {}
     virtual std::string name() { return NeoPicoLEDName; }    
 	void ambientLightLinkage(); 
     
@@ -36,10 +36,7 @@ class PlayerLEDAddon : public GPAddon
 public:
     virtual bool available();
     virtual void setup();
-    virtual void preprocess() {}
     virtual void process();
-    virtual void postprocess(bool sent) {}
-    virtual void reinit() {}
     virtual std::string name() { return PLEDName; }
     PlayerLEDAddon() {
         type = static_cast<PLEDType>(Storage::getInstance().getLedOptions().pledType);
@@ -32,10 +32,7 @@ class ReactiveLEDAddon : public GPAddon
     public:
         virtual bool available();
         virtual void setup();
-        virtual void preprocess() {}
         virtual void process();
-        virtual void postprocess(bool sent) {}
-        virtual void reinit() {}
         virtual std::string name() { return ReactiveLEDName; }
     private:
         struct ReactiveLEDPinState {
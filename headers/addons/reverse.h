@@ -40,9 +40,7 @@ class ReverseInput : public GPAddon {
 public:
     virtual bool available();
     virtual void setup();       // Reverse Button Setup
-    virtual void preprocess() {}
     virtual void process();     // Reverse process
-    virtual void postprocess(bool sent) {}
     virtual void reinit();
     virtual std::string name() { return ReverseName; }
 private:
@@ -53,10 +51,10 @@ private:
 
     uint8_t pinLED;
 
-    GamepadButtonMapping *mapDpadUp;
-    GamepadButtonMapping *mapDpadDown;
-    GamepadButtonMapping *mapDpadLeft;
-    GamepadButtonMapping *mapDpadRight;
+    const GamepadButtonMapping *mapDpadUp;
+    const GamepadButtonMapping *mapDpadDown;
+    const GamepadButtonMapping *mapDpadLeft;
+    const GamepadButtonMapping *mapDpadRight;
     GamepadButtonMapping *mapInputReverse;
 
     bool invertXAxis;
@@ -30,9 +30,7 @@ public:
     virtual bool available();
     virtual void setup();       // SliderSOCD Button Setup
     virtual void reinit();
-    virtual void preprocess() {}
     virtual void process();     // SliderSOCD process
-    virtual void postprocess(bool sent) {}
     virtual std::string name() { return SliderSOCDName; }
 private:
     SOCDMode read();
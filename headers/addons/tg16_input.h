@@ -41,9 +41,6 @@ public:
     virtual bool available();
     virtual void setup();       // TG16pad Setup
     virtual void process();     // TG16pad Process
-    virtual void preprocess() {}
-    virtual void postprocess(bool sent) {}
-    virtual void reinit() {}
     virtual std::string name() { return TG16padName; }
 private:
     uint32_t uIntervalMS;
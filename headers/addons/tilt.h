@@ -96,11 +96,9 @@ public:
     virtual void setup();       // Tilt Setup
     virtual void process();     // Tilt Process
     virtual void preprocess();  // Tilt Pre-Process (Cheat)
-    virtual void postprocess(bool sent) {}
-    virtual void reinit() {}
     virtual std::string name() { return TiltName; }
 
-    void handleProfileChange(GPEvent* e);
+    void handleProfileChange(const GPEvent* e);
 private:
     void SOCDTiltClean(SOCDMode);
     uint8_t SOCDCombine(SOCDMode, uint8_t);
@@ -104,12 +104,10 @@ public:
     virtual bool available();
     virtual void setup();       // TURBO Button Setup
     virtual void reinit();
-    virtual void preprocess() {}
     virtual void process();     // TURBO Setting of buttons (Enable/Disable)
-    virtual void postprocess(bool sent) {}
     virtual std::string name() { return TurboName; }
 
-    void handleEncoder(GPEvent* e);
+    void handleEncoder(const GPEvent* e);
 private:
     void updateTurboShotCount(uint8_t turboShotCount, bool save = true);
     Mask_t turboPinMask;        // Pin mask for Turbo pin
@@ -0,0 +1,41 @@
+#ifndef _BOOTPROFILE_H_
+#define _BOOTPROFILE_H_
+
+#include <cstdint>
+
+#define BOOT_PROFILE_VERSION 2
+
+// In boot order, as far as one core goes
+enum BootPhase : uint8_t {
+    BOOT_PHASE_CONFIG_LOADED = 0,   // ConfigUtils::load, all but the deferred config sections
+    BOOT_PHASE_PERIPHERALS,         // USB host, SPI and I2C blocks
+    BOOT_PHASE_CORE0_ADDONS,        // input add-ons set up
+    BOOT_PHASE_CORE0_SETUP,
+    BOOT_PHASE_USB_INIT,            // tud_init, the device can enumerate from here on
+    BOOT_PHASE_CONFIG_COMPLETE,     // ConfigUtils::loadDeferred, on core1
+    BOOT_PHASE_CORE1_SETUP,         // display, LED, ... add-ons set up
+    BOOT_PHASE_LOOP,                // core0 loop running
+    BOOT_PHASE_USB_MOUNTED,
+
+    BOOT_PHASE_COUNT
+};
+
+/**
+ * @brief Time since reset at which each boot phase was reached, to see where boot time goes.
+ *
+ * Only the first time a phase is reached counts, a later remount doesn't move USB_MOUNTED. Kept
+ * in uninitialized RAM along with the times of the boot before, so that rebooting into web config
+ * still shows how the gamepad mode boot went.
+ */
+namespace BootProfile {
+    // First thing in main(), before any phase is marked
+    void init();
+    void mark(BootPhase phase);
+
+    // 0 when not reached (yet), or no earlier boot was traced
+    uint32_t getUs(BootPhase phase);
+    uint32_t getPreviousUs(BootPhase phase);
+    const char* getPhaseName(BootPhase phase);
+}
+
+#endif
@@ -5,7 +5,12 @@
 #include <string>
 
 namespace ConfigUtils {
+    // Decodes all but the sections not needed until after USB enumeration when it can, see loadDeferred()
     void load(Config& config);
+    // Decodes the rest of the config, if load() left anything out. Safe to call from either core.
+    void loadDeferred(Config& config);
+    // Whether the deferred sections couldn't be decoded and were set to their defaults instead
+    bool loadDeferredFailed();
     bool save(Config& config);
     
     void initUnsetPropertiesWithDefaults(Config& config);
@@ -0,0 +1,60 @@
+#ifndef _CONFIGLOG_H_
+#define _CONFIGLOG_H_
+
+#include <cstdint>
+
+// Flash geometry the log is laid out on: records start on a page, erases clear whole sectors
+#define CONFIG_LOG_PAGE_SIZE   256
+#define CONFIG_LOG_SECTOR_SIZE 4096
+
+#define CONFIG_LOG_MAGIC 0x474f4c43 // CLOG
+
+/**
+ * Start of every record, followed by the serialized config. Stored as-is, little endian.
+ */
+struct ConfigLogHeader {
+    uint32_t magic;
+    uint32_t sequence;      // one more than the record before it
+    uint32_t dataSize;
+    uint32_t dataCrc;
+    uint32_t headerCrc;     // of the fields above
+};
+
+struct ConfigLogRecord {
+    bool valid = false;
+    uint32_t offset = 0;    // of the header, from the start of the region
+    uint32_t end = 0;       // first page after the record
+    uint32_t sequence = 0;
+    uint32_t dataSize = 0;
+    uint32_t dataCrc = 0;
+    uint32_t nextSequence = 1;  // above any header in the region, also ones whose data is broken
+
+    const uint8_t* data(const uint8_t* region) const { return region + offset + sizeof(ConfigLogHeader); }
+};
+
+/**
+ * @brief Append-only log of config records over the FlashPROM region.
+ *
+ * Each save appends a record after the newest one, on the next page, instead of rewriting the
+ * whole region. Appending only programs pages that are still erased. Once the log reaches the
+ * end of the region it wraps around to the start, and only then do the sectors it runs into
+ * need erasing, oldest records first. The newest record is never erased to make room for the
+ * next one, so a save cut short by a power loss leaves the previous config in place. At boot
+ * the newest record with valid CRCs wins.
+ *
+ * Works on a copy of the region in memory (the FlashPROM write cache) and doesn't touch the
+ * flash, so it can be run against a simulated flash.
+ */
+namespace ConfigLog {
+    // Newest valid record in the region
+    ConfigLogRecord findLatest(const uint8_t* region, uint32_t regionSize);
+
+    // Make room for a record of dataSize bytes after latest, erasing (setting to 0xFF) the
+    // sectors in the way, and return where its data goes, nullptr when it can't fit
+    uint8_t* reserve(uint8_t* region, uint32_t regionSize, const ConfigLogRecord& latest, uint32_t dataSize,
+        ConfigLogRecord& record);
+    // Write the header of a reserved record once its data is in place
+    void seal(uint8_t* region, ConfigLogRecord& record, uint32_t dataCrc);
+}
+
+#endif
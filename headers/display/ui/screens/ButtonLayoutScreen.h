@@ -114,8 +114,8 @@ class ButtonLayoutScreen : public GPScreen {
         virtual void init();
         virtual void shutdown();
 
-        void handleProfileChange(GPEvent* e);
-        void handleUSB(GPEvent* e);
+        void handleProfileChange(const GPEvent* e);
+        void handleUSB(const GPEvent* e);
     protected:
         virtual void drawScreen();
     private:
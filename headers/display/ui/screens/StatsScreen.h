@@ -13,7 +13,9 @@ class StatsScreen : public GPScreen {
         virtual void shutdown();
     protected:
         virtual void drawScreen();
+        void drawLoopStats();
         uint16_t prevButtonState = 0;
+        uint8_t page = 0; // 0: build info, then the loop stats pages
 
         GPLabel* header;
         GPLabel* version;
@@ -26,7 +26,7 @@ public:
     virtual const uint8_t * get_descriptor_device_qualifier_cb();
     virtual uint16_t GetJoystickMidValue();
     virtual USBListener * get_usb_auth_listener() { return nullptr; }
-    void handleEncoder(GPEvent* e); // for Volume - rotary encoder
+    void handleEncoder(const GPEvent* e); // for Volume - rotary encoder
 private:
     void releaseAllKeys(void);
 	void pressKey(uint8_t code);
@@ -8,6 +8,8 @@
 #include <array>
 #include <functional>
 #include <cctype>
+#include "hardware/sync.h"
+
 #include "config.pb.h"
 #include "enums.pb.h"
 
@@ -24,10 +26,47 @@
 
 #define EVENTMGR EventManager::getInstance()
 
+// Events waiting for the other core, per core. Must be a power of two.
+#define EVENTMGR_QUEUE_SIZE 16
+#define EVENTMGR_NUM_CORES 2
+
+// Handlers per event type
+#define EVENTMGR_MAX_HANDLERS 16
+#define EVENTMGR_NUM_EVENT_TYPES (_GPEventType_MAX + 1)
+
+/**
+ * @brief Single producer, single consumer ring of events bound for one core.
+ *
+ * The other core is the only producer and the owning core the only consumer, so the indices need
+ * no locking, only a barrier between writing a slot and publishing it. The RP2040 has no atomic
+ * read-modify-write instructions to do more with anyway.
+ */
+class EventQueue {
+    public:
+        bool push(const GPEvent& event);
+        const GPEvent* peek();
+        void pop();
+
+        uint32_t getDropped() const { return dropped; }
+    private:
+        struct alignas(8) Slot {
+            uint8_t data[GPEVENT_MAX_SIZE];
+        };
+
+        Slot slots[EVENTMGR_QUEUE_SIZE];
+        volatile uint32_t head = 0; // written by the producer
+        volatile uint32_t tail = 0; // written by the consumer
+        uint32_t dropped = 0;
+};
+
 class EventManager {
     public:
-        typedef std::function<void(GPEvent* event)> EventFunction;
-        typedef std::pair<GPEventType, std::vector<EventFunction>> EventEntry;
+        typedef void (*EventFunction)(void* context, const GPEvent* event);
+        struct EventHandler {
+            EventFunction function; // null when the slot is free
+            void* context;
+            uint8_t core;           // the core that registered it, and the only one to run it
+        };
 
         EventManager(EventManager const&) = delete;
         void operator=(EventManager const&)  = delete;
@@ -40,13 +79,38 @@ class EventManager {
         void init();
         void clearEventHandlers();
 
-        void registerEventHandler(GPEventType eventType, EventFunction handler);
-        void unregisterEventHandler(GPEventType eventType, EventFunction handler);
-        void triggerEvent(GPEvent* event);
+        // Handlers run on the core that registered them, see triggerEvent(), and must be
+        // unregistered from that core too
+        bool registerEventHandler(GPEventType eventType, EventFunction function, void* context);
+        void unregisterEventHandler(GPEventType eventType, EventFunction function, void* context);
+        // Events are owned by the caller, usually a temporary on its stack, and only live for the
+        // duration of the call. Handlers must copy anything they want to keep.
+        // Handlers registered on the calling core are run immediately, handlers registered on the
+        // other core run when that core next calls processEvents().
+        void triggerEvent(const GPEvent& event);
+        // Run the handlers for events queued for the calling core
+        void processEvents();
+
+        uint32_t getDroppedEvents(uint8_t core) const { return eventQueues[core].getDropped(); }
+
+        // Average time in nanoseconds to trigger an event with the given number of trivial handlers
+        uint32_t benchmarkDispatch(uint8_t subscribers, uint32_t iterations);
     private:
-        EventManager(){}
+        EventManager();
+
+        // Handlers for one event type. Unregistering frees a slot in place rather than closing
+        // the gap, so the other core can dispatch from the list while it changes, and registering
+        // reuses the first free slot.
+        struct EventHandlerList {
+            EventHandler handlers[EVENTMGR_MAX_HANDLERS];
+            volatile uint8_t count; // slots in use, or free below the last one in use
+        };
+
+        void dispatchEvent(const GPEvent& event, uint8_t core, bool& otherCore);
 
-        std::vector<EventEntry> eventList;
+        EventHandlerList eventHandlers[EVENTMGR_NUM_EVENT_TYPES];
+        EventQueue eventQueues[EVENTMGR_NUM_CORES];
+        spin_lock_t* handlerLock; // serializes registering and unregistering across the cores
 };
 
 #endif
\ No newline at end of file
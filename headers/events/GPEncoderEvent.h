@@ -13,7 +13,8 @@ class GPEncoderChangeEvent : public GPEvent {
         uint8_t encoder = 0;
         int8_t direction = 0;
 
-        GPEventType eventType() { return this->_eventType; }
+        GPEventType eventType() const { return this->_eventType; }
+        GPEVENT_COPYABLE(GPEncoderChangeEvent)
     private:
         GPEventType _eventType = GP_EVENT_ENCODER_CHANGE;
 };
@@ -1,14 +1,36 @@
 #ifndef _GPEVENT_H_
 #define _GPEVENT_H_
 
-#define GPEVENT_CALLBACK(x) ([this](GPEvent* event){x;})
+#include <new>
+
+class GPEvent;
+
+// Calls a member function handler on the context object it was registered with
+template<class T, void (T::*Handler)(const GPEvent*)>
+void GPEventCallback(void* context, const GPEvent* event) {
+    (static_cast<T*>(context)->*Handler)(event);
+}
+
+// Handler for a registerEventHandler(type, GPEVENT_CALLBACK(Class, method), this) call
+#define GPEVENT_CALLBACK(T, method) (&GPEventCallback<T, &T::method>)
+
+// Largest event that can be queued for the other core, see EventManager
+#define GPEVENT_MAX_SIZE 80
+
+// Lets an event be copied into a queue slot. Every concrete event class must use this.
+#define GPEVENT_COPYABLE(T) \
+    GPEvent* copyTo(void* buffer) const override { \
+        static_assert(sizeof(T) <= GPEVENT_MAX_SIZE, #T " is larger than GPEVENT_MAX_SIZE"); \
+        return new (buffer) T(*this); \
+    }
 
 class GPEvent {
     public:
         GPEvent() {}
         virtual ~GPEvent() {}
 
-        virtual GPEventType eventType() { return this->_eventType; }
+        virtual GPEventType eventType() const { return this->_eventType; }
+        virtual GPEvent* copyTo(void* buffer) const { return new (buffer) GPEvent(*this); }
     private:
         GPEventType _eventType = GP_EVENT_BASE;
 };
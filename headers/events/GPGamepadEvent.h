@@ -3,128 +3,126 @@
 
 #include "gamepad.h"
 
-class GPGamepadEvent : public GPEvent {
-    public:
-        GPGamepadEvent() {}
-        GPGamepadEvent(GamepadState currState) { this->state = currState; }
-        GPGamepadEvent(uint8_t dpad, uint16_t buttons, uint16_t aux) {
-            this->state.dpad = dpad;
-            this->state.buttons = buttons;
-            this->state.aux = aux;
-        }
-        GPGamepadEvent(uint16_t lx, uint16_t ly, uint16_t rx, uint16_t ry, uint8_t lt, uint8_t rt) {
-            this->state.lx = lx;
-            this->state.ly = ly;
-            this->state.rx = rx;
-            this->state.ry = ry;
-            this->state.lt = lt;
-            this->state.rt = rt;
-        }
-        GPGamepadEvent(uint8_t dpad, uint16_t buttons, uint16_t aux, uint16_t lx, uint16_t ly, uint16_t rx, uint16_t ry, uint8_t lt, uint8_t rt) {
-            this->state.dpad = dpad;
-            this->state.buttons = buttons;
-            this->state.aux = aux;
-            this->state.lx = lx;
-            this->state.ly = ly;
-            this->state.rx = rx;
-            this->state.ry = ry;
-            this->state.lt = lt;
-            this->state.rt = rt;
-        }
-        virtual ~GPGamepadEvent() {}
-        
-        GamepadState state;
-    private:
-};
-
-class GPButtonEvent : public GPGamepadEvent {
-    public:
-        GPButtonEvent() {}
-        GPButtonEvent(GamepadState currState) : GPGamepadEvent(currState) {}
-        GPButtonEvent(uint8_t dpad, uint16_t buttons, uint16_t aux) : GPGamepadEvent(dpad, buttons, aux) {}
-        ~GPButtonEvent() {}
-    private:
-};
+// What changed in a GPInputFrameEvent
+#define GP_INPUT_FRAME_RAW          (1U << 0)   // the digital inputs read from the pins
+#define GP_INPUT_FRAME_PROCESSED    (1U << 1)   // the digital inputs after hotkeys, SOCD and add-ons
+#define GP_INPUT_FRAME_ANALOG       (1U << 2)   // the processed sticks and triggers
 
-class GPButtonUpEvent : public GPButtonEvent {
-    public:
-        GPButtonUpEvent() {}
-        GPButtonUpEvent(GamepadState currState) : GPButtonEvent(currState) {}
-        GPButtonUpEvent(uint8_t dpad, uint16_t buttons, uint16_t aux) : GPButtonEvent(dpad, buttons, aux) {}
-        ~GPButtonUpEvent() {}
+struct GPInputFrameButtons {
+    uint32_t buttons = 0;
+    uint16_t aux = 0;
+    uint8_t dpad = 0;
 
-        GPEventType eventType() { return this->_eventType; }
-    private:
-        GPEventType _eventType = GP_EVENT_BUTTON_UP;
+    bool any() const { return buttons != 0 || aux != 0 || dpad != 0; }
 };
 
-class GPButtonDownEvent : public GPButtonEvent {
-    public:
-        GPButtonDownEvent() {}
-        GPButtonDownEvent(GamepadState currState) : GPButtonEvent(currState) {}
-        GPButtonDownEvent(uint8_t dpad, uint16_t buttons, uint16_t aux) : GPButtonEvent(dpad, buttons, aux) {}
-        ~GPButtonDownEvent() {}
+struct GPInputFrameAnalog {
+    uint16_t lx = GAMEPAD_JOYSTICK_MID;
+    uint16_t ly = GAMEPAD_JOYSTICK_MID;
+    uint16_t rx = GAMEPAD_JOYSTICK_MID;
+    uint16_t ry = GAMEPAD_JOYSTICK_MID;
+    uint8_t lt = 0;
+    uint8_t rt = 0;
+};
 
-        GPEventType eventType() { return this->_eventType; }
-    private:
-        GPEventType _eventType = GP_EVENT_BUTTON_DOWN;
+struct GPInputFrameAnalogDelta {
+    int32_t lx;
+    int32_t ly;
+    int32_t rx;
+    int32_t ry;
+    int16_t lt;
+    int16_t rt;
 };
 
-class GPButtonProcessedUpEvent : public GPButtonEvent {
+/**
+ * @brief Everything that changed in the inputs in one core0 loop, raised once at most per loop.
+ *
+ * Carries the raw and processed digital inputs before and after the loop, and the processed
+ * analog values, so a consumer subscribes once and picks what it needs. The event is a member
+ * of GP2040, filled in place as the loop goes.
+ */
+class GPInputFrameEvent : public GPEvent {
     public:
-        GPButtonProcessedUpEvent() {}
-        GPButtonProcessedUpEvent(GamepadState currState) : GPButtonEvent(currState) {}
-        GPButtonProcessedUpEvent(uint8_t dpad, uint16_t buttons, uint16_t aux) : GPButtonEvent(dpad, buttons, aux) {}
-        ~GPButtonProcessedUpEvent() {}
+        GPInputFrameEvent() {}
+        virtual ~GPInputFrameEvent() {}
 
-        GPEventType eventType() { return this->_eventType; }
-    private:
-        GPEventType _eventType = GP_EVENT_BUTTON_PROCESSED_UP;
-};
+        GPEventType eventType() const { return this->_eventType; }
+        GPEVENT_COPYABLE(GPInputFrameEvent)
 
-class GPButtonProcessedDownEvent : public GPButtonEvent {
-    public:
-        GPButtonProcessedDownEvent() {}
-        GPButtonProcessedDownEvent(GamepadState currState) : GPButtonEvent(currState) {}
-        GPButtonProcessedDownEvent(uint8_t dpad, uint16_t buttons, uint16_t aux) : GPButtonEvent(dpad, buttons, aux) {}
-        ~GPButtonProcessedDownEvent() {}
+        // Starts a new frame
+        void setRaw(const GamepadState& prevState, const GamepadState& currState) {
+            rawPrevious = buttonsOf(prevState);
+            raw = buttonsOf(currState);
+            changes = sameButtons(rawPrevious, raw) ? 0 : GP_INPUT_FRAME_RAW;
+        }
 
-        GPEventType eventType() { return this->_eventType; }
-    private:
-        GPEventType _eventType = GP_EVENT_BUTTON_PROCESSED_DOWN;
-};
+        void setProcessed(const GamepadState& prevState, const GamepadState& currState) {
+            processedPrevious = buttonsOf(prevState);
+            processed = buttonsOf(currState);
+            if (!sameButtons(processedPrevious, processed))
+                changes |= GP_INPUT_FRAME_PROCESSED;
+
+            analogPrevious = analogOf(prevState);
+            analog = analogOf(currState);
+            if (analog.lx != analogPrevious.lx || analog.ly != analogPrevious.ly ||
+                analog.rx != analogPrevious.rx || analog.ry != analogPrevious.ry ||
+                analog.lt != analogPrevious.lt || analog.rt != analogPrevious.rt)
+                changes |= GP_INPUT_FRAME_ANALOG;
+        }
 
-class GPAnalogEvent : public GPGamepadEvent {
-    public:
-        GPAnalogEvent() {}
-        GPAnalogEvent(GamepadState currState) : GPGamepadEvent(currState) {}
-        GPAnalogEvent(uint16_t lx, uint16_t ly, uint16_t rx, uint16_t ry, uint8_t lt, uint8_t rt) : GPGamepadEvent(lx, ly, rx, ry, lt, rt) {}
-        ~GPAnalogEvent() {}
+        GPInputFrameButtons rawDown() const { return changed(rawPrevious, raw); }
+        GPInputFrameButtons rawUp() const { return changed(raw, rawPrevious); }
+        GPInputFrameButtons processedDown() const { return changed(processedPrevious, processed); }
+        GPInputFrameButtons processedUp() const { return changed(processed, processedPrevious); }
+        GPInputFrameAnalogDelta analogDelta() const {
+            return {
+                (int32_t)analog.lx - analogPrevious.lx, (int32_t)analog.ly - analogPrevious.ly,
+                (int32_t)analog.rx - analogPrevious.rx, (int32_t)analog.ry - analogPrevious.ry,
+                (int16_t)(analog.lt - analogPrevious.lt), (int16_t)(analog.rt - analogPrevious.rt)
+            };
+        }
+
+        uint8_t changes = 0;    // GP_INPUT_FRAME_RAW, etc.
+        GPInputFrameButtons rawPrevious;
+        GPInputFrameButtons raw;
+        GPInputFrameButtons processedPrevious;
+        GPInputFrameButtons processed;
+        GPInputFrameAnalog analogPrevious;
+        GPInputFrameAnalog analog;
     private:
-};
+        static GPInputFrameButtons buttonsOf(const GamepadState& state) {
+            GPInputFrameButtons result;
+            result.buttons = state.buttons;
+            result.aux = state.aux;
+            result.dpad = state.dpad;
+            return result;
+        }
 
-class GPAnalogMoveEvent : public GPAnalogEvent {
-    public:
-        GPAnalogMoveEvent() {}
-        GPAnalogMoveEvent(GamepadState currState) : GPAnalogEvent(currState) {}
-        GPAnalogMoveEvent(uint16_t lx, uint16_t ly, uint16_t rx, uint16_t ry, uint8_t lt, uint8_t rt) : GPAnalogEvent(lx, ly, rx, ry, lt, rt) {}
-        ~GPAnalogMoveEvent() {}
+        static GPInputFrameAnalog analogOf(const GamepadState& state) {
+            GPInputFrameAnalog result;
+            result.lx = state.lx;
+            result.ly = state.ly;
+            result.rx = state.rx;
+            result.ry = state.ry;
+            result.lt = state.lt;
+            result.rt = state.rt;
+            return result;
+        }
 
-        GPEventType eventType() { return this->_eventType; }
-    private:
-        GPEventType _eventType = GP_EVENT_ANALOG_MOVE;
-};
+        static bool sameButtons(const GPInputFrameButtons& a, const GPInputFrameButtons& b) {
+            return a.buttons == b.buttons && a.aux == b.aux && a.dpad == b.dpad;
+        }
 
-class GPAnalogProcessedMoveEvent : public GPAnalogEvent {
-    public:
-        GPAnalogProcessedMoveEvent() {}
-        GPAnalogProcessedMoveEvent(GamepadState currState) : GPAnalogEvent(currState) {}
-        GPAnalogProcessedMoveEvent(uint16_t lx, uint16_t ly, uint16_t rx, uint16_t ry, uint8_t lt, uint8_t rt) : GPAnalogEvent(lx, ly, rx, ry, lt, rt) {}
-        ~GPAnalogProcessedMoveEvent() {}
+        // Bits set in after but not in before
+        static GPInputFrameButtons changed(const GPInputFrameButtons& before, const GPInputFrameButtons& after) {
+            GPInputFrameButtons result;
+            result.buttons = after.buttons & ~before.buttons;
+            result.aux = after.aux & ~before.aux;
+            result.dpad = after.dpad & ~before.dpad;
+            return result;
+        }
 
-        GPEventType eventType() { return this->_eventType; }
-    private:
-        GPEventType _eventType = GP_EVENT_ANALOG_PROCESSED_MOVE;
+        GPEventType _eventType = GP_EVENT_INPUT_FRAME;
 };
 
-#endif
\ No newline at end of file
+#endif
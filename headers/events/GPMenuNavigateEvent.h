@@ -11,7 +11,8 @@ class GPMenuNavigateEvent : public GPEvent {
         }
         virtual ~GPMenuNavigateEvent() {}
 
-        GPEventType eventType() { return this->_eventType; }
+        GPEventType eventType() const { return this->_eventType; }
+        GPEVENT_COPYABLE(GPMenuNavigateEvent)
 
         GpioAction menuAction;
     private:
@@ -10,7 +10,8 @@ class GPProfileChangeEvent : public GPEvent {
         }
         virtual ~GPProfileChangeEvent() {}
 
-        GPEventType eventType() { return this->_eventType; }
+        GPEventType eventType() const { return this->_eventType; }
+        GPEVENT_COPYABLE(GPProfileChangeEvent)
 
         uint8_t previousValue;
         uint8_t currentValue;
@@ -11,7 +11,8 @@ class GPRestartEvent : public GPEvent {
         }
         virtual ~GPRestartEvent() {}
 
-        GPEventType eventType() { return this->_eventType; }
+        GPEventType eventType() const { return this->_eventType; }
+        GPEVENT_COPYABLE(GPRestartEvent)
 
         System::BootMode bootMode;
     private:
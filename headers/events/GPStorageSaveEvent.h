@@ -12,7 +12,8 @@ class GPStorageSaveEvent : public GPEvent {
         }
         virtual ~GPStorageSaveEvent() {}
 
-        GPEventType eventType() { return this->_eventType; }
+        GPEventType eventType() const { return this->_eventType; }
+        GPEVENT_COPYABLE(GPStorageSaveEvent)
 
         bool forceSave = false;
         bool restartAfterSave = false;
@@ -2,18 +2,22 @@
 #define _GPSYSTEMERROREVENT_H_
 
 #include "system.h"
+#include <string.h>
+
+#define GPEVENT_SYSTEM_ERROR_MESSAGE_LENGTH 64
 
 class GPSystemErrorEvent : public GPEvent {
     public:
         GPSystemErrorEvent() {}
-        GPSystemErrorEvent(std::string message) {
-            this->errorMessage = message;
+        GPSystemErrorEvent(const char* message) {
+            strncpy(this->errorMessage, message, sizeof(this->errorMessage) - 1);
         }
         virtual ~GPSystemErrorEvent() {}
 
-        GPEventType eventType() { return this->_eventType; }
+        GPEventType eventType() const { return this->_eventType; }
+        GPEVENT_COPYABLE(GPSystemErrorEvent)
 
-        std::string errorMessage;
+        char errorMessage[GPEVENT_SYSTEM_ERROR_MESSAGE_LENGTH] = {0};
     private:
         GPEventType _eventType = GP_EVENT_SYSTEM_ERROR;
 };
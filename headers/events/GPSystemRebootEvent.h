@@ -11,7 +11,8 @@ class GPSystemRebootEvent : public GPEvent {
         }
         virtual ~GPSystemRebootEvent() {}
 
-        GPEventType eventType() { return this->_eventType; }
+        GPEventType eventType() const { return this->_eventType; }
+        GPEVENT_COPYABLE(GPSystemRebootEvent)
 
         System::BootMode bootMode = System::BootMode::DEFAULT;
     private:
@@ -23,7 +23,8 @@ class GPUSBHostMountEvent : public GPUSBHostEvent {
         GPUSBHostMountEvent(uint8_t devAddr, uint16_t vid, uint16_t pid) : GPUSBHostEvent(devAddr, vid, pid) {}
         virtual ~GPUSBHostMountEvent() {}
 
-        GPEventType eventType() { return this->_eventType; }
+        GPEventType eventType() const { return this->_eventType; }
+        GPEVENT_COPYABLE(GPUSBHostMountEvent)
     private:
         GPEventType _eventType = GP_EVENT_USBHOST_MOUNT;
 };
@@ -34,7 +35,8 @@ class GPUSBHostUnmountEvent : public GPUSBHostEvent {
         GPUSBHostUnmountEvent(uint8_t devAddr, uint16_t vid, uint16_t pid) : GPUSBHostEvent(devAddr, vid, pid) {}
         virtual ~GPUSBHostUnmountEvent() {}
 
-        GPEventType eventType() { return this->_eventType; }
+        GPEventType eventType() const { return this->_eventType; }
+        GPEVENT_COPYABLE(GPUSBHostUnmountEvent)
     private:
         GPEventType _eventType = GP_EVENT_USBHOST_UNMOUNT;
 };
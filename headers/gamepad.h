@@ -9,11 +9,17 @@
 #include "enums.pb.h"
 #include "gamepad/GamepadState.h"
 #include "gamepad/GamepadAuxState.h"
+#include "gamepad/GamepadDecoder.h"
+#include "gamepad/GamepadHotkeys.h"
+#include "gamepad/SOCDState.h"
 
 #include "pico/stdlib.h"
 
 #include "config.pb.h"
 
+// The core mappings plus every alternative profile
+#define GAMEPAD_MAX_PROFILES (1 + sizeof(ProfileOptions::gpioMappingsSets) / sizeof(GpioMappings))
+
 // MUST BE DEFINED FOR MPG
 extern uint32_t getMillis();
 extern uint64_t getMicro();
@@ -29,6 +35,74 @@ struct GamepadButtonMapping
 	const uint32_t buttonMask;
 };
 
+/**
+ * @brief The pins of every input the gamepad reads itself, one set for each profile.
+ */
+struct GamepadMappings
+{
+	GamepadButtonMapping mapDpadUp       {GAMEPAD_MASK_UP};
+	GamepadButtonMapping mapDpadDown     {GAMEPAD_MASK_DOWN};
+	GamepadButtonMapping mapDpadLeft     {GAMEPAD_MASK_LEFT};
+	GamepadButtonMapping mapDpadRight    {GAMEPAD_MASK_RIGHT};
+	GamepadButtonMapping mapButtonB1     {GAMEPAD_MASK_B1};
+	GamepadButtonMapping mapButtonB2     {GAMEPAD_MASK_B2};
+	GamepadButtonMapping mapButtonB3     {GAMEPAD_MASK_B3};
+	GamepadButtonMapping mapButtonB4     {GAMEPAD_MASK_B4};
+	GamepadButtonMapping mapButtonL1     {GAMEPAD_MASK_L1};
+	GamepadButtonMapping mapButtonR1     {GAMEPAD_MASK_R1};
+	GamepadButtonMapping mapButtonL2     {GAMEPAD_MASK_L2};
+	GamepadButtonMapping mapButtonR2     {GAMEPAD_MASK_R2};
+	GamepadButtonMapping mapButtonS1     {GAMEPAD_MASK_S1};
+	GamepadButtonMapping mapButtonS2     {GAMEPAD_MASK_S2};
+	GamepadButtonMapping mapButtonL3     {GAMEPAD_MASK_L3};
+	GamepadButtonMapping mapButtonR3     {GAMEPAD_MASK_R3};
+	GamepadButtonMapping mapButtonA1     {GAMEPAD_MASK_A1};
+	GamepadButtonMapping mapButtonA2     {GAMEPAD_MASK_A2};
+	GamepadButtonMapping mapButtonA3     {GAMEPAD_MASK_A3};
+	GamepadButtonMapping mapButtonA4     {GAMEPAD_MASK_A4};
+	GamepadButtonMapping mapButtonE1     {GAMEPAD_MASK_E1};
+	GamepadButtonMapping mapButtonE2     {GAMEPAD_MASK_E2};
+	GamepadButtonMapping mapButtonE3     {GAMEPAD_MASK_E3};
+	GamepadButtonMapping mapButtonE4     {GAMEPAD_MASK_E4};
+	GamepadButtonMapping mapButtonE5     {GAMEPAD_MASK_E5};
+	GamepadButtonMapping mapButtonE6     {GAMEPAD_MASK_E6};
+	GamepadButtonMapping mapButtonE7     {GAMEPAD_MASK_E7};
+	GamepadButtonMapping mapButtonE8     {GAMEPAD_MASK_E8};
+	GamepadButtonMapping mapButtonE9     {GAMEPAD_MASK_E9};
+	GamepadButtonMapping mapButtonE10    {GAMEPAD_MASK_E10};
+	GamepadButtonMapping mapButtonE11    {GAMEPAD_MASK_E11};
+	GamepadButtonMapping mapButtonE12    {GAMEPAD_MASK_E12};
+	GamepadButtonMapping mapButtonFn     {AUX_MASK_FUNCTION};
+	GamepadButtonMapping mapButtonDP     {SUSTAIN_DP_MODE_DP};
+	GamepadButtonMapping mapButtonLS     {SUSTAIN_DP_MODE_LS};
+	GamepadButtonMapping mapButtonRS     {SUSTAIN_DP_MODE_RS};
+	GamepadButtonMapping mapDigitalUp    {GAMEPAD_MASK_UP};
+	GamepadButtonMapping mapDigitalDown  {GAMEPAD_MASK_DOWN};
+	GamepadButtonMapping mapDigitalLeft  {GAMEPAD_MASK_LEFT};
+	GamepadButtonMapping mapDigitalRight {GAMEPAD_MASK_RIGHT};
+	GamepadButtonMapping mapAnalogLSXNeg {ANALOG_DIRECTION_LS_X_NEG};
+	GamepadButtonMapping mapAnalogLSXPos {ANALOG_DIRECTION_LS_X_POS};
+	GamepadButtonMapping mapAnalogLSYNeg {ANALOG_DIRECTION_LS_Y_NEG};
+	GamepadButtonMapping mapAnalogLSYPos {ANALOG_DIRECTION_LS_Y_POS};
+	GamepadButtonMapping mapAnalogRSXNeg {ANALOG_DIRECTION_RS_X_NEG};
+	GamepadButtonMapping mapAnalogRSXPos {ANALOG_DIRECTION_RS_X_POS};
+	GamepadButtonMapping mapAnalogRSYNeg {ANALOG_DIRECTION_RS_Y_NEG};
+	GamepadButtonMapping mapAnalogRSYPos {ANALOG_DIRECTION_RS_Y_POS};
+	GamepadButtonMapping map48WayMode    {SUSTAIN_4_8_WAY_MODE};
+	GamepadButtonMapping mapFocusMode    {SUSTAIN_FOCUS_MODE};
+};
+
+/**
+ * @brief Everything the gamepad needs of a profile, compiled at setup, see Gamepad::setup.
+ */
+struct GamepadProfile
+{
+	GamepadMappings mappings;
+	GamepadDecoder decoder;
+	// the action of each pin the gamepad doesn't read itself, which add-ons may
+	GpioAction addonActions[NUM_BANK0_GPIOS];
+};
+
 class Gamepad {
 public:
 	Gamepad();
@@ -79,18 +153,10 @@ public:
 		return (state.aux & mask) == mask;
 	}
 
-	/**
-	 * @brief Check for a hotkey combination press. Checks aux, buttons, and dpad.
-	 */
-	inline bool __attribute__((always_inline)) pressedHotkey(const HotkeyEntry hotkey) {
-		return (hotkey.action != 0 && pressedButton(hotkey.buttonsMask) &&
-				pressedDpad(hotkey.dpadMask) && pressedAux(hotkey.auxMask));
-	}
-
 	/**
 	 * @brief Remove hotkey bits from the state bitmask and provide pressed action.
 	 */
-	inline GamepadHotkey __attribute__((always_inline)) selectHotkey(const HotkeyEntry hotkey) {
+	inline GamepadHotkey __attribute__((always_inline)) selectHotkey(const HotkeyEntry& hotkey) {
 		state.buttons &= ~(hotkey.buttonsMask);
 		state.dpad &= ~(hotkey.dpadMask);
 		return static_cast<GamepadHotkey>(hotkey.action);
@@ -136,59 +202,14 @@ public:
 	void setSOCDMode(SOCDMode socdMode) { options.socdMode = socdMode; }
 	void setDpadMode(DpadMode dpadMode) { options.dpadMode = dpadMode; }
 
+	// The current profile's pin masks
+	const GamepadMappings& getMappings() const { return profile->mappings; }
+	// Whether the two profiles give the pins the gamepad doesn't read itself the same actions
+	bool sharesAddonPins(uint32_t profileNumber, uint32_t otherProfileNumber) const;
+
 	GamepadState state;
 	GamepadState turboState;
 	GamepadAuxState auxState;
-	GamepadButtonMapping *mapDpadUp;
-	GamepadButtonMapping *mapDpadDown;
-	GamepadButtonMapping *mapDpadLeft;
-	GamepadButtonMapping *mapDpadRight;
-	GamepadButtonMapping *mapButtonB1;
-	GamepadButtonMapping *mapButtonB2;
-	GamepadButtonMapping *mapButtonB3;
-	GamepadButtonMapping *mapButtonB4;
-	GamepadButtonMapping *mapButtonL1;
-	GamepadButtonMapping *mapButtonR1;
-	GamepadButtonMapping *mapButtonL2;
-	GamepadButtonMapping *mapButtonR2;
-	GamepadButtonMapping *mapButtonS1;
-	GamepadButtonMapping *mapButtonS2;
-	GamepadButtonMapping *mapButtonL3;
-	GamepadButtonMapping *mapButtonR3;
-	GamepadButtonMapping *mapButtonA1;
-	GamepadButtonMapping *mapButtonA2;
-	GamepadButtonMapping *mapButtonA3;
-	GamepadButtonMapping *mapButtonA4;
-	GamepadButtonMapping *mapButtonE1;
-	GamepadButtonMapping *mapButtonE2;
-	GamepadButtonMapping *mapButtonE3;
-	GamepadButtonMapping *mapButtonE4;
-	GamepadButtonMapping *mapButtonE5;
-	GamepadButtonMapping *mapButtonE6;
-	GamepadButtonMapping *mapButtonE7;
-	GamepadButtonMapping *mapButtonE8;
-	GamepadButtonMapping *mapButtonE9;
-	GamepadButtonMapping *mapButtonE10;
-	GamepadButtonMapping *mapButtonE11;
-	GamepadButtonMapping *mapButtonE12;
-	GamepadButtonMapping *mapButtonFn;
-	GamepadButtonMapping *mapButtonDP;
-	GamepadButtonMapping *mapButtonLS;
-	GamepadButtonMapping *mapButtonRS;
-	GamepadButtonMapping *mapDigitalUp;
-	GamepadButtonMapping *mapDigitalDown;
-	GamepadButtonMapping *mapDigitalLeft;
-	GamepadButtonMapping *mapDigitalRight;
-	GamepadButtonMapping *mapAnalogLSXNeg;
-	GamepadButtonMapping *mapAnalogLSXPos;
-	GamepadButtonMapping *mapAnalogLSYNeg;
-	GamepadButtonMapping *mapAnalogLSYPos;
-	GamepadButtonMapping *mapAnalogRSXNeg;
-	GamepadButtonMapping *mapAnalogRSXPos;
-	GamepadButtonMapping *mapAnalogRSYNeg;
-	GamepadButtonMapping *mapAnalogRSYPos;
-	GamepadButtonMapping *map48WayMode;
-	GamepadButtonMapping *mapFocusMode;
 
 	// gamepad specific proxy of debounced buttons --- 1 = active (inverse of the raw GPIO)
 	// see GP2040::debounceGpioGetAll for details
@@ -208,13 +229,29 @@ public:
 
 private:
 	void processHotkeyAction(GamepadHotkey action);
+	void assignButtonMappings(const GpioMappingInfo* pinMappings, GamepadProfile& target);
+	void buildDecoder(GamepadProfile& target);
+	const GamepadProfile* getProfile(uint32_t profileNumber) const;
+
+	// compiled pin masks and pin-to-input tables of every enabled profile, see Gamepad::setup
+	GamepadProfile* profiles[GAMEPAD_MAX_PROFILES] = {};
+	const GamepadProfile* profile = nullptr;	// the current one
+
+	// SOCD and 4-way history of the gamepad's own dpad
+	SOCDState socdState;
 
 	GamepadOptions & options;
 	DpadMode activeDpadMode;
 	bool map48WayModeToggle;
 	const HotkeyOptions & hotkeyOptions;
 
-	HotkeyEntry hotkeys[16];
+	// compiled at setup, matched only when the inputs change, see Gamepad::hotkey
+	GamepadHotkeys hotkeys;
+	uint32_t matchedHotkeys = 0;
+	bool hotkeyInputsValid = false;
+	uint32_t hotkeyButtons = 0;
+	uint8_t hotkeyDpad = 0;
+	uint16_t hotkeyAux = 0;
 	GamepadHotkey lastAction = HOTKEY_NONE;
 
 	absolute_time_t disableFocusModeTimeout = nil_time;
@@ -213,3 +213,107 @@
 #ifndef HOTKEY_16_ACTION
 #define HOTKEY_16_ACTION 0
 #endif
+
+#ifndef HOTKEY_17_AUX_MASK
+#define HOTKEY_17_AUX_MASK 0
+#endif
+#ifndef HOTKEY_17_BUTTONS_MASK
+#define HOTKEY_17_BUTTONS_MASK 0
+#endif
+#ifndef HOTKEY_17_DPAD_MASK
+#define HOTKEY_17_DPAD_MASK 0
+#endif
+#ifndef HOTKEY_17_ACTION
+#define HOTKEY_17_ACTION 0
+#endif
+
+#ifndef HOTKEY_18_AUX_MASK
+#define HOTKEY_18_AUX_MASK 0
+#endif
+#ifndef HOTKEY_18_BUTTONS_MASK
+#define HOTKEY_18_BUTTONS_MASK 0
+#endif
+#ifndef HOTKEY_18_DPAD_MASK
+#define HOTKEY_18_DPAD_MASK 0
+#endif
+#ifndef HOTKEY_18_ACTION
+#define HOTKEY_18_ACTION 0
+#endif
+
+#ifndef HOTKEY_19_AUX_MASK
+#define HOTKEY_19_AUX_MASK 0
+#endif
+#ifndef HOTKEY_19_BUTTONS_MASK
+#define HOTKEY_19_BUTTONS_MASK 0
+#endif
+#ifndef HOTKEY_19_DPAD_MASK
+#define HOTKEY_19_DPAD_MASK 0
+#endif
+#ifndef HOTKEY_19_ACTION
+#define HOTKEY_19_ACTION 0
+#endif
+
+#ifndef HOTKEY_20_AUX_MASK
+#define HOTKEY_20_AUX_MASK 0
+#endif
+#ifndef HOTKEY_20_BUTTONS_MASK
+#define HOTKEY_20_BUTTONS_MASK 0
+#endif
+#ifndef HOTKEY_20_DPAD_MASK
+#define HOTKEY_20_DPAD_MASK 0
+#endif
+#ifndef HOTKEY_20_ACTION
+#define HOTKEY_20_ACTION 0
+#endif
+
+#ifndef HOTKEY_21_AUX_MASK
+#define HOTKEY_21_AUX_MASK 0
+#endif
+#ifndef HOTKEY_21_BUTTONS_MASK
+#define HOTKEY_21_BUTTONS_MASK 0
+#endif
+#ifndef HOTKEY_21_DPAD_MASK
+#define HOTKEY_21_DPAD_MASK 0
+#endif
+#ifndef HOTKEY_21_ACTION
+#define HOTKEY_21_ACTION 0
+#endif
+
+#ifndef HOTKEY_22_AUX_MASK
+#define HOTKEY_22_AUX_MASK 0
+#endif
+#ifndef HOTKEY_22_BUTTONS_MASK
+#define HOTKEY_22_BUTTONS_MASK 0
+#endif
+#ifndef HOTKEY_22_DPAD_MASK
+#define HOTKEY_22_DPAD_MASK 0
+#endif
+#ifndef HOTKEY_22_ACTION
+#define HOTKEY_22_ACTION 0
+#endif
+
+#ifndef HOTKEY_23_AUX_MASK
+#define HOTKEY_23_AUX_MASK 0
+#endif
+#ifndef HOTKEY_23_BUTTONS_MASK
+#define HOTKEY_23_BUTTONS_MASK 0
+#endif
+#ifndef HOTKEY_23_DPAD_MASK
+#define HOTKEY_23_DPAD_MASK 0
+#endif
+#ifndef HOTKEY_23_ACTION
+#define HOTKEY_23_ACTION 0
+#endif
+
+#ifndef HOTKEY_24_AUX_MASK
+#define HOTKEY_24_AUX_MASK 0
+#endif
+#ifndef HOTKEY_24_BUTTONS_MASK
+#define HOTKEY_24_BUTTONS_MASK 0
+#endif
+#ifndef HOTKEY_24_DPAD_MASK
+#define HOTKEY_24_DPAD_MASK 0
+#endif
+#ifndef HOTKEY_24_ACTION
+#define HOTKEY_24_ACTION 0
+#endif
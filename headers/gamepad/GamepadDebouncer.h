@@ -0,0 +1,61 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "types.h"
+#include "enums.pb.h"
+
+// Number of bit planes in the vertical counter, which counts up to 31 ticks
+#define GAMEPAD_DEBOUNCER_COUNTER_BITS 5
+#define GAMEPAD_DEBOUNCER_MAX_TICKS    ((1 << GAMEPAD_DEBOUNCER_COUNTER_BITS) - 1)
+
+/**
+ * @brief Bit-parallel GPIO debouncer.
+ *
+ * Each pin has a 5 bit counter of the ticks since its raw level started to disagree with its
+ * debounced level, stored as a vertical counter: bit N of every pin's counter lives in plane N.
+ * Every pin is updated at once with a handful of word-wide boolean operations, and a pin only
+ * changes state once its counter reaches the tick threshold for the configured delay. A tick is
+ * a millisecond for delays up to 31 ms, longer delays stretch it so the threshold fits.
+ *
+ * Depending on the mode, presses and/or releases may instead be passed through immediately, in
+ * which case only the opposite edge is delayed. The lockout mode passes both edges immediately
+ * and then ignores the pin until its counter reaches the threshold, so a bouncing contact can't
+ * change state twice.
+ */
+class GamepadDebouncer
+{
+public:
+	GamepadDebouncer();
+
+	void configure(uint32_t delayMs, DebounceMode mode);
+	void reset();
+	void settle();
+	bool isCounting() const { return counting; }
+
+	Mask_t update(Mask_t raw, Mask_t debounced, uint32_t now) { return update(raw, debounced, now, now, 0, now); }
+	Mask_t update(Mask_t raw, Mask_t debounced, uint32_t now, uint32_t since, Mask_t bounced, uint32_t bouncedSince);
+private:
+	Mask_t updateLockout(Mask_t raw, Mask_t debounced, uint32_t since);
+
+	void advance(uint32_t now);
+	void load(Mask_t pins, uint32_t since);
+	void keep(Mask_t pins);
+	Mask_t reached(Mask_t pins) const;
+
+	uint32_t delayMs;
+	DebounceMode mode;
+
+	uint32_t tickMs;          // length of one counter tick
+	uint32_t thresholdTicks;  // ticks a pin has to disagree for, or stay locked out
+	uint32_t lastTick;        // the tick the counters were last advanced to
+	bool counting;            // false while every pin agrees with its debounced state, or may change
+
+	Mask_t pending;           // pins counting towards a change
+	Mask_t locked;            // pins ignored after an edge, in the lockout mode
+	Mask_t counter[GAMEPAD_DEBOUNCER_COUNTER_BITS];
+};
@@ -0,0 +1,78 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "types.h"
+
+// The bank0 GPIO word is decoded four pins at a time
+#define GAMEPAD_DECODER_SLICE_BITS 4
+#define GAMEPAD_DECODER_SLICES     (32 / GAMEPAD_DECODER_SLICE_BITS)
+
+// Decoded inputs that don't map directly onto GamepadState button/dpad bits
+#define GAMEPAD_DECODER_FUNCTION    (1U << 0)
+#define GAMEPAD_DECODER_DPAD_DP     (1U << 1)
+#define GAMEPAD_DECODER_DPAD_LS     (1U << 2)
+#define GAMEPAD_DECODER_DPAD_RS     (1U << 3)
+#define GAMEPAD_DECODER_4_8_WAY     (1U << 4)
+
+// Digital-to-analog stick directions
+#define GAMEPAD_DECODER_LS_X_NEG    (1U << 0)
+#define GAMEPAD_DECODER_LS_X_POS    (1U << 1)
+#define GAMEPAD_DECODER_LS_Y_NEG    (1U << 2)
+#define GAMEPAD_DECODER_LS_Y_POS    (1U << 3)
+#define GAMEPAD_DECODER_RS_X_NEG    (1U << 4)
+#define GAMEPAD_DECODER_RS_X_POS    (1U << 5)
+#define GAMEPAD_DECODER_RS_Y_NEG    (1U << 6)
+#define GAMEPAD_DECODER_RS_Y_POS    (1U << 7)
+
+/**
+ * @brief The combined contribution of a set of pressed pins, OR-able into the result of other slices.
+ */
+struct GamepadDecoderEntry
+{
+	uint32_t buttons;
+	uint8_t dpad;    // low nibble: dpad mode directions, high nibble: digital-only directions
+	uint8_t analog;  // GAMEPAD_DECODER_LS_X_NEG, etc.
+	uint8_t flags;   // GAMEPAD_DECODER_FUNCTION, etc.
+	uint8_t reserved;
+};
+
+/**
+ * @brief Table driven pin-to-input decoder.
+ *
+ * Every 4-bit slice of the debounced GPIO word indexes a 16 entry table holding the combined
+ * contribution of the pins in that slice, so decoding the whole word is one lookup and OR per
+ * slice regardless of how many buttons are mapped. The tables are rebuilt in place whenever the
+ * pin mappings change. Nibble (rather than byte) slices keep a decoder at 1 KB of RAM.
+ */
+class GamepadDecoder
+{
+public:
+	void clear();
+
+	void addButtons(Mask_t pinMask, uint32_t buttons);
+	void addDpad(Mask_t pinMask, uint8_t dpad);
+	void addAnalog(Mask_t pinMask, uint8_t analog);
+	void addFlags(Mask_t pinMask, uint8_t flags);
+
+	inline GamepadDecoderEntry __attribute__((always_inline)) decode(Mask_t values) const {
+		GamepadDecoderEntry result = {0, 0, 0, 0, 0};
+		for (uint8_t slice = 0; slice < GAMEPAD_DECODER_SLICES; slice++) {
+			const GamepadDecoderEntry& entry = table[slice][(values >> (slice * GAMEPAD_DECODER_SLICE_BITS)) & 0x0F];
+			result.buttons |= entry.buttons;
+			result.dpad |= entry.dpad;
+			result.analog |= entry.analog;
+			result.flags |= entry.flags;
+		}
+		return result;
+	}
+
+private:
+	void add(Mask_t pinMask, const GamepadDecoderEntry& contribution);
+
+	GamepadDecoderEntry table[GAMEPAD_DECODER_SLICES][1 << GAMEPAD_DECODER_SLICE_BITS];
+};
@@ -0,0 +1,58 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "config.pb.h"
+
+// Hotkeys a matcher can hold, one bit each in the candidate masks
+#define GAMEPAD_HOTKEYS_MAX 32
+
+// Time allowed between the first and second step of a chord
+#ifndef HOTKEY_CHORD_TIMEOUT_MS
+#define HOTKEY_CHORD_TIMEOUT_MS 750
+#endif
+
+/**
+ * @brief Hotkey entries compiled for matching only when the inputs change.
+ *
+ * Hotkeys are grouped by their aux (Fn) mask, so a change of inputs only checks the groups
+ * whose modifiers are held, in the order the hotkeys were added. A hotkey with a first step
+ * (firstDpadMask/firstButtonsMask/firstAuxMask) is a chord: its first combination has to be
+ * pressed, then its own combination within HOTKEY_CHORD_TIMEOUT_MS. Chords keep their progress
+ * between changes, so they don't cost anything while the inputs are steady either.
+ */
+class GamepadHotkeys
+{
+public:
+	void clear();
+	bool add(const HotkeyEntry& entry);
+
+	// The hotkeys to step through, in order, when the inputs change
+	uint32_t candidates(uint16_t aux) const;
+	// Whether a hotkey's combination is held, and chords moved along. Once per hotkey and change of inputs
+	bool step(uint8_t index, uint32_t buttons, uint8_t dpad, uint16_t aux, uint32_t nowMs);
+
+	const HotkeyEntry& get(uint8_t index) const { return entries[index]; }
+	uint8_t count() const { return entryCount; }
+
+private:
+	struct Group
+	{
+		uint16_t auxMask;
+		uint32_t hotkeys;
+	};
+
+	HotkeyEntry entries[GAMEPAD_HOTKEYS_MAX];
+	uint8_t entryCount = 0;
+	Group groups[GAMEPAD_HOTKEYS_MAX];
+	uint8_t groupCount = 0;
+
+	uint32_t chords = 0;        // hotkeys with a first step, always candidates
+	uint32_t armed = 0;         // chords whose first step was pressed...
+	uint32_t armedMs[GAMEPAD_HOTKEYS_MAX];  // ...at this time
+	uint32_t latched = 0;       // chords completed and still held
+};
@@ -159,24 +159,3 @@ uint16_t dpadToAnalogX(uint8_t dpad);
 uint16_t dpadToAnalogY(uint8_t dpad);
 
 uint8_t getMaskFromDirection(DpadDirection direction);
-
-uint8_t updateDpad(uint8_t dpad, DpadDirection direction);
-
-/**
- * @brief Filter diagonals out of the dpad, making the device work as a 4-way lever.
- *
- * The most recent cardinal direction wins.
- *
- * @param dpad The GameState.dpad value.
- * @return uint8_t The new dpad value.
- */
-uint8_t filterToFourWayMode(uint8_t dpad);
-
-/**
- * @brief Run SOCD cleaning against a D-pad value.
- *
- * @param mode The SOCD cleaning mode.
- * @param dpad The GamepadState.dpad value.
- * @return uint8_t The clean D-pad value.
- */
-uint8_t runSOCDCleaner(SOCDMode mode, uint8_t dpad);
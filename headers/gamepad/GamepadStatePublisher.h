@@ -0,0 +1,34 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "GamepadState.h"
+#include "GamepadAuxState.h"
+
+/**
+ * @brief Seqlock handoff of the processed gamepad state from core0 to core1.
+ *
+ * Core0 publishes once per loop and never waits. The sequence is odd while a publish is in
+ * progress, so core1 retries any copy that overlapped one and always ends up with a coherent
+ * frame. Unchanged states aren't republished, so the frame number only moves when something
+ * actually changed and readers can use it to skip work.
+ */
+class GamepadStatePublisher
+{
+public:
+	// core0
+	void publish(const GamepadState& state, const GamepadAuxState& auxState);
+
+	// core1, returns the frame number of the copied state
+	uint32_t read(GamepadState& state, GamepadAuxState& auxState) const;
+
+	uint32_t getFrame() const { return sequence >> 1; }
+private:
+	volatile uint32_t sequence = 0;
+	GamepadState state;
+	GamepadAuxState auxState;
+};
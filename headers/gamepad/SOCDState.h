@@ -0,0 +1,66 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "enums.pb.h"
+
+/**
+ * @brief SOCD cleaning and 4-way filtering history of one directional input.
+ *
+ * Every consumer (the gamepad, Dual Directional, ...) owns its own, so their histories can't
+ * mix. SOCD cleaning is a lookup per axis in a transition table precomputed for each mode, from
+ * the axis' last direction and its input to the output and the next last direction. The 4-way
+ * filter keeps the held directions in press order in a fixed size stack, and the most recent
+ * one wins. Neither allocates.
+ */
+class SOCDState
+{
+public:
+	void reset();
+
+	/**
+	 * @brief Run SOCD cleaning against a D-pad value.
+	 *
+	 * @param mode The SOCD cleaning mode.
+	 * @param dpad The GamepadState.dpad value.
+	 * @return uint8_t The clean D-pad value.
+	 */
+	uint8_t clean(SOCDMode mode, uint8_t dpad);
+
+	/**
+	 * @brief Run Dual Directional's SOCD cleaning against a D-pad value.
+	 *
+	 * The same as clean(), except that in first and last input priority modes, left and right
+	 * pressed together with no horizontal history both pass through, as Dual Directional has
+	 * always done.
+	 *
+	 * @param mode The SOCD cleaning mode.
+	 * @param dpad The dual directional dpad value.
+	 * @return uint8_t The clean D-pad value.
+	 */
+	uint8_t cleanDual(SOCDMode mode, uint8_t dpad);
+
+	/**
+	 * @brief Filter diagonals out of the dpad, making the device work as a 4-way lever.
+	 *
+	 * The most recent cardinal direction wins.
+	 *
+	 * @param dpad The GameState.dpad value.
+	 * @return uint8_t The new dpad value.
+	 */
+	uint8_t filterToFourWay(uint8_t dpad);
+
+private:
+	// last direction of each axis, as in the transition tables
+	uint8_t lastUD = 0;
+	uint8_t lastLR = 0;
+
+	// held cardinal directions, oldest first
+	uint8_t fourWayStack[4] = {};
+	uint8_t fourWayDepth = 0;
+	uint8_t fourWayHeld = 0;
+};
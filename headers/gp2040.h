@@ -13,6 +13,10 @@
 #include "addonmanager.h"
 #include "eventmanager.h"
 #include "gpdriver.h"
+#include "gamepad/GamepadDebouncer.h"
+#include "gpiosampler.h"
+#include "idlescheduler.h"
+#include "sofsync.h"
 
 #include "pico/types.h"
 
@@ -21,6 +25,8 @@ public:
     GP2040(){}
     ~GP2040(){}
     void setup();           // setup core0
+    void startUSB();        // start enumerating, while core1 is still setting up
+    void serviceUSB();      // keep enumerating until the loop runs
     void run();             // loop core0
 private:
     Gamepad snapshot;
@@ -28,7 +34,14 @@ private:
     // GPIO debouncer
     void debounceGpioGetAll();
     Mask_t buttonGpios;
-    uint32_t gpioDebounceTime[NUM_BANK0_GPIOS];
+    GamepadDebouncer debouncer;
+    GpioSampler gpioSampler;
+    bool samplerFallback;   // oversampling is on but couldn't start
+    // Wait for the time to sample the inputs, returns the time they are sampled at
+    uint32_t waitForSampleTime(SOFSync& sofSync);
+    // Sleep until wakeUs, a button edge or an interrupt that needs the loop
+    void idleUntil(uint32_t nowUs, uint32_t wakeUs);
+    IdleScheduler idleScheduler;
 
     struct RebootHotkeys {
         RebootHotkeys();
@@ -70,11 +83,12 @@ private:
 
     // GPIO manipulation for setup and profile reinit
     void initializeStandardGpio();
-    void deinitializeStandardGpio();
+    void updateStandardGpio();
 
     // event handling checking
-    void checkRawState(GamepadState prevState, GamepadState currState);
-    void checkProcessedState(GamepadState prevState, GamepadState currState);
+    // Filled in as the loop goes, raised once at the end of the input processing
+    GPInputFrameEvent inputFrame;
+    void triggerInputFrame();
 
     // input mask, action
     std::map<uint32_t, int32_t> bootActions;
@@ -83,10 +97,10 @@ private:
     bool saveRequested = false;
     bool forceSave = false;
     bool saveSuccessful = false;
-    void handleStorageSave(GPEvent* e);
+    void handleStorageSave(const GPEvent* e);
 
     bool rebootRequested = false;
-    void handleSystemReboot(GPEvent* e);
+    void handleSystemReboot(const GPEvent* e);
 
     System::BootMode rebootMode = System::BootMode::DEFAULT;
 };
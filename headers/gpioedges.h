@@ -0,0 +1,42 @@
+#ifndef _GPIOEDGES_H_
+#define _GPIOEDGES_H_
+
+#include <cstdint>
+#include "types.h"
+
+// Edge interrupts kept until the loop reads them, must be a power of two
+#define GPIO_EDGES_SIZE 64
+
+/**
+ * @brief The edges seen on the button pins since the loop last read them.
+ */
+struct GpioEdgeBatch {
+    Mask_t pins = 0;        // pins with at least one edge
+    Mask_t bounced = 0;     // pins with more than one edge
+    uint32_t firstUs = 0;   // time_us_32() of the first edge
+    uint32_t lastUs = 0;    // time_us_32() of the last edge
+    bool overflowed = false; // edges were dropped, firstUs and lastUs may be wrong
+};
+
+/**
+ * @brief Timestamped edge interrupts on the button pins.
+ *
+ * Polling gpio_get_all() once per loop only knows an edge happened somewhere during the last
+ * loop, and doesn't see a pin bouncing back and forth between two reads. With edge capture on,
+ * each button pin raises an interrupt on both edges, and the core0 handler pushes the pins and
+ * the time into a single producer, single consumer ring read by debounceGpioGetAll. The ring
+ * only lives on core0, the handler being the producer and the loop the consumer.
+ */
+namespace GpioEdges {
+    void setup(bool enabled);
+    bool isEnabled();
+    // The button pins changed, see GP2040::updateStandardGpio
+    void setPins(Mask_t pins);
+
+    // Empties the ring into batch, returns false when there were no edges
+    bool read(GpioEdgeBatch& batch);
+    // Whether edges are waiting to be read, and the time of the first one
+    bool pending(uint32_t& firstUs);
+}
+
+#endif
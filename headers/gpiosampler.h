@@ -0,0 +1,59 @@
+#ifndef _GPIOSAMPLER_H_
+#define _GPIOSAMPLER_H_
+
+#include <cstdint>
+#include "types.h"
+
+// Samples of every bank0 pin taken per second
+#ifndef GPIO_SAMPLER_RATE_HZ
+#define GPIO_SAMPLER_RATE_HZ 1000000
+#endif
+
+// Samples kept in the ring, must be a power of two
+#define GPIO_SAMPLER_RING_SIZE 256
+
+// Latest samples voted on for each read, at most GPIO_SAMPLER_MAX_VOTES
+#ifndef GPIO_SAMPLER_VOTES
+#define GPIO_SAMPLER_VOTES 15
+#endif
+
+// Bits of the per pin vote counters
+#define GPIO_SAMPLER_COUNTER_BITS 5
+#define GPIO_SAMPLER_MAX_VOTES ((1 << GPIO_SAMPLER_COUNTER_BITS) - 1)
+
+/**
+ * @brief GPIO levels oversampled by a PIO state machine, instead of read once per loop.
+ *
+ * The state machine samples all of the bank0 pins at GPIO_SAMPLER_RATE_HZ. A DMA channel moves
+ * the samples into a ring, and a second channel restarts it at the start of the ring each time
+ * it reaches the end, so the ring fills forever without the CPU. A read takes a bitwise
+ * majority vote of the latest GPIO_SAMPLER_VOTES samples, so the inputs are sampled the same
+ * way however long the loop takes.
+ *
+ * The ring indexing and the vote don't touch the hardware (gpiosamplerring.cpp), so the host
+ * build runs them against a simulated ring, see tools/sampler_check.cpp.
+ */
+class GpioSampler {
+public:
+    // Claims a state machine and two DMA channels, false when they aren't free. The caller
+    // reads the pins itself then, see GP2040::setup.
+    bool start();
+    bool isRunning() const { return running; }
+
+    // Pin levels, high when the majority of the latest samples is high
+    Mask_t read() const;
+
+    // Index of the next sample the DMA writes, from its write address
+    static uint32_t headOf(uintptr_t writeAddress, uintptr_t ringAddress);
+    // Bitwise majority of the votes samples before head
+    static Mask_t majority(const volatile uint32_t* ring, uint32_t head, uint8_t votes);
+private:
+    bool running = false;
+    uint8_t dataChannel;
+    uint8_t controlChannel;
+
+    uint32_t samples[GPIO_SAMPLER_RING_SIZE];
+    uint32_t* ringStart;    // read by the control channel to restart the data channel
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef _IDLESCHEDULER_H_
+#define _IDLESCHEDULER_H_
+
+#include <cstdint>
+
+// Loops in a row without any change of the inputs before core0 starts sleeping
+#define IDLE_STABLE_LOOPS 32
+
+// Longest sleep when the next poll isn't known, so that polled inputs (analog, I2C, ...) are
+// still read this often
+#ifndef IDLE_MAX_SLEEP_US
+#define IDLE_MAX_SLEEP_US 250
+#endif
+
+// Woken up this long before the sample time, the rest is waited out as before
+#define IDLE_WAKE_GUARD_US 20
+
+/**
+ * @brief Decides when core0 can sleep between loops instead of spinning.
+ *
+ * Once the inputs went IDLE_STABLE_LOOPS loops without changing, the loop sleeps until the time
+ * the next sample is due, or IDLE_MAX_SLEEP_US when that is now, waking up early on any
+ * interrupt: USB, a button edge, core1 signalling through the event queue, ... Any change of the
+ * inputs goes back to running flat out.
+ *
+ * Times are in microseconds and passed in, so the scheduling can be run off the device.
+ */
+class IdleScheduler {
+public:
+    void setup(bool enabled);
+
+    // The inputs changed or are still settling in this loop
+    void onLoop(bool inputsChanged);
+
+    bool isEnabled() const { return enabled; }
+    // The inputs haven't changed for a while, whether or not sleeping is enabled
+    bool isIdle() const { return stableLoops >= IDLE_STABLE_LOOPS; }
+    bool canSleep() const { return enabled && isIdle(); }
+
+    // Time to sleep until, before the sample time, or nowUs not to sleep
+    uint32_t wakeTime(uint32_t nowUs, uint32_t sampleUs) const;
+private:
+    bool enabled = false;
+    uint32_t stableLoops = 0;
+};
+
+#endif
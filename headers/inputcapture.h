@@ -0,0 +1,49 @@
+#ifndef _INPUTCAPTURE_H_
+#define _INPUTCAPTURE_H_
+
+#include <cstdint>
+#include <string>
+#include "enums.pb.h"
+#include "inputcapturelog.h"
+
+// Recording of the raw inputs, built in when GP2040_INPUT_CAPTURE is set
+#ifndef GP2040_INPUT_CAPTURE
+#define GP2040_INPUT_CAPTURE 0
+#endif
+
+/**
+ * @brief Input capture, for replaying what the firmware was given.
+ *
+ * Core0 records the debounced GPIO word, ADC samples and USB host reports with an
+ * InputCaptureWriter. The records go into a fixed ring kept in uninitialized RAM, so that a
+ * capture taken in gamepad mode can be read after rebooting into web config. Everything is
+ * compiled out unless GP2040_INPUT_CAPTURE is set.
+ */
+namespace InputCapture {
+    // Starts a new capture, unless booting into web config to read the previous one
+    void init(InputMode inputMode);
+
+    void gpio(uint32_t debouncedGpio, uint32_t nowUs);
+    void adc(uint8_t source, uint16_t value);
+    void report(uint8_t devAddr, uint8_t instance, const uint8_t* report, uint16_t len);
+
+    uint32_t getCount();
+    // Length of the capture as base64, and the capture appended to out as base64 of
+    // InputCaptureRecord, oldest first
+    size_t getEncodedSize();
+    void encode(std::string& out);
+}
+
+#if GP2040_INPUT_CAPTURE
+#define INPUT_CAPTURE_INIT(inputMode)                       InputCapture::init(inputMode)
+#define INPUT_CAPTURE_GPIO_WORD(gpio, nowUs)                InputCapture::gpio(gpio, nowUs)
+#define INPUT_CAPTURE_ADC_SAMPLE(source, value)             InputCapture::adc(source, value)
+#define INPUT_CAPTURE_HOST_REPORT(devAddr, instance, report, len) InputCapture::report(devAddr, instance, report, len)
+#else
+#define INPUT_CAPTURE_INIT(inputMode)
+#define INPUT_CAPTURE_GPIO_WORD(gpio, nowUs)
+#define INPUT_CAPTURE_ADC_SAMPLE(source, value)
+#define INPUT_CAPTURE_HOST_REPORT(devAddr, instance, report, len)
+#endif
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef _INPUTCAPTURELOG_H_
+#define _INPUTCAPTURELOG_H_
+
+#include <cstdint>
+#include <string>
+
+// Records kept in the capture ring, must be a power of two
+#ifndef INPUT_CAPTURE_SIZE
+#define INPUT_CAPTURE_SIZE 1024
+#endif
+#define INPUT_CAPTURE_VERSION 2
+#define INPUT_CAPTURE_MAGIC 0x49435054 // ICPT
+
+// Longest USB host report recorded, longer ones are cut (the report record keeps the real length)
+#define INPUT_CAPTURE_REPORT_MAX 64
+// Report bytes carried by each INPUT_CAPTURE_REPORT_DATA record
+#define INPUT_CAPTURE_REPORT_PART 8
+
+// USB host reports are recorded as the parts that changed since the last report of the same
+// device and instance, for this many devices and instances at a time
+#define INPUT_CAPTURE_REPORT_SOURCES 4
+// Every this many recorded reports of a source, one is recorded whole, so a reader can pick the
+// reports up again after the ring wrapped over the one the changes apply to
+#define INPUT_CAPTURE_REPORT_KEY_INTERVAL 32
+
+// InputCaptureRecord::type
+#define INPUT_CAPTURE_GPIO          1   // data: the debounced GPIO word
+#define INPUT_CAPTURE_ADC           2   // info: the source, data: the 12 bit sample
+#define INPUT_CAPTURE_REPORT        3   // info: the device address, data: instance, length (16 bit), parts, flags
+#define INPUT_CAPTURE_REPORT_DATA   4   // info: the part, data: the next 8 bytes of the report
+
+// InputCaptureRecord::info of an ADC sample: the ADC input, or the Hall effect trigger with this flag
+#define INPUT_CAPTURE_ADC_HE_TRIGGER 0x80
+
+// Flags of an INPUT_CAPTURE_REPORT, data[4]: every part follows, the report doesn't build on an earlier one
+#define INPUT_CAPTURE_REPORT_WHOLE 0x01
+
+/**
+ * One change of an input. Exported as-is, little endian.
+ *
+ * A USB host report takes an INPUT_CAPTURE_REPORT record, with a mask of the parts that follow
+ * (bit n for bytes 8n to 8n+7), then one INPUT_CAPTURE_REPORT_DATA record for each of them.
+ */
+struct __attribute__((packed)) InputCaptureRecord {
+    uint32_t timeUs;        // time_us_32() when the input was read
+    uint16_t sequence;      // wraps, lets a reader spot gaps
+    uint8_t type;
+    uint8_t info;
+    uint8_t data[INPUT_CAPTURE_REPORT_PART];
+};
+
+struct InputCaptureRing {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t head;      // total records written, wraps
+    InputCaptureRecord records[INPUT_CAPTURE_SIZE];
+
+    void clear();
+    bool isValid() const { return magic == INPUT_CAPTURE_MAGIC && version == INPUT_CAPTURE_VERSION; }
+
+    // Records kept, and where the oldest one a reader can start from is. Report parts whose
+    // report record the ring wrapped over are left out.
+    uint32_t getCount() const;
+    uint32_t getFirst(uint32_t& count) const;
+
+    // Append the records, oldest first, to out as base64 without copying them anywhere else
+    size_t getBase64Size() const;
+    void appendBase64(std::string& out) const;
+};
+
+// Last report of a USB host device, what the next one is recorded against
+struct InputCaptureReportSource {
+    bool used;
+    uint8_t devAddr;
+    uint8_t instance;
+    uint8_t sinceWhole;     // reports recorded since the last whole one
+    uint16_t length;
+    uint8_t data[INPUT_CAPTURE_REPORT_MAX];
+};
+
+/**
+ * @brief Writes the inputs into a capture ring, each only when it differs from the last one
+ * recorded from the same source.
+ *
+ * Holding the last value between records replays the inputs exactly. A USB host pad sends a
+ * report every poll, mostly the same one, so repeated reports aren't recorded and the others
+ * only record the parts that changed: a pad at 1 kHz would otherwise take 9 records a
+ * millisecond and fill the ring in about 100 ms.
+ */
+class InputCaptureWriter {
+public:
+    // Empties the ring and forgets the last values
+    void begin(InputCaptureRing& ring);
+
+    void gpio(uint32_t debouncedGpio, uint32_t nowUs);
+    void adc(uint8_t source, uint16_t value, uint32_t nowUs);
+    void report(uint8_t devAddr, uint8_t instance, const uint8_t* report, uint16_t len, uint32_t nowUs);
+private:
+    InputCaptureRecord& nextRecord(uint32_t nowUs, uint8_t type, uint8_t info);
+
+    InputCaptureRing* ring = nullptr;
+    uint32_t lastGpio = 0;
+    bool gpioRecorded = false;
+    // last sample of each ADC source, 0xFFFF for none yet (samples are 12 bit)
+    uint16_t lastAdc[256];
+    InputCaptureReportSource sources[INPUT_CAPTURE_REPORT_SOURCES];
+    uint8_t nextSource = 0;
+};
+
+// One input read back from a capture
+struct InputCaptureEvent {
+    uint32_t timeUs;
+    uint8_t type;               // INPUT_CAPTURE_GPIO, INPUT_CAPTURE_ADC or INPUT_CAPTURE_REPORT
+    uint8_t source;             // the ADC source, or the device address of a report
+    uint8_t instance;           // of a report
+    uint16_t length;            // of a report, as received (only INPUT_CAPTURE_REPORT_MAX bytes are kept)
+    uint32_t value;             // the GPIO word or the ADC sample
+    const uint8_t* report;      // the whole report, valid until the next event
+};
+
+/**
+ * @brief Reads a capture back as inputs, rebuilding the USB host reports from their changes.
+ *
+ * Reports that build on one the ring wrapped over are skipped until the next whole report of
+ * their source.
+ */
+class InputCaptureReader {
+public:
+    InputCaptureReader(const InputCaptureRecord* records, uint32_t count);
+
+    bool next(InputCaptureEvent& event);
+
+    uint32_t getGaps() const { return gaps; }
+    uint32_t getSkippedReports() const { return skippedReports; }
+private:
+    InputCaptureReportSource* sourceOf(uint8_t devAddr, uint8_t instance, bool add);
+
+    const InputCaptureRecord* records;
+    uint32_t count;
+    uint32_t index = 0;
+    uint32_t gaps = 0;
+    uint32_t skippedReports = 0;
+    InputCaptureReportSource sources[INPUT_CAPTURE_REPORT_SOURCES] = {};
+    uint8_t nextSource = 0;
+};
+
+#endif
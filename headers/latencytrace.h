@@ -0,0 +1,55 @@
+#ifndef _LATENCYTRACE_H_
+#define _LATENCYTRACE_H_
+
+#include <cstdint>
+#include <string>
+#include "enums.pb.h"
+#include "types.h"
+
+// Samples kept in the trace ring, must be a power of two
+#define LATENCY_TRACE_SIZE 128
+#define LATENCY_TRACE_VERSION 1
+
+// LatencySample::flags
+#define LATENCY_SAMPLE_PRESS     (1 << 0) // at least one input was pressed, otherwise only released
+#define LATENCY_SAMPLE_COALESCED (1 << 1) // more edges arrived before the report was sent
+
+/**
+ * One input edge, from the first raw GPIO change to the USB report carrying it.
+ * Exported as-is, little endian.
+ */
+struct __attribute__((packed)) LatencySample {
+    uint32_t edgeUs;        // time_us_32() when the raw GPIO change was first seen
+    uint16_t debounceUs;    // until the debounced state changed
+    uint16_t reportUs;      // from there until the driver had a report accepted, saturates at 65535
+    uint8_t inputMode;
+    uint8_t flags;
+    uint16_t sequence;      // wraps, lets a reader spot gaps
+};
+
+/**
+ * @brief Input-to-USB latency tracer.
+ *
+ * Core0 notes when debounceGpioGetAll first sees a raw change, when the change makes it through
+ * the debouncer, and when the input driver next has a report accepted by TinyUSB. Each completed
+ * edge goes into a fixed ring kept in uninitialized RAM, so that a trace taken in gamepad mode can
+ * still be read after rebooting into web config.
+ */
+namespace LatencyTrace {
+    // Starts a new trace, unless booting into web config to read the previous one
+    void init(InputMode inputMode);
+
+    // debounceGpioGetAll: raw pins differ from the debounced state, or no longer do
+    void rawEdge(uint32_t nowUs);
+    void rawSettled();
+    // debounceGpioGetAll: the debounced state changed
+    void inputEdge(Mask_t pressed, uint32_t nowUs);
+    // The input driver had a report accepted
+    void reportSent(uint32_t nowUs);
+
+    uint32_t getCount();
+    // The trace as a base64 string of LatencySample, oldest first
+    std::string encode();
+}
+
+#endif
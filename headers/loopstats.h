@@ -0,0 +1,103 @@
+#ifndef _LOOPSTATS_H_
+#define _LOOPSTATS_H_
+
+#include <cstdint>
+#include "enums.pb.h"
+
+// Per-phase timing of the core0 and core1 loops, built in when GP2040_LOOP_STATS is set (Debug builds)
+#ifndef GP2040_LOOP_STATS
+#define GP2040_LOOP_STATS 0
+#endif
+
+// Histogram buckets: exact below 4 cycles, then four buckets per power of two up to 32 bits of
+// cycles (~34s at 125MHz). The 24 bit SysTick wraps every ~134ms, longer phases are timed in
+// microseconds instead.
+#define LOOPSTATS_SUB_BUCKET_BITS 2
+#define LOOPSTATS_TIMER_BITS 24
+#define LOOPSTATS_RANGE_BITS 32
+#define LOOPSTATS_NUM_BUCKETS ((LOOPSTATS_RANGE_BITS - 1) << LOOPSTATS_SUB_BUCKET_BITS)
+#define LOOPSTATS_VERSION 1
+
+enum LoopPhase : uint8_t {
+    // core0, GP2040::run
+    LOOP_PHASE_CORE0_LOOP = 0,
+    LOOP_PHASE_CORE0_EVENTS,
+    LOOP_PHASE_CORE0_SOF_WAIT,
+    LOOP_PHASE_CORE0_DEBOUNCE,
+    LOOP_PHASE_CORE0_READ,
+    LOOP_PHASE_CORE0_USB_HOST,
+    LOOP_PHASE_CORE0_PREPROCESS_ADDONS,
+    LOOP_PHASE_CORE0_HOTKEY,
+    LOOP_PHASE_CORE0_PROCESS,
+    LOOP_PHASE_CORE0_PROCESS_ADDONS,
+    LOOP_PHASE_CORE0_DRIVER,
+    LOOP_PHASE_CORE0_TUD_TASK,
+    LOOP_PHASE_CORE0_POSTPROCESS_ADDONS,
+    // how much earlier the button edge interrupts saw an edge than the GPIO read, see GpioEdges
+    LOOP_PHASE_CORE0_EDGE_GAIN,
+    // time slept per sleep between loops, and from a button edge to the loop reading it after the
+    // inputs were idle, sleeping or not (with the edge interrupts on), see IdleScheduler
+    LOOP_PHASE_CORE0_IDLE,
+    LOOP_PHASE_CORE0_WAKE_LATENCY,
+
+    // core1, GP2040Aux::run
+    LOOP_PHASE_CORE1_LOOP,
+    LOOP_PHASE_CORE1_EVENTS,
+    LOOP_PHASE_CORE1_PREPROCESS_ADDONS,
+    LOOP_PHASE_CORE1_PROCESS_ADDONS,
+    LOOP_PHASE_CORE1_DRIVER_AUX,
+
+    LOOP_PHASE_COUNT
+};
+
+struct LoopPhaseSummary {
+    uint32_t count;
+    uint32_t minNs;
+    uint32_t avgNs;
+    uint32_t p99Ns;
+    uint32_t maxNs;
+};
+
+/**
+ * The histograms are kept in uninitialized RAM, like the latency trace, so that the stats of a
+ * gamepad mode session can still be read after rebooting into web config.
+ */
+namespace LoopStats {
+    // Starts new stats, unless booting into web config to read the previous ones. Those are then
+    // kept as they are rather than mixed with the web config loops.
+    void init(InputMode inputMode);
+    // True while showing the stats of the previous boot
+    bool isPreviousBoot();
+
+    // Both cores time their phases with their own SysTick, running from the system clock
+    void initCore(uint8_t core);
+
+    // Start a loop iteration, then close each phase in order as it completes
+    void begin(uint8_t core);
+    void mark(LoopPhase phase);
+    void end(uint8_t core);
+    // Record a time measured elsewhere against a phase
+    void sampleUs(LoopPhase phase, uint32_t us);
+
+    void reset();
+
+    const char* getPhaseName(LoopPhase phase);
+    // Returns false (and an empty summary) when built without GP2040_LOOP_STATS
+    bool getSummary(LoopPhase phase, LoopPhaseSummary& summary);
+}
+
+#if GP2040_LOOP_STATS
+#define LOOP_STATS_INIT(core)   LoopStats::initCore(core)
+#define LOOP_STATS_BEGIN(core)  LoopStats::begin(core)
+#define LOOP_STATS_MARK(phase)  LoopStats::mark(phase)
+#define LOOP_STATS_END(core)    LoopStats::end(core)
+#define LOOP_STATS_SAMPLE_US(phase, us) LoopStats::sampleUs(phase, us)
+#else
+#define LOOP_STATS_INIT(core)
+#define LOOP_STATS_BEGIN(core)
+#define LOOP_STATS_MARK(phase)
+#define LOOP_STATS_END(core)
+#define LOOP_STATS_SAMPLE_US(phase, us)
+#endif
+
+#endif
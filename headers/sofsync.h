@@ -0,0 +1,95 @@
+#ifndef _SOFSYNC_H_
+#define _SOFSYNC_H_
+
+#include <cstdint>
+
+// Full speed USB frame
+#define SOF_SYNC_FRAME_US 1000
+
+// Default time left between the report being armed and the start of the frame it is polled in
+#ifndef DEFAULT_USB_SOF_SYNC_MARGIN_US
+#define DEFAULT_USB_SOF_SYNC_MARGIN_US 50
+#endif
+
+// Consecutive regular SOFs before the loop is scheduled from them
+#define SOF_SYNC_LOCK_FRAMES 8
+
+// Missing SOFs (suspend, unplug) before the loop falls back to free running
+#define SOF_SYNC_LOST_FRAMES 4
+
+// Reports taken by the host before its poll interval is trusted
+#define SOF_SYNC_LEARN_REPORTS 16
+
+// Reports that missed the poll they were scheduled for before the poll interval is learnt again
+#define SOF_SYNC_MISSES_BEFORE_RELEARN 2
+
+// Longest host poll interval followed, in frames
+#define SOF_SYNC_MAX_POLL_INTERVAL 16
+
+/**
+ * @brief Schedules the core0 loop against the host's interrupt IN polls.
+ *
+ * The SOF interrupt gives the phase and length of the USB frame. Interrupt IN endpoints are
+ * polled once every few frames, right after the SOF, so a report armed just before the start
+ * of a polled frame is the freshest one the host can get. The frames in which the host took a
+ * report are all the same number of frames apart, so the poll interval is their greatest common
+ * divisor. Along with the measured time from sampling the inputs to arming the report, this
+ * gives the time at which the next sample should start.
+ *
+ * Times are in microseconds and passed in, so the scheduling can be run off the device.
+ */
+class SOFSync {
+public:
+    void setup(bool enabled, uint32_t marginUs);
+    void reset();
+
+    // SOF interrupt, reportTaken when the host took a report in the frame that just ended
+    void onStartOfFrame(uint32_t nowUs, bool reportTaken);
+    // The frame the SOF interrupt last saw a report taken in, false when it saw none since the last call
+    bool readTakenFrame(uint32_t& frame);
+    // IN transfer completed, the host polled in that frame. The completion reaches the driver
+    // in tud_task(), which can be frames later, so the frame comes from readTakenFrame().
+    void onReportTaken(uint32_t frame);
+
+    // Time to sample the inputs at, nowUs when the loop should free run
+    uint32_t nextSampleTime(uint32_t nowUs);
+    // The inputs sampled at sampleUs were processed, and sent to the driver at doneUs
+    void onCycleDone(uint32_t sampleUs, uint32_t doneUs, bool reportSent);
+
+    bool isEnabled() const { return enabled; }
+    bool isLocked() const { return lockCount >= SOF_SYNC_LOCK_FRAMES; }
+    uint32_t getFrameUs() const { return frameUs16 >> 4; }
+    uint32_t getWorkUs() const { return workUs; }
+    uint8_t getPollInterval() const { return pollInterval; }
+private:
+    void readFrame(uint32_t& frame, uint32_t& sofUs) const;
+    uint32_t readTaken(uint32_t& frame) const;
+    void restartLearning();
+
+    bool enabled = false;
+    uint32_t marginUs = DEFAULT_USB_SOF_SYNC_MARGIN_US;
+
+    // written by the SOF interrupt
+    volatile uint32_t frameCount = 0;
+    volatile uint32_t lastSofUs = 0;
+    volatile uint32_t frameUs16 = SOF_SYNC_FRAME_US << 4;   // moving average, in 1/16 us
+    volatile uint8_t lockCount = 0;
+    volatile uint32_t takenFrame = 0;
+    volatile uint32_t takenCount = 0;
+
+    uint32_t takenCountRead = 0;
+
+    uint32_t workUs = 0;            // sample to report
+    uint32_t targetFrame = 0;       // frame the current cycle's report is meant for
+    bool scheduled = false;         // the current cycle was scheduled from the SOF
+    uint32_t sentFrame = 0;         // frame the last scheduled report was sent for
+    bool checkSent = false;
+    uint32_t lastPollFrame = 0;
+    bool haveLastPoll = false;
+    uint32_t pollGap = 0;           // greatest common divisor of the gaps between polls
+    uint8_t pollInterval = 1;       // frames
+    uint8_t pollsSeen = 0;
+    uint8_t missedPolls = 0;
+};
+
+#endif
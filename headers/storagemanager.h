@@ -13,6 +13,7 @@
 #include "enums.h"
 #include "helper.h"
 #include "gamepad.h"
+#include "gamepad/GamepadStatePublisher.h"
 
 #include "config.pb.h"
 #include <atomic>
@@ -31,22 +32,24 @@ public:
 		return instance;
 	}
 
-	Config& getConfig() { return config; }
+	// The display and animation options are decoded on first use, see ConfigUtils::loadDeferred
+	Config& getConfig() { loadDeferredConfig(); return config; }
 	GamepadOptions& getGamepadOptions() { return config.gamepadOptions; }
 	HotkeyOptions& getHotkeyOptions() { return config.hotkeyOptions; }
 	ForcedSetupOptions& getForcedSetupOptions() { return config.forcedSetupOptions; }
 	PinMappings& getDeprecatedPinMappings() { return config.deprecatedPinMappings; }
 	GpioMappings& getGpioMappings() { return config.gpioMappings; }
 	KeyboardMapping& getKeyboardMapping() { return config.keyboardMapping; }
-	DisplayOptions& getDisplayOptions() { return config.displayOptions; }
+	DisplayOptions& getDisplayOptions() { loadDeferredConfig(); return config.displayOptions; }
 	LEDOptions& getLedOptions() { return config.ledOptions; }
 	AddonOptions& getAddonOptions() { return config.addonOptions; }
-	AnimationOptions& getAnimationOptions() { return config.animationOptions; }
+	AnimationOptions& getAnimationOptions() { loadDeferredConfig(); return config.animationOptions; }
 	ProfileOptions& getProfileOptions() { return config.profileOptions; }
 	GpioMappingInfo* getProfilePinMappings() { return functionalPinMappings; }
 	PeripheralOptions& getPeripheralOptions() { return config.peripheralOptions; }
 
 	void init();
+	void loadDeferredConfig();
 	bool save();
 	bool save(const bool force);
 
@@ -56,10 +59,18 @@ public:
 	void SetProcessedGamepad(Gamepad *); // MPGS Processed Gamepad Get/Set
 	Gamepad * GetProcessedGamepad();
 
+	void SetSnapshotGamepad(Gamepad *); // Core1 copy of the processed gamepad
+	Gamepad * GetSnapshotGamepad();
+	void PublishProcessedGamepad();		// core0: hand the processed state to core1
+	void UpdateSnapshotGamepad();		// core1: refresh the snapshot from the last published state
+	uint32_t GetSnapshotFrame() { return snapshotFrame; }
+
+	bool isProfileEnabled(const uint32_t);
 	bool setProfile(const uint32_t);		// profile support for multiple mappings
 	void nextProfile();
 	void previousProfile();
 	void setFunctionalPinMappings();
+	void getProfilePinMappings(const uint32_t, GpioMappingInfo*);
 	char* currentProfileLabel();
 
 	void ResetSettings(); 				// EEPROM Reset Feature
@@ -71,6 +82,9 @@ private:
 	bool CONFIG_MODE = false; 			// Config mode (boot)
 	Gamepad * gamepad = nullptr;    		// Gamepad data
 	Gamepad * processedGamepad = nullptr; // Gamepad with ONLY processed data
+	Gamepad * snapshotGamepad = nullptr; // Processed data as last seen by core1
+	GamepadStatePublisher processedPublisher;
+	uint32_t snapshotFrame = 0;
 	uint8_t featureData[32]; // USB X-Input Feature Data
 	Config config;
 	GpioMappingInfo functionalPinMappings[NUM_BANK0_GPIOS];
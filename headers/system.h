@@ -16,6 +16,14 @@ namespace System {
     uint32_t getTotalHeap();
     // Returns the about of heap memory currently allocated in bytes
     uint32_t getUsedHeap();
+    // Returns the number of operator new/delete calls made by core0, only counted when built with
+    // GP2040_COUNT_HEAP_OPERATIONS (Debug builds), 0 otherwise
+    uint32_t getHeapOperations();
+    // Bracket the core0 input loop so the heap operations made inside it can be reported
+    void startHeapOperationsWindow();
+    void endHeapOperationsWindow();
+    // Returns the most heap operations seen in a single input loop since boot
+    uint32_t getMaxLoopHeapOperations();
 
     enum class BootMode : uint32_t {
         DEFAULT = 0,
@@ -1,7 +1,11 @@
 #ifndef _USB_DRIVER_H_
 #define _USB_DRIVER_H_
 
+#include "sofsync.h"
+
 bool get_usb_mounted(void);
 bool get_usb_suspended(void);
+// Set up before tud_init(), which wraps the input driver when it is enabled
+SOFSync& get_usb_sof_sync(void);
 
 #endif // #ifndef _USB_DRIVER_H_
\ No newline at end of file
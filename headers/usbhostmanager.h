@@ -24,6 +24,7 @@ public:
     void shutdown();            // Called on system reboot
     void pushListener(USBListener *); // If anything needs to update in the gpconfig driver
     void process();
+    bool isRunning() const { return tuh_ready; }
     void hid_mount_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len);
     void hid_umount_cb(uint8_t daddr, uint8_t instance);
     void hid_report_received_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len);
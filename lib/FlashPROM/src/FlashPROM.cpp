@@ -6,25 +6,103 @@
 #include "FlashPROM.h"
 
 uint8_t FlashPROM::writeCache[EEPROM_SIZE_BYTES];
-volatile static alarm_id_t flashWriteAlarm = 0;
+FlashPROMWriteStats FlashPROM::writeStats = {};
 volatile static spin_lock_t *flashLock = nullptr;
 
-int64_t writeToFlash(alarm_id_t id, void *flashCache)
+// Where the writer is, everything before writePosition matches the cache
+static bool writePending = false;
+static absolute_time_t writeAfter = nil_time;
+static uint32_t writePosition = 0;
+static uint32_t writeSectors = 0;
+static FlashPROMWriteStats currentWrite = {};
+
+/* Programming can only clear bits. When the cache only clears bits compared to the flash, as appending to an erased
+	area does, the page is programmed over what is there without erasing anything. */
+static bool programOnly(const uint8_t *flash, const uint8_t *cache, uint32_t size)
 {
-	while (is_spin_locked(flashLock));
+	for (uint32_t i = 0; i < size; i++)
+	{
+		if ((flash[i] & cache[i]) != cache[i])
+			return false;
+	}
+	return true;
+}
+
+/* Erase a sector or program a page, with core1 locked out and interrupts off as flash can't be read meanwhile. The
+	flash routines themselves run from RAM. */
+static void flashOperation(uint32_t offset, bool erase)
+{
+	const uint32_t flashOffset = (intptr_t)EEPROM_ADDRESS_START - (intptr_t)XIP_BASE;
+	const uint32_t stallStart = time_us_32();
 
 	multicore_lockout_start_blocking();
 	uint32_t interrupts = spin_lock_blocking(flashLock);
 
-	flash_range_erase((intptr_t)EEPROM_ADDRESS_START - (intptr_t)XIP_BASE, EEPROM_SIZE_BYTES);
-	flash_range_program((intptr_t)EEPROM_ADDRESS_START - (intptr_t)XIP_BASE, reinterpret_cast<uint8_t *>(flashCache), EEPROM_SIZE_BYTES);
-
-	flashWriteAlarm = 0;
+	if (erase)
+		flash_range_erase(flashOffset + offset, FLASH_SECTOR_SIZE);
+	else
+		flash_range_program(flashOffset + offset, FlashPROM::writeCache + offset, FLASH_PAGE_SIZE);
 
 	multicore_lockout_end_blocking();
 	spin_unlock(flashLock, interrupts);
 
-	return 0;
+	const uint32_t stallUs = time_us_32() - stallStart;
+	if (stallUs > currentWrite.stallUs)
+		currentWrite.stallUs = stallUs;
+}
+
+/* Do the next flash operation the cache needs, comparing it against the flash from where the writer is. Sectors and
+	pages that already match are skipped, so only the ones that changed cost anything. A page that can't be programmed
+	over what is there has its sector erased, and the writer goes back to the start of that sector to program it
+	again. Returns false once the flash matches the cache. */
+static bool writeNext()
+{
+	const uint8_t *flash = reinterpret_cast<const uint8_t *>(EEPROM_ADDRESS_START);
+	const uint8_t *cache = FlashPROM::writeCache;
+
+	while (writePosition < EEPROM_SIZE_BYTES)
+	{
+		const uint32_t sector = writePosition & ~(FLASH_SECTOR_SIZE - 1);
+		if (writePosition == sector && memcmp(flash + sector, cache + sector, FLASH_SECTOR_SIZE) == 0)
+		{
+			writePosition += FLASH_SECTOR_SIZE;
+			continue;
+		}
+		if (memcmp(flash + writePosition, cache + writePosition, FLASH_PAGE_SIZE) == 0)
+		{
+			writePosition += FLASH_PAGE_SIZE;
+			continue;
+		}
+
+		writeSectors |= 1U << (sector / FLASH_SECTOR_SIZE);
+		if (programOnly(flash + writePosition, cache + writePosition, FLASH_PAGE_SIZE))
+		{
+			flashOperation(writePosition, false);
+			currentWrite.pagesProgrammed++;
+			writePosition += FLASH_PAGE_SIZE;
+		}
+		else
+		{
+			flashOperation(sector, true);
+			currentWrite.sectorsErased++;
+			writePosition = sector;
+		}
+		return true;
+	}
+	return false;
+}
+
+static void finishWrite()
+{
+	writePending = false;
+	if (writeSectors == 0)
+		return;
+
+	currentWrite.saves = FlashPROM::writeStats.saves + 1;
+	currentWrite.sectorsChanged = __builtin_popcount(writeSectors);
+	currentWrite.maxStallUs = FlashPROM::writeStats.maxStallUs > currentWrite.stallUs
+		? FlashPROM::writeStats.maxStallUs : currentWrite.stallUs;
+	FlashPROM::writeStats = currentWrite;
 }
 
 void FlashPROM::start()
@@ -37,13 +115,46 @@ void FlashPROM::start()
 
 /* We don't have an actual EEPROM, so we need to be extra careful about minimizing writes. Instead
 	of writing when a commit is requested, we update a time to actually commit. That way, if we receive multiple requests
-	to commit in that timeframe, we'll hold off until the user is done sending changes. */
+	to commit in that timeframe, we'll hold off until the user is done sending changes. A commit during a write starts
+	the comparison over, the parts already written are skipped. */
 void FlashPROM::commit()
 {
 	while (is_spin_locked(flashLock));
-	if (flashWriteAlarm != 0)
-		cancel_alarm(flashWriteAlarm);
-	flashWriteAlarm = add_alarm_in_ms(EEPROM_WRITE_WAIT, writeToFlash, writeCache, true);
+	if (!writePending)
+	{
+		writeSectors = 0;
+		currentWrite = {};
+	}
+	writePosition = 0;
+	writeAfter = make_timeout_time_ms(EEPROM_WRITE_WAIT);
+	writePending = true;
+}
+
+/* Write the pending commit one flash operation at a time, for as long as budgetUs allows. At least one operation is
+	done per call, so a sector erase still stalls for as long as the flash takes to erase it. */
+void FlashPROM::step(uint32_t budgetUs)
+{
+	if (!writePending || !time_reached(writeAfter))
+		return;
+
+	const uint32_t start = time_us_32();
+	do
+	{
+		if (!writeNext())
+		{
+			finishWrite();
+			return;
+		}
+	} while (time_us_32() - start < budgetUs);
+}
+
+void FlashPROM::flush()
+{
+	if (!writePending)
+		return;
+
+	while (writeNext());
+	finishWrite();
 }
 
 void FlashPROM::reset()
@@ -13,11 +13,26 @@
 #include <hardware/flash.h>
 #include <hardware/timer.h>
 
-#define EEPROM_SIZE_BYTES    0x8000           // Reserve 32k of flash memory (ensure this value is divisible by 256)
+#define EEPROM_SIZE_BYTES    0x8000           // Reserve 32k of flash memory (ensure this value is divisible by 4096)
 #define EEPROM_ADDRESS_START _u(0x101F8000) // The arduino-pico EEPROM lib starts here, so we'll do the same
 
-// Warning: If the write wait is too long it can stall other processes
-#define EEPROM_WRITE_WAIT    50             // Amount of time in ms to wait before blocking core1 and committing to flash
+#define EEPROM_WRITE_WAIT    50             // Amount of time in ms to wait after a commit before writing to flash
+
+// Longest time a call to step() keeps writing, as long as one flash operation doesn't take longer by itself
+#ifndef EEPROM_WRITE_STEP_BUDGET_US
+#define EEPROM_WRITE_STEP_BUDGET_US 1000
+#endif
+
+// What the last commit wrote to flash and how long core1 and the interrupts were held off at most at once
+struct FlashPROMWriteStats
+{
+	uint32_t saves;             // commits that wrote anything since boot
+	uint32_t sectorsChanged;    // 4 KB sectors erased or programmed by the last one
+	uint32_t sectorsErased;
+	uint32_t pagesProgrammed;
+	uint32_t stallUs;
+	uint32_t maxStallUs;        // since boot
+};
 
 class FlashPROM
 {
@@ -26,7 +41,13 @@ class FlashPROM
 		void commit();
 		void reset();
 
+		// Write part of the last commit to flash, to be called from the main loop between USB polls
+		void step(uint32_t budgetUs = EEPROM_WRITE_STEP_BUDGET_US);
+		// Write all of the last commit now, before a reboot
+		void flush();
+
 		static uint8_t writeCache[EEPROM_SIZE_BYTES];
+		static FlashPROMWriteStats writeStats;
 };
 
 inline FlashPROM EEPROM;
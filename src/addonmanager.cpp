@@ -1,60 +1,225 @@
 #include "addonmanager.h"
 #include "usbhostmanager.h"
+#include "storagemanager.h"
+#include "eventmanager.h"
 
-bool AddonManager::LoadAddon(GPAddon* addon) {
+#include "pico/multicore.h"
+#include "pico/platform.h"
+#include "pico/time.h"
+
+#include <cstdio>
+#include <cstring>
+
+#define ADDON_PROFILE_MAGIC 0x464F5250 // PROF
+
+AddonManager * AddonManager::managers[ADDONMGR_NUM_CORES] = {nullptr, nullptr};
+
+struct AddonProfileStore {
+    uint32_t magic;
+    uint32_t version;
+    uint8_t count[ADDONMGR_NUM_CORES];
+    AddonProfile profiles[ADDONMGR_NUM_CORES][ADDON_PROFILE_MAX_ADDONS];
+};
+
+static AddonProfileStore __uninitialized_ram(profileStore);
+
+enum AddonProfileState {
+    ADDON_PROFILE_PENDING,      // the input mode isn't known yet, profiles are local
+    ADDON_PROFILE_RECORDING,
+    ADDON_PROFILE_PREVIOUS,     // showing the previous boot's, new add-ons keep theirs local
+};
+
+static volatile AddonProfileState profileState = ADDON_PROFILE_PENDING;
+
+bool AddonManager::loadAddon(GPAddon* addon, const AddonPhaseFunction functions[ADDON_PHASE_COUNT], bool hasReinit) {
     if (addon->available()) {
         AddonBlock * block = new AddonBlock;
         addon->setup();
         block->ptr = addon;
+        block->name = addon->name();
+
+        // Add-ons are loaded by the core that runs them
+        uint8_t core = get_core_num();
+        managers[core] = this;
+
+        AddonProfile& profile = block->localProfile;
+        block->profile = &profile;
+        strncpy(profile.name, block->name.c_str(), sizeof(profile.name) - 1);
+        profile.interval = 1;
+
+        const AddonProfilerOptions& profilerOptions = Storage::getInstance().getAddonOptions().addonProfilerOptions;
+        profile.budgetUs = profilerOptions.budgetUs;
+        for (pb_size_t i = 0; i < profilerOptions.budgets_count; i++) {
+            if (block->name == profilerOptions.budgets[i].name) {
+                profile.budgetUs = profilerOptions.budgets[i].budgetUs;
+                break;
+            }
+        }
+        if (profile.budgetUs != 0)
+            budgeted = true;
+
+        if (profileState == ADDON_PROFILE_RECORDING)
+            keepProfile(block, core);
+
         addons.push_back(block);
+        for (uint8_t phase = 0; phase < ADDON_PHASE_COUNT; phase++) {
+            // the inputs core0 add-ons contribute must not drop out of the report
+            bool demotable = core != 0 || phase == ADDON_PHASE_POSTPROCESS;
+            if (functions[phase] != nullptr)
+                phaseCalls[phase].push_back({functions[phase], addon, block, demotable});
+        }
+        if (hasReinit)
+            reinitAddons.push_back(addon);
         return true;
     } else {
-        delete addon; // Don't use the memory if we don't have to   
+        delete addon; // Don't use the memory if we don't have to
     }
 
     return false;
 }
 
-bool AddonManager::LoadUSBAddon(GPAddon* addon) {
-    bool ret = LoadAddon(addon);
-    if ( ret == true )
-        USBHostManager::getInstance().pushListener(addon->getListener());
-    return ret;
+void AddonManager::pushUSBListener(GPAddon* addon) {
+    USBHostManager::getInstance().pushListener(addon->getListener());
 }
 
 void AddonManager::ReinitializeAddons() {
-    // Loop through all addons and process any that match our type
-    for (std::vector<AddonBlock*>::iterator it = addons.begin(); it != addons.end(); it++) {
-        (*it)->ptr->reinit();
+    // Loop through all addons that can be reinitialized
+    for (std::vector<GPAddon*>::iterator it = reinitAddons.begin(); it != reinitAddons.end(); it++) {
+        (*it)->reinit();
     }
 }
 
 void AddonManager::PreprocessAddons() {
-    // Loop through all addons and process any that match our type
+    // Budgets are checked once per loop, before any add-on runs. Without any, only the time of
+    // the loop is started over.
     for (std::vector<AddonBlock*>::iterator it = addons.begin(); it != addons.end(); it++) {
-        (*it)->ptr->preprocess();
+        if (budgeted)
+            startLoop(*it);
+        else
+            (*it)->loopUs = 0;
     }
+    runPhase(ADDON_PHASE_PREPROCESS, false);
 }
 
 void AddonManager::ProcessAddons() {
-    // Loop through all addons and process any that match our type
-    for (std::vector<AddonBlock*>::iterator it = addons.begin(); it != addons.end(); it++) {
-        (*it)->ptr->process();
-    }
+    runPhase(ADDON_PHASE_PROCESS, false);
 }
 
 void AddonManager::PostprocessAddons(bool reportSent) {
-    // Loop through all addons and process any that match our type
-    for (std::vector<AddonBlock*>::iterator it = addons.begin(); it != addons.end(); it++) {
-        (*it)->ptr->postprocess(reportSent);
+    runPhase(ADDON_PHASE_POSTPROCESS, reportSent);
+}
+
+void AddonManager::runPhase(ADDON_PHASE phase, bool reportSent) {
+    // Loop through the addons implementing this phase
+    for (std::vector<AddonPhaseCall>::iterator it = phaseCalls[phase].begin(); it != phaseCalls[phase].end(); it++) {
+        if (!it->block->active && it->demotable)
+            continue;
+
+        uint32_t start = time_us_32();
+        it->function(it->addon, reportSent);
+        recordPhase(it->block, phase, time_us_32() - start);
     }
 }
 
 // HACK : change this for NeoPicoLED
 GPAddon * AddonManager::GetAddon(std::string name) { // hack for NeoPicoLED
     for (std::vector<AddonBlock*>::iterator it = addons.begin(); it != addons.end(); it++) {
-        if ( (*it)->ptr->name() == name )
+        if ( (*it)->name == name )
             return (*it)->ptr;
     }
     return nullptr;
 }
+
+/**
+ * @brief Check the previous loop of an add-on against its budget and decide whether it runs in this one.
+ */
+void AddonManager::startLoop(AddonBlock* block) {
+    AddonProfile& profile = *block->profile;
+    if (block->active && profile.budgetUs != 0) {
+        if (block->loopUs > profile.budgetUs) {
+            profile.overruns++;
+            if (block->overrunStreak < ADDON_OVERRUNS_BEFORE_REPORT)
+                block->overrunStreak++;
+        } else {
+            block->overrunStreak = 0;
+        }
+
+        if (!profile.overBudget && block->overrunStreak >= ADDON_OVERRUNS_BEFORE_REPORT) {
+            profile.overBudget = true;
+
+            const AddonProfilerOptions& profilerOptions = Storage::getInstance().getAddonOptions().addonProfilerOptions;
+            if (profilerOptions.demoteOverBudget && profilerOptions.demotedInterval > 1)
+                profile.interval = profilerOptions.demotedInterval;
+
+            char message[GPEVENT_SYSTEM_ERROR_MESSAGE_LENGTH];
+            snprintf(message, sizeof(message), "%s over budget: %lu/%luus", block->name.c_str(),
+                (unsigned long)block->loopUs, (unsigned long)profile.budgetUs);
+            EventManager::getInstance().triggerEvent(GPSystemErrorEvent(message));
+        }
+    }
+
+    block->loopUs = 0;
+    if (block->countdown > 1) {
+        block->countdown--;
+        block->active = false;
+    } else {
+        block->countdown = profile.interval;
+        block->active = true;
+    }
+}
+
+void AddonManager::recordPhase(AddonBlock* block, ADDON_PHASE phase, uint32_t elapsedUs) {
+    AddonPhaseStats& stats = block->profile->phases[phase];
+    stats.lastUs = elapsedUs;
+    if (elapsedUs > stats.maxUs)
+        stats.maxUs = elapsedUs;
+    stats.avgUs16 = stats.avgUs16 - (stats.avgUs16 >> 4) + elapsedUs;
+    block->loopUs += elapsedUs;
+}
+
+/**
+ * @brief Move an add-on's profile into the kept ones, if there is room.
+ */
+void AddonManager::keepProfile(AddonBlock* block, uint8_t core) {
+    uint8_t index = profileStore.count[core];
+    if (index >= ADDON_PROFILE_MAX_ADDONS)
+        return;
+
+    profileStore.profiles[core][index] = *block->profile;
+    block->profile = &profileStore.profiles[core][index];
+    profileStore.count[core] = index + 1;
+}
+
+void AddonManager::InitProfile(InputMode inputMode) {
+    bool valid = profileStore.magic == ADDON_PROFILE_MAGIC && profileStore.version == ADDON_PROFILE_VERSION;
+    if (valid && inputMode == INPUT_MODE_CONFIG) {
+        profileState = ADDON_PROFILE_PREVIOUS;
+        return;
+    }
+
+    memset(&profileStore, 0, sizeof(profileStore));
+    profileStore.magic = ADDON_PROFILE_MAGIC;
+    profileStore.version = ADDON_PROFILE_VERSION;
+    for (uint8_t core = 0; core < ADDONMGR_NUM_CORES; core++) {
+        if (managers[core] == nullptr)
+            continue;
+        for (AddonBlock* block : managers[core]->addons)
+            managers[core]->keepProfile(block, core);
+    }
+    profileState = ADDON_PROFILE_RECORDING;
+}
+
+bool AddonManager::IsPreviousBootProfile() {
+    return profileState == ADDON_PROFILE_PREVIOUS;
+}
+
+uint8_t AddonManager::GetProfileCount(uint8_t core) {
+    if (core >= ADDONMGR_NUM_CORES || profileState == ADDON_PROFILE_PENDING)
+        return 0;
+    uint8_t count = profileStore.count[core];
+    return count < ADDON_PROFILE_MAX_ADDONS ? count : ADDON_PROFILE_MAX_ADDONS;
+}
+
+const AddonProfile * AddonManager::GetProfile(uint8_t core, uint8_t index) {
+    return index < GetProfileCount(core) ? &profileStore.profiles[core][index] : nullptr;
+}
@@ -3,6 +3,7 @@
 #include "enums.pb.h"
 #include "hardware/adc.h"
 #include "helper.h"
+#include "inputcapture.h"
 #include "storagemanager.h"
 #include "drivermanager.h"
 
@@ -149,6 +150,7 @@ void AnalogInput::process() {
 float AnalogInput::readPin(int stick_num, Pin_t pin_adc, uint16_t center) {
     adc_select_input(pin_adc);
     uint16_t adc_value = adc_read();
+    INPUT_CAPTURE_ADC_SAMPLE(pin_adc, adc_value);
     // Apply calibration only if auto calibration is enabled or manual calibration has been performed
     // Manual calibration is considered performed if the center value is not 0 (default)
     if (adc_pairs[stick_num].auto_calibration || center != 0) {
@@ -30,7 +30,7 @@ void BoardLedAddon::process() {
     }
     switch (onBoardLedMode) {
         case OnBoardLedMode::ON_BOARD_LED_MODE_INPUT_TEST: // Blinks on input
-            processedGamepad = Storage::getInstance().GetProcessedGamepad();
+            processedGamepad = Storage::getInstance().GetSnapshotGamepad();
             state =    (processedGamepad->state.buttons != 0)
                     || (processedGamepad->state.dpad    != 0)
                     || (processedGamepad->state.lx      != joystickMid)
@@ -70,7 +70,7 @@ void BoardLedAddon::process() {
             }
             break;
         case OnBoardLedMode::ON_BOARD_LED_MODE_PS_AUTH:
-            processedGamepad = Storage::getInstance().GetProcessedGamepad();
+            processedGamepad = Storage::getInstance().GetSnapshotGamepad();
             if(processedGamepad->getOptions().inputMode == INPUT_MODE_PS4 ||
                 processedGamepad->getOptions().inputMode == INPUT_MODE_PS5) {
                 state = ((PS4Driver*)DriverManager::getInstance().getDriver())->getAuthSent() == true;
@@ -84,10 +84,10 @@ void DisplayAddon::setup() {
     updateDisplayScreen();
     setMenuMappings();
 
-    EventManager::getInstance().registerEventHandler(GP_EVENT_PROFILE_CHANGE, GPEVENT_CALLBACK(this->handleProfileChange(event)));
-    EventManager::getInstance().registerEventHandler(GP_EVENT_RESTART, GPEVENT_CALLBACK(this->handleSystemRestart(event)));
-    EventManager::getInstance().registerEventHandler(GP_EVENT_MENU_NAVIGATE, GPEVENT_CALLBACK(this->handleMenuNavigation(event)));
-    EventManager::getInstance().registerEventHandler(GP_EVENT_SYSTEM_ERROR, GPEVENT_CALLBACK(this->handleSystemError(event)));
+    EventManager::getInstance().registerEventHandler(GP_EVENT_PROFILE_CHANGE, GPEVENT_CALLBACK(DisplayAddon, handleProfileChange), this);
+    EventManager::getInstance().registerEventHandler(GP_EVENT_RESTART, GPEVENT_CALLBACK(DisplayAddon, handleSystemRestart), this);
+    EventManager::getInstance().registerEventHandler(GP_EVENT_MENU_NAVIGATE, GPEVENT_CALLBACK(DisplayAddon, handleMenuNavigation), this);
+    EventManager::getInstance().registerEventHandler(GP_EVENT_SYSTEM_ERROR, GPEVENT_CALLBACK(DisplayAddon, handleSystemError), this);
 }
 
 bool DisplayAddon::updateDisplayScreen() {
@@ -238,7 +238,7 @@ const DisplayOptions& DisplayAddon::getDisplayOptions() {
     return Storage::getInstance().getDisplayOptions();
 }
 
-void DisplayAddon::handleProfileChange(GPEvent* e)
+void DisplayAddon::handleProfileChange(const GPEvent* e)
 {
 	delete mapMenuToggle;
 	delete mapMenuSelect;
@@ -247,25 +247,25 @@ void DisplayAddon::handleProfileChange(GPEvent* e)
 	setMenuMappings();
 }
 
-void DisplayAddon::handleSystemRestart(GPEvent* e) {
+void DisplayAddon::handleSystemRestart(const GPEvent* e) {
     nextDisplayMode = DisplayMode::RESTART;
-    bootMode = (uint32_t)((GPRestartEvent*)e)->bootMode;
+    bootMode = (uint32_t)((const GPRestartEvent*)e)->bootMode;
 }
 
-void DisplayAddon::handleMenuNavigation(GPEvent* e) {
+void DisplayAddon::handleMenuNavigation(const GPEvent* e) {
     // Swap between main menu and buttons if we press toggle
-    if (((GPMenuNavigateEvent*)e)->menuAction == GpioAction::MENU_NAVIGATION_TOGGLE) {
+    if (((const GPMenuNavigateEvent*)e)->menuAction == GpioAction::MENU_NAVIGATION_TOGGLE) {
         if (currDisplayMode == BUTTONS) {
             nextDisplayMode = MAIN_MENU;
         } else if (currDisplayMode == MAIN_MENU) {
             nextDisplayMode = BUTTONS;
         }
     } else if (currDisplayMode == MAIN_MENU) {
-        ((MainMenuScreen*)gpScreen)->updateEventMenuNavigation(((GPMenuNavigateEvent*)e)->menuAction);
+        ((MainMenuScreen*)gpScreen)->updateEventMenuNavigation(((const GPMenuNavigateEvent*)e)->menuAction);
     }
 }
 
-void DisplayAddon::handleSystemError(GPEvent* e) {
+void DisplayAddon::handleSystemError(const GPEvent* e) {
     currDisplayMode = SYSTEM_ERROR;
-    errorMessage = ((GPSystemErrorEvent*) e)->errorMessage;
+    errorMessage = ((const GPSystemErrorEvent*) e)->errorMessage;
 }
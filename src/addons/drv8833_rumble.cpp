@@ -97,7 +97,7 @@ void DRV8833RumbleAddon::enableMotors(Gamepad * gamepad) {
 }
 
 void DRV8833RumbleAddon::process() {
-	Gamepad * gamepad = Storage::getInstance().GetProcessedGamepad();
+	Gamepad * gamepad = Storage::getInstance().GetSnapshotGamepad();
 
 	if (!compareRumbleState(gamepad)) {
 		setRumbleState(gamepad);
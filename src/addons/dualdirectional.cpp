@@ -33,8 +33,7 @@ void DualDirectionalInput::setup() {
     lastGPUD = DIRECTION_NONE;
     lastGPLR = DIRECTION_NONE;
 
-    lastDualUD = DIRECTION_NONE;
-    lastDualLR = DIRECTION_NONE;
+    dualSOCD.reset();
 }
 
 /**
@@ -49,54 +48,6 @@ void DualDirectionalInput::reinit()
     this->setup();
 }
 
-
-uint8_t DualDirectionalInput::updateDpadDDI(uint8_t dpad, DpadDirection direction)
-{
-	static bool inList[] = {false, false, false, false, false}; // correspond to DpadDirection: none, up, down, left, right
-	static list<DpadDirection> dpadList;
-
-	if(dpad & getMaskFromDirection(direction))
-	{
-		if(!inList[direction])
-		{
-			dpadList.push_back(direction);
-			inList[direction] = true;
-		}
-	}
-	else
-	{
-		if(inList[direction])
-		{
-			dpadList.remove(direction);
-			inList[direction] = false;
-		}
-	}
-
-	if(dpadList.empty()) {
-		return 0;
-	}
-	else {
-		return getMaskFromDirection(dpadList.back());
-	}
-}
-
-/**
- * @brief Filter diagonals out of the dpad, making the device work as a 4-way lever.
- *
- * The most recent cardinal direction wins.
- *
- * @param dpad The GameState.dpad value.
- * @return uint8_t The new dpad value.
- */
-uint8_t DualDirectionalInput::filterToFourWayModeDDI(uint8_t dpad)
-{
-	updateDpadDDI(dpad, DIRECTION_UP);
-	updateDpadDDI(dpad, DIRECTION_DOWN);
-	updateDpadDDI(dpad, DIRECTION_LEFT);
-	return updateDpadDDI(dpad, DIRECTION_RIGHT);
-}
-
-
 void DualDirectionalInput::preprocess()
 {
     const DualDirectionalOptions& options = Storage::getInstance().getAddonOptions().dualDirectionalOptions;
@@ -113,11 +64,11 @@ void DualDirectionalInput::preprocess()
 
     // 4-way before SOCD, might have better history without losing any coherent functionality
     if (options.fourWayMode) {
-        dualState = filterToFourWayModeDDI(dualState);
+        dualState = dualSOCD.filterToFourWay(dualState);
     }
 
     // SOCD clean the dual inputs based on the mode in the gamepad config
-    SOCDDualClean(socdMode);
+    dualState = dualSOCD.cleanDual(socdMode, dualState);
 }
 
 void DualDirectionalInput::process()
@@ -246,61 +197,6 @@ uint8_t DualDirectionalInput::SOCDCombine(SOCDMode mode, uint8_t gamepadState) {
     return outState;
 }
 
-void DualDirectionalInput::SOCDDualClean(SOCDMode socdMode) { 
-    if (socdMode == SOCD_MODE_BYPASS) {
-        return;
-    }
-
-    // Dual SOCD Last-Win Clean
-    switch (dualState & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN)) {
-        case (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN): // If last state was Up or Down, exclude it from our gamepad
-            if ( socdMode == SOCD_MODE_UP_PRIORITY ) {
-                dualState ^= GAMEPAD_MASK_DOWN; // Remove Down
-                lastDualUD = DIRECTION_UP; // We're in UP mode
-            } else if ( socdMode == SOCD_MODE_SECOND_INPUT_PRIORITY && lastDualUD != DIRECTION_NONE ) {
-                dualState ^= (lastDualUD == DIRECTION_UP) ? GAMEPAD_MASK_UP : GAMEPAD_MASK_DOWN;
-            } else if ( socdMode == SOCD_MODE_FIRST_INPUT_PRIORITY && lastDualUD != DIRECTION_NONE ) {
-                dualState ^= (lastDualUD == DIRECTION_UP) ? GAMEPAD_MASK_DOWN : GAMEPAD_MASK_UP;
-            } else {
-                dualState ^= (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN); // Remove UP and Down in Neutral
-                lastDualUD = DIRECTION_NONE;
-            }
-            break;
-        case GAMEPAD_MASK_UP:
-            lastDualUD = DIRECTION_UP;
-            break;
-        case GAMEPAD_MASK_DOWN:
-            lastDualUD = DIRECTION_DOWN;
-            break;
-        default:
-            lastDualUD = DIRECTION_NONE;
-            break;
-    }
-    switch (dualState & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT)) {
-        case (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT):
-            if ( socdMode == SOCD_MODE_UP_PRIORITY || socdMode == SOCD_MODE_NEUTRAL ) {
-                dualState ^= (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT); // Remove L + R to Neutral
-                lastDualLR = DIRECTION_NONE;
-            } else if ( socdMode == SOCD_MODE_SECOND_INPUT_PRIORITY || socdMode == SOCD_MODE_FIRST_INPUT_PRIORITY ) {
-                if (lastDualLR != DIRECTION_NONE)
-                    if (socdMode == SOCD_MODE_SECOND_INPUT_PRIORITY) dualState ^= (lastDualLR == DIRECTION_LEFT) ? GAMEPAD_MASK_LEFT : GAMEPAD_MASK_RIGHT; // Last Win
-                    else dualState ^= (lastDualLR == DIRECTION_LEFT) ? GAMEPAD_MASK_RIGHT : GAMEPAD_MASK_LEFT; // First Win
-                else
-                    lastDualLR = DIRECTION_NONE;
-            }
-            break;
-        case GAMEPAD_MASK_LEFT:
-            lastDualLR = DIRECTION_LEFT;
-            break;
-        case GAMEPAD_MASK_RIGHT:
-            lastDualLR = DIRECTION_RIGHT;
-            break;
-        default:
-            lastDualLR = DIRECTION_NONE;
-            break;
-    }
-}
-
 uint8_t DualDirectionalInput::gpadToBinary(DpadMode dpadMode, GamepadState state) {
     uint8_t out = 0;
     switch(dpadMode) { // Convert gamepad to dual if we're in mixed
@@ -1,5 +1,6 @@
 #include "addons/he_trigger.h"
 #include "storagemanager.h"
+#include "inputcapture.h"
 
 #include "hardware/adc.h"
 
@@ -107,6 +108,7 @@ void HETriggerAddon::preprocess() {
             lastADCSelected = muxPinArray[mux];
         }
         value = adc_read();
+        INPUT_CAPTURE_ADC_SAMPLE(INPUT_CAPTURE_ADC_HE_TRIGGER | he, value);
 
         // EMA Smoothing
         if ( options.emaSmoothing == 1 ) {
@@ -157,13 +159,13 @@ void HETriggerAddon::preprocess() {
                 case GpioAction::ANALOG_DIRECTION_RS_Y_NEG:	gamepad->state.ry = GAMEPAD_JOYSTICK_MIN; break;
                 case GpioAction::ANALOG_DIRECTION_RS_Y_POS:	gamepad->state.ry = GAMEPAD_JOYSTICK_MAX; break;
                 case GpioAction::BUTTON_PRESS_FN:	gamepad->state.aux |= AUX_MASK_FUNCTION; break;
-                case GpioAction::MENU_NAVIGATION_UP: EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_UP)); break;
-                case GpioAction::MENU_NAVIGATION_DOWN: EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_DOWN)); break;
-                case GpioAction::MENU_NAVIGATION_LEFT: EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_LEFT)); break;
-                case GpioAction::MENU_NAVIGATION_RIGHT: EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_RIGHT)); break;
-                case GpioAction::MENU_NAVIGATION_SELECT: EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_SELECT)); break;
-                case GpioAction::MENU_NAVIGATION_BACK: EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_BACK)); break;
-                case GpioAction::MENU_NAVIGATION_TOGGLE: EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_TOGGLE)); break;
+                case GpioAction::MENU_NAVIGATION_UP: EventManager::getInstance().triggerEvent(GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_UP)); break;
+                case GpioAction::MENU_NAVIGATION_DOWN: EventManager::getInstance().triggerEvent(GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_DOWN)); break;
+                case GpioAction::MENU_NAVIGATION_LEFT: EventManager::getInstance().triggerEvent(GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_LEFT)); break;
+                case GpioAction::MENU_NAVIGATION_RIGHT: EventManager::getInstance().triggerEvent(GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_RIGHT)); break;
+                case GpioAction::MENU_NAVIGATION_SELECT: EventManager::getInstance().triggerEvent(GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_SELECT)); break;
+                case GpioAction::MENU_NAVIGATION_BACK: EventManager::getInstance().triggerEvent(GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_BACK)); break;
+                case GpioAction::MENU_NAVIGATION_TOGGLE: EventManager::getInstance().triggerEvent(GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_TOGGLE)); break;
                 default: break;
             }
         }
@@ -248,7 +248,7 @@ void InputMacro::preprocess()
         Gamepad * gamepad = Storage::getInstance().GetGamepad();
         // Override Toggle Pressed OR focus mode pin is set
         if (focusModeOptions->overrideEnabled ||
-            (gamepad->mapFocusMode->pinMask && (gamepad->debouncedGpio & gamepad->mapFocusMode->pinMask))) {
+            (gamepad->getMappings().mapFocusMode.pinMask && (gamepad->debouncedGpio & gamepad->getMappings().mapFocusMode.pinMask))) {
             return;
         }
     }
@@ -510,7 +510,7 @@ void NeoPicoLEDAddon::process() {
 
     // Get turbo options (turbo RGB led)
     const TurboOptions& turboOptions = Storage::getInstance().getAddonOptions().turboOptions;
-    Gamepad * gamepad = Storage::getInstance().GetProcessedGamepad();
+    Gamepad * gamepad = Storage::getInstance().GetSnapshotGamepad();
     GamepadHotkey action = animationHotkeys(gamepad);
     if (ledOptions.pledType == PLED_TYPE_RGB) {
         if (gamepad->auxState.playerID.enabled && gamepad->auxState.playerID.active) {
@@ -1124,7 +1124,7 @@ void NeoPicoLEDAddon::ambientHotkeys(Gamepad *gamepad)
 	}
 
 	if (reqSave) {
-		EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(false));
+		EventManager::getInstance().triggerEvent(GPStorageSaveEvent(false));
 	}
 
 	lastAmbientAction = action;
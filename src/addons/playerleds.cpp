@@ -124,7 +124,7 @@ void PlayerLEDAddon::process()
 {
 	if (turnOffWhenSuspended && get_usb_suspended()) return;
 
-	Gamepad * gamepad = Storage::getInstance().GetProcessedGamepad();
+	Gamepad * gamepad = Storage::getInstance().GetSnapshotGamepad();
 	const LEDOptions& ledOptions = Storage::getInstance().getLedOptions();
 
 	// Player LEDs can be PWM or driven by NeoPixel
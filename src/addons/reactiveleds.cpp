@@ -44,7 +44,7 @@ void ReactiveLEDAddon::setup() {
 }
 
 void ReactiveLEDAddon::process() {
-    Gamepad * gamepad = Storage::getInstance().GetProcessedGamepad();
+    Gamepad * gamepad = Storage::getInstance().GetSnapshotGamepad();
 
     uint32_t currUpdate = to_ms_since_boot(get_absolute_time());
 
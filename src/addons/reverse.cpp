@@ -39,10 +39,10 @@ void ReverseInput::setup()
     actionRight = options.actionRight;
 
     Gamepad * gamepad = Storage::getInstance().GetGamepad();
-    mapDpadUp    = gamepad->mapDpadUp;
-    mapDpadDown  = gamepad->mapDpadDown;
-    mapDpadLeft  = gamepad->mapDpadLeft;
-    mapDpadRight = gamepad->mapDpadRight;
+    mapDpadUp    = &gamepad->getMappings().mapDpadUp;
+    mapDpadDown  = &gamepad->getMappings().mapDpadDown;
+    mapDpadLeft  = &gamepad->getMappings().mapDpadLeft;
+    mapDpadRight = &gamepad->getMappings().mapDpadRight;
 
     invertXAxis = gamepad->getOptions().invertXAxis;
     invertYAxis = gamepad->getOptions().invertYAxis;
@@ -24,7 +24,7 @@ void TiltInput::setup() {
 	mapAnalogModLow = new GamepadButtonMapping(ANALOG_DIRECTION_MOD_LOW);
 	mapAnalogModHigh = new GamepadButtonMapping(ANALOG_DIRECTION_MOD_HIGH);
 
-	EventManager::getInstance().registerEventHandler(GP_EVENT_PROFILE_CHANGE, GPEVENT_CALLBACK(this->handleProfileChange(event)));
+	EventManager::getInstance().registerEventHandler(GP_EVENT_PROFILE_CHANGE, GPEVENT_CALLBACK(TiltInput, handleProfileChange), this);
 
 	reloadMappings();
 
@@ -312,6 +312,6 @@ void TiltInput::SOCDTiltClean(SOCDMode socdMode) {
 	}
 }
 
-void TiltInput::handleProfileChange(GPEvent* e) {
+void TiltInput::handleProfileChange(const GPEvent* e) {
 	reloadMappings();
 }
@@ -4,6 +4,7 @@
 
 #include "storagemanager.h"
 #include "helper.h"
+#include "inputcapture.h"
 #include "config.pb.h"
 
 #include <algorithm>
@@ -184,6 +185,7 @@ void TurboInput::process()
     if (hasShmupDial && nextAdcRead < now) {
         adc_select_input(adcShmupDial);
         dialValue = adc_read();
+        INPUT_CAPTURE_ADC_SAMPLE(adcShmupDial, dialValue);
         uint8_t shotCount = (dialValue / TURBO_DIAL_INCREMENTS) + TURBO_SHOT_MIN;
         if (shotCount != options.shotCount) {
             updateTurboShotCount(shotCount, false);
@@ -246,7 +248,7 @@ void TurboInput::updateTurboShotCount(uint8_t shotCount, bool save) {
   lastShotCount = shotCount;
 
   if (save) {
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(false));
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(false));
   }
 
   uIntervalUS = (uint32_t)std::floor(1000000.0 / (shotCount * 2));
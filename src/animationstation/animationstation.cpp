@@ -90,7 +90,7 @@ void AnimationStation::HandleEvent(GamepadHotkey action) {
   }
 
 	if (reqSave) {
-		EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(false));
+		EventManager::getInstance().triggerEvent(GPStorageSaveEvent(false));
 	}
 }
 
@@ -0,0 +1,61 @@
+#include "bootprofile.h"
+
+#include <cstring>
+#include "pico/platform.h"
+#include "pico/time.h"
+
+#define BOOT_PROFILE_MAGIC 0x544F4F42 // BOOT
+
+struct BootProfileTrace {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t phaseUs[BOOT_PHASE_COUNT];
+    uint32_t previousUs[BOOT_PHASE_COUNT];
+};
+
+static BootProfileTrace __uninitialized_ram(bootTrace);
+
+static const char* const phaseNames[BOOT_PHASE_COUNT] = {
+    "config loaded",
+    "peripherals",
+    "core0 add-ons",
+    "core0 setup",
+    "usb init",
+    "config complete",
+    "core1 setup",
+    "loop",
+    "usb mounted",
+};
+
+void BootProfile::init() {
+    bool valid = bootTrace.magic == BOOT_PROFILE_MAGIC && bootTrace.version == BOOT_PROFILE_VERSION;
+    if (valid) {
+        memcpy(bootTrace.previousUs, bootTrace.phaseUs, sizeof(bootTrace.previousUs));
+    } else {
+        memset(bootTrace.previousUs, 0, sizeof(bootTrace.previousUs));
+        bootTrace.magic = BOOT_PROFILE_MAGIC;
+        bootTrace.version = BOOT_PROFILE_VERSION;
+    }
+    memset(bootTrace.phaseUs, 0, sizeof(bootTrace.phaseUs));
+}
+
+void BootProfile::mark(BootPhase phase) {
+    if (phase >= BOOT_PHASE_COUNT || bootTrace.phaseUs[phase] != 0)
+        return;
+
+    // the timer starts at 0 on reset, keep 0 for not reached
+    uint32_t nowUs = time_us_32();
+    bootTrace.phaseUs[phase] = nowUs != 0 ? nowUs : 1;
+}
+
+uint32_t BootProfile::getUs(BootPhase phase) {
+    return phase < BOOT_PHASE_COUNT ? bootTrace.phaseUs[phase] : 0;
+}
+
+uint32_t BootProfile::getPreviousUs(BootPhase phase) {
+    return phase < BOOT_PHASE_COUNT ? bootTrace.previousUs[phase] : 0;
+}
+
+const char* BootProfile::getPhaseName(BootPhase phase) {
+    return phase < BOOT_PHASE_COUNT ? phaseNames[phase] : "";
+}
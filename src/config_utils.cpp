@@ -10,6 +10,7 @@
 #include "BoardConfig.h"
 #include "GamepadConfig.h"
 #include "version.h"
+#include "sofsync.h"
 #include "addons/analog.h"
 #include "addons/board_led.h"
 #include "addons/bootsel_button.h"
@@ -39,6 +40,8 @@
 
 #include "CRC32.h"
 #include "FlashPROM.h"
+#include "configlog.h"
+#include "bootprofile.h"
 #include "base64.h"
 
 #include <ArduinoJson.h>
@@ -47,6 +50,7 @@
 #include <cstring>
 #include <memory>
 
+#include "pico/mutex.h"
 #include "pico/platform.h"
 
 // -----------------------------------------------------
@@ -126,6 +130,26 @@
     #define DEFAULT_DEBOUNCE_DELAY 5
 #endif
 
+#ifndef DEFAULT_DEBOUNCE_MODE
+    #define DEFAULT_DEBOUNCE_MODE DEBOUNCE_MODE_LOCKOUT
+#endif
+
+#ifndef DEFAULT_USB_SOF_SYNC
+    #define DEFAULT_USB_SOF_SYNC false
+#endif
+
+#ifndef DEFAULT_GPIO_EDGE_CAPTURE
+    #define DEFAULT_GPIO_EDGE_CAPTURE false
+#endif
+
+#ifndef DEFAULT_GPIO_OVERSAMPLING
+    #define DEFAULT_GPIO_OVERSAMPLING false
+#endif
+
+#ifndef DEFAULT_IDLE_SLEEP
+    #define DEFAULT_IDLE_SLEEP false
+#endif
+
 #ifndef DEFAULT_PS4_REPORTHACK
     #define DEFAULT_PS4_REPORTHACK false
 #endif
@@ -300,6 +324,12 @@ void ConfigUtils::initUnsetPropertiesWithDefaults(Config& config)
     INIT_UNSET_PROPERTY(config.gamepadOptions, profileNumber, 1);
     INIT_UNSET_PROPERTY(config.gamepadOptions, ps4ControllerType, DEFAULT_PS4CONTROLLER_TYPE);
     INIT_UNSET_PROPERTY(config.gamepadOptions, debounceDelay, DEFAULT_DEBOUNCE_DELAY);
+    INIT_UNSET_PROPERTY(config.gamepadOptions, debounceMode, DEFAULT_DEBOUNCE_MODE);
+    INIT_UNSET_PROPERTY(config.gamepadOptions, usbSofSync, DEFAULT_USB_SOF_SYNC);
+    INIT_UNSET_PROPERTY(config.gamepadOptions, usbSofSyncMarginUs, DEFAULT_USB_SOF_SYNC_MARGIN_US);
+    INIT_UNSET_PROPERTY(config.gamepadOptions, gpioEdgeCapture, DEFAULT_GPIO_EDGE_CAPTURE);
+    INIT_UNSET_PROPERTY(config.gamepadOptions, gpioOversampling, DEFAULT_GPIO_OVERSAMPLING);
+    INIT_UNSET_PROPERTY(config.gamepadOptions, idleSleep, DEFAULT_IDLE_SLEEP);
     INIT_UNSET_PROPERTY(config.gamepadOptions, inputModeB1, DEFAULT_INPUT_MODE_B1);
     INIT_UNSET_PROPERTY(config.gamepadOptions, inputModeB2, DEFAULT_INPUT_MODE_B2);
     INIT_UNSET_PROPERTY(config.gamepadOptions, inputModeB3, DEFAULT_INPUT_MODE_B3);
@@ -387,6 +417,38 @@ void ConfigUtils::initUnsetPropertiesWithDefaults(Config& config)
     INIT_UNSET_PROPERTY(hotkeyOptions.hotkey16, buttonsMask, HOTKEY_16_BUTTONS_MASK);
     INIT_UNSET_PROPERTY(hotkeyOptions.hotkey16, dpadMask, HOTKEY_16_DPAD_MASK);
     INIT_UNSET_PROPERTY(hotkeyOptions.hotkey16, action, GamepadHotkey(HOTKEY_16_ACTION));
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey17, auxMask, HOTKEY_17_AUX_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey17, buttonsMask, HOTKEY_17_BUTTONS_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey17, dpadMask, HOTKEY_17_DPAD_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey17, action, GamepadHotkey(HOTKEY_17_ACTION));
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey18, auxMask, HOTKEY_18_AUX_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey18, buttonsMask, HOTKEY_18_BUTTONS_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey18, dpadMask, HOTKEY_18_DPAD_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey18, action, GamepadHotkey(HOTKEY_18_ACTION));
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey19, auxMask, HOTKEY_19_AUX_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey19, buttonsMask, HOTKEY_19_BUTTONS_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey19, dpadMask, HOTKEY_19_DPAD_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey19, action, GamepadHotkey(HOTKEY_19_ACTION));
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey20, auxMask, HOTKEY_20_AUX_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey20, buttonsMask, HOTKEY_20_BUTTONS_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey20, dpadMask, HOTKEY_20_DPAD_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey20, action, GamepadHotkey(HOTKEY_20_ACTION));
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey21, auxMask, HOTKEY_21_AUX_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey21, buttonsMask, HOTKEY_21_BUTTONS_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey21, dpadMask, HOTKEY_21_DPAD_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey21, action, GamepadHotkey(HOTKEY_21_ACTION));
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey22, auxMask, HOTKEY_22_AUX_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey22, buttonsMask, HOTKEY_22_BUTTONS_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey22, dpadMask, HOTKEY_22_DPAD_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey22, action, GamepadHotkey(HOTKEY_22_ACTION));
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey23, auxMask, HOTKEY_23_AUX_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey23, buttonsMask, HOTKEY_23_BUTTONS_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey23, dpadMask, HOTKEY_23_DPAD_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey23, action, GamepadHotkey(HOTKEY_23_ACTION));
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey24, auxMask, HOTKEY_24_AUX_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey24, buttonsMask, HOTKEY_24_BUTTONS_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey24, dpadMask, HOTKEY_24_DPAD_MASK);
+    INIT_UNSET_PROPERTY(hotkeyOptions.hotkey24, action, GamepadHotkey(HOTKEY_24_ACTION));
 
     // forcedSetupMode
     INIT_UNSET_PROPERTY(config.forcedSetupOptions, mode, DEFAULT_FORCED_SETUP_MODE);
@@ -982,6 +1044,11 @@ void ConfigUtils::initUnsetPropertiesWithDefaults(Config& config)
     // reminder that this must be set or else nanopb won't retain anything
     config.addonOptions.heTriggerOptions.triggers_count = HETRIGGER_COUNT;
 
+    // addonOptions.addonProfilerOptions
+    INIT_UNSET_PROPERTY(config.addonOptions.addonProfilerOptions, budgetUs, ADDON_BUDGET_US);
+    INIT_UNSET_PROPERTY(config.addonOptions.addonProfilerOptions, demoteOverBudget, !!ADDON_DEMOTE_OVER_BUDGET);
+    INIT_UNSET_PROPERTY(config.addonOptions.addonProfilerOptions, demotedInterval, ADDON_DEMOTED_INTERVAL);
+
     // keyboardMapping
     INIT_UNSET_PROPERTY(config.addonOptions.keyboardHostOptions, enabled, KEYBOARD_HOST_ENABLED);
     INIT_UNSET_PROPERTY(config.addonOptions.keyboardHostOptions, deprecatedPinDplus, KEYBOARD_HOST_PIN_DPLUS);
@@ -1756,43 +1823,193 @@ void hotkeysMigration(Config& config)
 // Loading / Saving
 // -----------------------------------------------------
 
-// We put a ConfigFooter struct at the end of the flash area reserved for FlashPROM. It contains a magicvalue, the size
-// of the serialized config data and a CRC of that data. This information allows us to both locate and verify the stored
-// data. The serialized data is located directly before the footer:
+// The config is saved as a log of records in the flash area reserved for FlashPROM, see ConfigLog. Each record is a
+// header followed by the serialized config, and the newest valid one is loaded:
 //
 //                       FlashPROM block
 // ┌────────────────────────────┴─────────────────────────────┐
-// ┌──────────────┬────────────────────────────────────┬──────┐
-// │Unused memory │Protobuf data                       │Footer│
-// └──────────────┴────────────────────────────────────┴──────┘
+// ┌──────┬───────────────┬──────┬───────────────┬────────────┐
+// │Header│Protobuf data  │Header│Protobuf data  │Erased      │
+// └──────┴───────────────┴──────┴───────────────┴────────────┘
 //
+// Older firmware put a ConfigFooter struct at the end of the flash area instead. It contains a magicvalue, the size of
+// the serialized config data and a CRC of that data, the serialized data being located directly before the footer.
+// It is still read when there is no log yet.
 struct ConfigFooter
 {
     uint32_t dataSize;
     uint32_t dataCrc;
     uint32_t magic;
-
-    bool operator==(const ConfigFooter& other) const
-    {
-        return
-            dataSize == other.dataSize &&
-            dataCrc == other.dataCrc &&
-            magic == other.magic;
-    }
 };
 
 static const uint32_t FOOTER_MAGIC = 0xd2f1e365;
 
 // Verify that the maximum size of the serialized Config object fits into the allocated flash block
 #if defined(Config_size)
-    static_assert(Config_size + sizeof(ConfigFooter) <= EEPROM_SIZE_BYTES, "Maximum size of Config exceeds the maximum size allocated for FlashPROM");
+    static_assert(Config_size + sizeof(ConfigLogHeader) <= EEPROM_SIZE_BYTES, "Maximum size of Config exceeds the maximum size allocated for FlashPROM");
 #else
     #error "Maximum size of Config cannot be determined statically, make sure that you do not use any dynamically sized arrays or strings"
 #endif
 
+// Top-level sections that nothing needs until after USB enumeration. They are decoded into the config on top of the
+// rest later, see ConfigUtils::loadDeferred(), which is the same as decoding everything at once.
+static const uint32_t deferredConfigTags[] = { Config_displayOptions_tag, Config_animationOptions_tag };
+
+#define DEFERRED_CONFIG_MAX_RANGES 4
+
+// Where the deferred sections are in the serialized config
+struct DeferredConfigSections
+{
+    const uint8_t* data;
+    size_t size;
+    size_t start[DEFERRED_CONFIG_MAX_RANGES];
+    size_t end[DEFERRED_CONFIG_MAX_RANGES];
+    uint8_t count;
+};
+
+// Reads either everything but the deferred sections, or only those
+struct DeferredConfigStream
+{
+    const DeferredConfigSections* sections;
+    bool deferred;
+    size_t position;
+};
+
+static DeferredConfigSections deferredConfigSections = {};
+static volatile bool configComplete = true;
+static bool deferredConfigFailed = false;
+auto_init_mutex(deferredConfigMutex);
+
+static bool isDeferredConfigTag(uint32_t tag)
+{
+    for (uint32_t deferredTag : deferredConfigTags)
+    {
+        if (tag == deferredTag)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool findDeferredConfigSections(const uint8_t* data, size_t size, DeferredConfigSections& sections)
+{
+    sections.data = data;
+    sections.size = size;
+    sections.count = 0;
+
+    pb_istream_t stream = pb_istream_from_buffer(data, size);
+    while (stream.bytes_left > 0)
+    {
+        const size_t start = size - stream.bytes_left;
+        pb_wire_type_t wireType;
+        uint32_t tag;
+        bool eof;
+        if (!pb_decode_tag(&stream, &wireType, &tag, &eof) || !pb_skip_field(&stream, wireType))
+        {
+            return false;
+        }
+
+        if (isDeferredConfigTag(tag))
+        {
+            if (sections.count == DEFERRED_CONFIG_MAX_RANGES)
+            {
+                return false;
+            }
+            sections.start[sections.count] = start;
+            sections.end[sections.count] = size - stream.bytes_left;
+            sections.count++;
+        }
+    }
+    return sections.count > 0;
+}
+
+static bool deferredConfigStreamCallback(pb_istream_t* stream, pb_byte_t* buf, size_t count)
+{
+    DeferredConfigStream& state = *reinterpret_cast<DeferredConfigStream*>(stream->state);
+    const DeferredConfigSections& sections = *state.sections;
+
+    while (count > 0)
+    {
+        // Bytes up to the next boundary between the sections this stream reads and the others
+        size_t boundary = sections.size;
+        bool inDeferred = false;
+        for (uint8_t i = 0; i < sections.count; i++)
+        {
+            if (state.position >= sections.start[i] && state.position < sections.end[i])
+            {
+                inDeferred = true;
+                boundary = sections.end[i];
+                break;
+            }
+            if (sections.start[i] > state.position && sections.start[i] < boundary)
+            {
+                boundary = sections.start[i];
+            }
+        }
+        if (boundary <= state.position)
+        {
+            return false;
+        }
+
+        if (inDeferred != state.deferred)
+        {
+            state.position = boundary;
+            continue;
+        }
+
+        const size_t length = (boundary - state.position) < count ? (boundary - state.position) : count;
+        memcpy(buf, sections.data + state.position, length);
+        buf += length;
+        count -= length;
+        state.position += length;
+    }
+    return true;
+}
+
+static pb_istream_t deferredConfigStream(DeferredConfigStream& state, bool deferred)
+{
+    const DeferredConfigSections& sections = *state.sections;
+    size_t deferredSize = 0;
+    for (uint8_t i = 0; i < sections.count; i++)
+    {
+        deferredSize += sections.end[i] - sections.start[i];
+    }
+
+    state.deferred = deferred;
+    state.position = 0;
+    return { deferredConfigStreamCallback, &state, deferred ? deferredSize : sections.size - deferredSize };
+}
+
+static bool decodeConfig(Config& config, const uint8_t* data, size_t size)
+{
+    // Only what is needed to get to USB enumeration, if the deferred sections can be told apart
+    if (findDeferredConfigSections(data, size, deferredConfigSections))
+    {
+        DeferredConfigStream state = { &deferredConfigSections };
+        pb_istream_t inputStream = deferredConfigStream(state, false);
+        if (pb_decode(&inputStream, Config_fields, &config))
+        {
+            configComplete = false;
+            return true;
+        }
+    }
+
+    pb_istream_t inputStream = pb_istream_from_buffer(data, size);
+    return pb_decode(&inputStream, Config_fields, &config);
+}
+
 static bool loadConfigInner(Config& config)
 {
     config = Config Config_init_zero;
+    configComplete = true;
+
+    const uint8_t* flashStart = reinterpret_cast<const uint8_t*>(EEPROM_ADDRESS_START);
+    const ConfigLogRecord latest = ConfigLog::findLatest(flashStart, EEPROM_SIZE_BYTES);
+    if (latest.valid)
+    {
+        return decodeConfig(config, latest.data(flashStart), latest.dataSize);
+    }
 
     const uint8_t* flashEnd = reinterpret_cast<const uint8_t*>(EEPROM_ADDRESS_START) + EEPROM_SIZE_BYTES;
     const ConfigFooter& footer = *reinterpret_cast<const ConfigFooter*>(flashEnd - sizeof(ConfigFooter));
@@ -1818,8 +2035,7 @@ static bool loadConfigInner(Config& config)
     }
 
     // We are now sufficiently confident that the data is valid so we run the deserialization
-    pb_istream_t inputStream = pb_istream_from_buffer(dataPtr, footer.dataSize);
-    return pb_decode(&inputStream, Config_fields, &config);
+    return decodeConfig(config, dataPtr, footer.dataSize);
 }
 
 void ConfigUtils::load(Config& config)
@@ -1834,6 +2050,12 @@ void ConfigUtils::load(Config& config)
         config = Config Config_init_default;
     }
 
+    // The deferred sections are only left for later on boots that have nothing to migrate and save, the first boot of
+    // a new version reads and saves everything as before
+    const bool sameVersion = strncmp(config.boardVersion, GP2040VERSION, sizeof(config.boardVersion)) == 0;
+    if (!configComplete && !(sameVersion && config.migrations.gpioMappingsMigrated))
+        loadDeferred(config);
+
     // run migrations
     if (!config.migrations.hotkeysMigrated)
         hotkeysMigration(config);
@@ -1866,8 +2088,45 @@ void ConfigUtils::load(Config& config)
     config.boardVersion[sizeof(config.boardVersion) - 1] = '\0';
     config.has_boardVersion = true;
 
+    BootProfile::mark(BOOT_PHASE_CONFIG_LOADED);
+
     // Save, to make sure we persist any performed migration steps
-    save(config);
+    if (configComplete)
+        save(config);
+}
+
+void ConfigUtils::loadDeferred(Config& config)
+{
+    if (configComplete)
+        return;
+
+    mutex_enter_blocking(&deferredConfigMutex);
+    if (!configComplete)
+    {
+        // The defaults initUnsetPropertiesWithDefaults() put in are overwritten by whatever was saved, as decoding
+        // everything at once followed by the defaults for what wasn't saved would
+        DeferredConfigStream state = { &deferredConfigSections };
+        pb_istream_t inputStream = deferredConfigStream(state, true);
+        if (!pb_decode_ex(&inputStream, Config_fields, &config, PB_DECODE_NOINIT))
+        {
+            // Whatever got decoded before the error is suspect, go back to the defaults for both sections
+            config.has_displayOptions = false;
+            config.displayOptions = DisplayOptions DisplayOptions_init_default;
+            config.has_animationOptions = false;
+            config.animationOptions = AnimationOptions AnimationOptions_init_default;
+            initUnsetPropertiesWithDefaults(config);
+            deferredConfigFailed = true;
+        }
+
+        configComplete = true;
+        BootProfile::mark(BOOT_PHASE_CONFIG_COMPLETE);
+    }
+    mutex_exit(&deferredConfigMutex);
+}
+
+bool ConfigUtils::loadDeferredFailed()
+{
+    return deferredConfigFailed;
 }
 
 static void setHasFlags(const pb_msgdesc_t* fields, void* s)
@@ -1928,6 +2187,16 @@ static void setHasFlags(const pb_msgdesc_t* fields, void* s)
     } while (pb_field_iter_next(&iter));
 }
 
+static bool crcStreamCallback(pb_ostream_t* stream, const pb_byte_t* buf, size_t count)
+{
+    CRC32* crc = reinterpret_cast<CRC32*>(stream->state);
+    for (size_t i = 0; i < count; i++)
+    {
+        crc->update(buf[i]);
+    }
+    return true;
+}
+
 bool ConfigUtils::save(Config& config)
 {
     // We only allow saves from core0. Saves from core1 have to be marshalled to core0.
@@ -1937,39 +2206,47 @@ bool ConfigUtils::save(Config& config)
         return false;
     }
 
+    // Everything has to be there to be saved
+    loadDeferred(config);
+
     // Set all has_XXX flags to true, we want to save all fields.
     // If we didn't do this we would have to remember to set the has_XXX flag manually whenever we change a field from
     // its default value.
     setHasFlags(Config_fields, &config);
 
-    // Encode the data directly into the cache of FlashPROM
-    pb_ostream_t outputStream = pb_ostream_from_buffer(EEPROM.writeCache, EEPROM_SIZE_BYTES - sizeof(ConfigFooter));
-    if (!pb_encode(&outputStream, Config_fields, &config))
+    // Size and CRC of the encoded data, without a buffer to encode it into
+    CRC32 crc;
+    pb_ostream_t crcStream = { crcStreamCallback, &crc, SIZE_MAX, 0 };
+    if (!pb_encode(&crcStream, Config_fields, &config))
     {
         return false;
     }
+    const uint32_t dataSize = crcStream.bytes_written;
+    const uint32_t dataCrc = crc.finalize();
 
-    // Create the new footer
-    ConfigFooter newFooter;
-    newFooter.dataSize = outputStream.bytes_written;
-    newFooter.dataCrc = CRC32::calculate(EEPROM.writeCache, newFooter.dataSize);
-    newFooter.magic = FOOTER_MAGIC;
-
-    // The data has changed when the footer content has changed. Only then do we acutally need to save.
-    const ConfigFooter& oldFooter = *reinterpret_cast<ConfigFooter*>(EEPROM.writeCache + EEPROM_SIZE_BYTES - sizeof(ConfigFooter));
-    if (newFooter == oldFooter)
+    // The data has changed when it no longer matches the newest record. Only then do we acutally need to save.
+    // The write cache holds the records that are still waiting to be committed, too.
+    const ConfigLogRecord latest = ConfigLog::findLatest(EEPROM.writeCache, EEPROM_SIZE_BYTES);
+    if (latest.valid && latest.dataSize == dataSize && latest.dataCrc == dataCrc)
     {
         // The data has not changed, no saving neccessary.
         return true;
     }
 
-    // Write the footer
-    ConfigFooter* cacheFooter = reinterpret_cast<ConfigFooter*>(EEPROM.writeCache + EEPROM_SIZE_BYTES - sizeof(ConfigFooter));
-    memcpy(cacheFooter, &newFooter, sizeof(ConfigFooter));
+    // Append a record to the log and encode the data directly into it, in the cache of FlashPROM
+    ConfigLogRecord record;
+    uint8_t* data = ConfigLog::reserve(EEPROM.writeCache, EEPROM_SIZE_BYTES, latest, dataSize, record);
+    if (data == nullptr)
+    {
+        return false;
+    }
 
-    // Move the encoded data in memory down to the footer
-    memmove(EEPROM.writeCache + EEPROM_SIZE_BYTES - sizeof(ConfigFooter) - newFooter.dataSize, EEPROM.writeCache, newFooter.dataSize);
-    memset(EEPROM.writeCache, 0, EEPROM_SIZE_BYTES - sizeof(ConfigFooter) - newFooter.dataSize);
+    pb_ostream_t outputStream = pb_ostream_from_buffer(data, dataSize);
+    if (!pb_encode(&outputStream, Config_fields, &config))
+    {
+        return false;
+    }
+    ConfigLog::seal(EEPROM.writeCache, record, dataCrc);
 
     EEPROM.commit();
 
@@ -0,0 +1,131 @@
+#include "configlog.h"
+
+#include <cstddef>
+#include <cstring>
+#include "CRC32.h"
+
+static uint32_t headerCrcOf(const ConfigLogHeader& header) {
+    return CRC32::calculate(reinterpret_cast<const uint8_t*>(&header), offsetof(ConfigLogHeader, headerCrc));
+}
+
+static uint32_t spanOf(uint32_t dataSize) {
+    return (sizeof(ConfigLogHeader) + dataSize + CONFIG_LOG_PAGE_SIZE - 1) & ~(CONFIG_LOG_PAGE_SIZE - 1);
+}
+
+static bool isErased(const uint8_t* data, uint32_t size) {
+    for (uint32_t i = 0; i < size; i++) {
+        if (data[i] != 0xFF)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Call function for every sector a record at start would need erased.
+ *
+ * Only the part of a sector the record covers has to be erased already, the rest of it may hold
+ * anything.
+ */
+template <typename Function>
+static void forSectorsToErase(const uint8_t* region, uint32_t start, uint32_t span, Function function) {
+    for (uint32_t sector = start - start % CONFIG_LOG_SECTOR_SIZE; sector < start + span; sector += CONFIG_LOG_SECTOR_SIZE) {
+        uint32_t from = sector > start ? sector : start;
+        uint32_t to = (sector + CONFIG_LOG_SECTOR_SIZE) < (start + span) ? (sector + CONFIG_LOG_SECTOR_SIZE) : (start + span);
+        if (!isErased(region + from, to - from))
+            function(sector);
+    }
+}
+
+// A record can go at start if that doesn't erase the one to keep
+static bool canPlace(const uint8_t* region, uint32_t regionSize, uint32_t start, uint32_t span, const ConfigLogRecord& keep) {
+    if (start + span > regionSize)
+        return false;
+
+    bool overlaps = false;
+    forSectorsToErase(region, start, span, [&](uint32_t sector) {
+        if (keep.valid && sector < keep.end && keep.offset < sector + CONFIG_LOG_SECTOR_SIZE)
+            overlaps = true;
+    });
+    return !overlaps;
+}
+
+ConfigLogRecord ConfigLog::findLatest(const uint8_t* region, uint32_t regionSize) {
+    // the newest header first, then older ones for as long as their data doesn't check out
+    uint32_t below = UINT32_MAX;
+    uint32_t nextSequence = 1;
+    while (true) {
+        ConfigLogRecord candidate;
+        for (uint32_t offset = 0; offset + sizeof(ConfigLogHeader) <= regionSize; offset += CONFIG_LOG_PAGE_SIZE) {
+            ConfigLogHeader header;
+            memcpy(&header, region + offset, sizeof(header));
+            if (header.magic != CONFIG_LOG_MAGIC || header.headerCrc != headerCrcOf(header))
+                continue;
+            if (header.dataSize > regionSize - offset - sizeof(ConfigLogHeader))
+                continue;
+            if (header.sequence >= nextSequence)
+                nextSequence = header.sequence + 1;
+            if (header.sequence >= below || (candidate.valid && header.sequence <= candidate.sequence))
+                continue;
+
+            candidate.valid = true;
+            candidate.offset = offset;
+            candidate.end = offset + spanOf(header.dataSize);
+            candidate.sequence = header.sequence;
+            candidate.dataSize = header.dataSize;
+            candidate.dataCrc = header.dataCrc;
+        }
+
+        candidate.nextSequence = nextSequence;
+        if (!candidate.valid || CRC32::calculate(candidate.data(region), candidate.dataSize) == candidate.dataCrc)
+            return candidate;
+        below = candidate.sequence;
+    }
+}
+
+uint8_t* ConfigLog::reserve(uint8_t* region, uint32_t regionSize, const ConfigLogRecord& latest, uint32_t dataSize,
+    ConfigLogRecord& record)
+{
+    const uint32_t span = spanOf(dataSize);
+    if (span > regionSize)
+        return nullptr;
+
+    // right after the newest record, or from the next sector when the rest of its own sector is
+    // taken by older ones, or back at the start
+    uint32_t start = 0;
+    if (latest.valid) {
+        uint32_t nextSector = (latest.end + CONFIG_LOG_SECTOR_SIZE - 1) & ~(CONFIG_LOG_SECTOR_SIZE - 1);
+        if (canPlace(region, regionSize, latest.end, span, latest))
+            start = latest.end;
+        else if (canPlace(region, regionSize, nextSector, span, latest))
+            start = nextSector;
+        else if (!canPlace(region, regionSize, 0, span, latest))
+            // the record is too large to keep the newest one around, start over
+            memset(region, 0xFF, regionSize);
+    }
+
+    forSectorsToErase(region, start, span, [&](uint32_t sector) {
+        memset(region + sector, 0xFF, CONFIG_LOG_SECTOR_SIZE);
+    });
+
+    record.valid = false;
+    record.offset = start;
+    record.end = start + span;
+    // a save cut short may have left a header with the next sequence behind, don't reuse it
+    record.sequence = latest.nextSequence;
+    record.dataSize = dataSize;
+    record.dataCrc = 0;
+    return region + start + sizeof(ConfigLogHeader);
+}
+
+void ConfigLog::seal(uint8_t* region, ConfigLogRecord& record, uint32_t dataCrc) {
+    ConfigLogHeader header;
+    header.magic = CONFIG_LOG_MAGIC;
+    header.sequence = record.sequence;
+    header.dataSize = record.dataSize;
+    header.dataCrc = dataCrc;
+    header.headerCrc = headerCrcOf(header);
+    memcpy(region + record.offset, &header, sizeof(header));
+
+    record.dataCrc = dataCrc;
+    record.valid = true;
+}
@@ -12,7 +12,7 @@ Gamepad* GPGFX_UI::getGamepad() {
 }
 
 Gamepad* GPGFX_UI::getProcessedGamepad() { 
-    return Storage::getInstance().GetProcessedGamepad();
+    return Storage::getInstance().GetSnapshotGamepad();
 }
 
 DisplayOptions GPGFX_UI::getDisplayOptions() {
@@ -36,7 +36,7 @@ void GPButton::draw() {
     int16_t setPin = -1;
     int32_t maskedPins = 0;
     bool useMask = false;
-    GamepadButtonMapping *mapMask = NULL;
+    const GamepadButtonMapping *mapMask = NULL;
     GpioMappingInfo* pinMappings = Storage::getInstance().getProfilePinMappings();
 
     if (_inputType == GP_ELEMENT_BTN_BUTTON) {
@@ -45,33 +45,33 @@ void GPButton::draw() {
         useMask = true;
 
         if ((this->_inputMask & GAMEPAD_MASK_B1) == GAMEPAD_MASK_B1) {
-            mapMask = getGamepad()->mapButtonB1;
+            mapMask = &getGamepad()->getMappings().mapButtonB1;
         } else if ((this->_inputMask & GAMEPAD_MASK_B2) == GAMEPAD_MASK_B2) {
-            mapMask = getGamepad()->mapButtonB2;
+            mapMask = &getGamepad()->getMappings().mapButtonB2;
         } else if ((this->_inputMask & GAMEPAD_MASK_B3) == GAMEPAD_MASK_B3) {
-            mapMask = getGamepad()->mapButtonB3;
+            mapMask = &getGamepad()->getMappings().mapButtonB3;
         } else if ((this->_inputMask & GAMEPAD_MASK_B4) == GAMEPAD_MASK_B4) {
-            mapMask = getGamepad()->mapButtonB4;
+            mapMask = &getGamepad()->getMappings().mapButtonB4;
         } else if ((this->_inputMask & GAMEPAD_MASK_L1) == GAMEPAD_MASK_L1) {
-            mapMask = getGamepad()->mapButtonL1;
+            mapMask = &getGamepad()->getMappings().mapButtonL1;
         } else if ((this->_inputMask & GAMEPAD_MASK_R1) == GAMEPAD_MASK_R1) {
-            mapMask = getGamepad()->mapButtonR1;
+            mapMask = &getGamepad()->getMappings().mapButtonR1;
         } else if ((this->_inputMask & GAMEPAD_MASK_L2) == GAMEPAD_MASK_L2) {
-            mapMask = getGamepad()->mapButtonL2;
+            mapMask = &getGamepad()->getMappings().mapButtonL2;
         } else if ((this->_inputMask & GAMEPAD_MASK_R2) == GAMEPAD_MASK_R2) {
-            mapMask = getGamepad()->mapButtonR2;
+            mapMask = &getGamepad()->getMappings().mapButtonR2;
         } else if ((this->_inputMask & GAMEPAD_MASK_S1) == GAMEPAD_MASK_S1) {
-            mapMask = getGamepad()->mapButtonS1;
+            mapMask = &getGamepad()->getMappings().mapButtonS1;
         } else if ((this->_inputMask & GAMEPAD_MASK_S2) == GAMEPAD_MASK_S2) {
-            mapMask = getGamepad()->mapButtonS2;
+            mapMask = &getGamepad()->getMappings().mapButtonS2;
         } else if ((this->_inputMask & GAMEPAD_MASK_L3) == GAMEPAD_MASK_L3) {
-            mapMask = getGamepad()->mapButtonL3;
+            mapMask = &getGamepad()->getMappings().mapButtonL3;
         } else if ((this->_inputMask & GAMEPAD_MASK_R3) == GAMEPAD_MASK_R3) {
-            mapMask = getGamepad()->mapButtonR3;
+            mapMask = &getGamepad()->getMappings().mapButtonR3;
         } else if ((this->_inputMask & GAMEPAD_MASK_A1) == GAMEPAD_MASK_A1) {
-            mapMask = getGamepad()->mapButtonA1;
+            mapMask = &getGamepad()->getMappings().mapButtonA1;
         } else if ((this->_inputMask & GAMEPAD_MASK_A2) == GAMEPAD_MASK_A2) {
-            mapMask = getGamepad()->mapButtonA2;
+            mapMask = &getGamepad()->getMappings().mapButtonA2;
         }
         turboState = (getGamepad()->turboState.buttons & this->_inputMask);
     } else if (_inputType == GP_ELEMENT_DIR_BUTTON) {
@@ -80,13 +80,13 @@ void GPButton::draw() {
         useMask = true;
 
         if ((this->_inputMask & GAMEPAD_MASK_UP) == GAMEPAD_MASK_UP) {
-            mapMask = getGamepad()->mapDpadUp;
+            mapMask = &getGamepad()->getMappings().mapDpadUp;
         } else if ((this->_inputMask & GAMEPAD_MASK_DOWN) == GAMEPAD_MASK_DOWN) {
-            mapMask = getGamepad()->mapDpadDown;
+            mapMask = &getGamepad()->getMappings().mapDpadDown;
         } else if ((this->_inputMask & GAMEPAD_MASK_LEFT) == GAMEPAD_MASK_LEFT) {
-            mapMask = getGamepad()->mapDpadLeft;
+            mapMask = &getGamepad()->getMappings().mapDpadLeft;
         } else if ((this->_inputMask & GAMEPAD_MASK_RIGHT) == GAMEPAD_MASK_RIGHT) {
-            mapMask = getGamepad()->mapDpadRight;
+            mapMask = &getGamepad()->getMappings().mapDpadRight;
         }
     } else if (_inputType == GP_ELEMENT_PIN_BUTTON) {
         // physical pin
@@ -15,9 +15,9 @@ void ButtonLayoutScreen::init() {
     gamepad = Storage::getInstance().GetGamepad();
     inputMode = DriverManager::getInstance().getInputMode();
 
-    EventManager::getInstance().registerEventHandler(GP_EVENT_PROFILE_CHANGE, GPEVENT_CALLBACK(this->handleProfileChange(event)));
-    EventManager::getInstance().registerEventHandler(GP_EVENT_USBHOST_MOUNT, GPEVENT_CALLBACK(this->handleUSB(event)));
-    EventManager::getInstance().registerEventHandler(GP_EVENT_USBHOST_UNMOUNT, GPEVENT_CALLBACK(this->handleUSB(event)));
+    EventManager::getInstance().registerEventHandler(GP_EVENT_PROFILE_CHANGE, GPEVENT_CALLBACK(ButtonLayoutScreen, handleProfileChange), this);
+    EventManager::getInstance().registerEventHandler(GP_EVENT_USBHOST_MOUNT, GPEVENT_CALLBACK(ButtonLayoutScreen, handleUSB), this);
+    EventManager::getInstance().registerEventHandler(GP_EVENT_USBHOST_UNMOUNT, GPEVENT_CALLBACK(ButtonLayoutScreen, handleUSB), this);
     
     footer = "";
     historyString = "";
@@ -87,9 +87,9 @@ void ButtonLayoutScreen::init() {
 void ButtonLayoutScreen::shutdown() {
     clearElements();
 
-    EventManager::getInstance().unregisterEventHandler(GP_EVENT_PROFILE_CHANGE, GPEVENT_CALLBACK(this->handleProfileChange(event)));
-    EventManager::getInstance().unregisterEventHandler(GP_EVENT_USBHOST_MOUNT, GPEVENT_CALLBACK(this->handleUSB(event)));
-    EventManager::getInstance().unregisterEventHandler(GP_EVENT_USBHOST_UNMOUNT, GPEVENT_CALLBACK(this->handleUSB(event)));
+    EventManager::getInstance().unregisterEventHandler(GP_EVENT_PROFILE_CHANGE, GPEVENT_CALLBACK(ButtonLayoutScreen, handleProfileChange), this);
+    EventManager::getInstance().unregisterEventHandler(GP_EVENT_USBHOST_MOUNT, GPEVENT_CALLBACK(ButtonLayoutScreen, handleUSB), this);
+    EventManager::getInstance().unregisterEventHandler(GP_EVENT_USBHOST_UNMOUNT, GPEVENT_CALLBACK(ButtonLayoutScreen, handleUSB), this);
 }
 
 int8_t ButtonLayoutScreen::update() {
@@ -543,15 +543,15 @@ bool ButtonLayoutScreen::pressedDownRight()
     return false;
 }
 
-void ButtonLayoutScreen::handleProfileChange(GPEvent* e) {
-    GPProfileChangeEvent* event = (GPProfileChangeEvent*)e;
+void ButtonLayoutScreen::handleProfileChange(const GPEvent* e) {
+    const GPProfileChangeEvent* event = (const GPProfileChangeEvent*)e;
 
     profileNumber = event->currentValue;
     prevProfileNumber = event->previousValue;
 }
 
-void ButtonLayoutScreen::handleUSB(GPEvent* e) {
-    GPUSBHostEvent* event = (GPUSBHostEvent*)e;
+void ButtonLayoutScreen::handleUSB(const GPEvent* e) {
+    const GPUSBHostEvent* event = (const GPUSBHostEvent*)e;
     bannerDelayStart = getMillis();
     prevProfileNumber = profileNumber;
 
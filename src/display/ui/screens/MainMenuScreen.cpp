@@ -411,7 +411,7 @@ void MainMenuScreen::saveOptions() {
         }
 
         if (saveHasChanged) {
-            EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true, changeRequiresReboot));
+            EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true, changeRequiresReboot));
         }
         changeRequiresSave = false;
         changeRequiresReboot = false;
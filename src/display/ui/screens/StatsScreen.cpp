@@ -3,6 +3,10 @@
 #include "pico/stdlib.h"
 #include "version.h"
 #include "drivermanager.h"
+#include "loopstats.h"
+
+#define LOOP_STATS_ROWS_PER_PAGE 6
+#define LOOP_STATS_PAGES ((LOOP_PHASE_COUNT + LOOP_STATS_ROWS_PER_PAGE - 1) / LOOP_STATS_ROWS_PER_PAGE)
 
 void StatsScreen::init() {
     getRenderer()->clearScreen();
@@ -55,6 +59,30 @@ void StatsScreen::shutdown() {
 }
 
 void StatsScreen::drawScreen() {
+    if (page > 0) {
+        drawLoopStats();
+    }
+}
+
+void StatsScreen::drawLoopStats() {
+    char line[32];
+    LoopPhaseSummary summary;
+
+    getRenderer()->drawText(0, 0, "[Loop us]    avg  p99");
+
+    uint8_t firstPhase = (page - 1) * LOOP_STATS_ROWS_PER_PAGE;
+    for (uint8_t row = 0; row < LOOP_STATS_ROWS_PER_PAGE; row++) {
+        uint8_t phase = firstPhase + row;
+        if (phase >= LOOP_PHASE_COUNT)
+            break;
+
+        LoopStats::getSummary((LoopPhase)phase, summary);
+        snprintf(line, sizeof(line), "%-11.11s%5lu%5lu", LoopStats::getPhaseName((LoopPhase)phase),
+            (unsigned long)(summary.avgNs / 1000), (unsigned long)(summary.p99Ns / 1000));
+        getRenderer()->drawText(0, row + 1, line);
+    }
+
+    getRenderer()->drawText(0, 7, "B1 Next   B2 Return");
 }
 
 int8_t StatsScreen::update() {
@@ -65,6 +93,16 @@ int8_t StatsScreen::update() {
                 prevButtonState = 0;
                 return DisplayMode::CONFIG_INSTRUCTION;
             }
+#if GP2040_LOOP_STATS
+            if (prevButtonState == GAMEPAD_MASK_B1) {
+                page = (page + 1) % (LOOP_STATS_PAGES + 1);
+                if (page == 0) {
+                    init();
+                } else if (page == 1) {
+                    clearElements();
+                }
+            }
+#endif
         }
         prevButtonState = buttonState;
     }
@@ -24,7 +24,7 @@ void KeyboardDriver::initialize() {
 	};
 
     // Handle Volume for Rotary Encoder
-    EventManager::getInstance().registerEventHandler(GP_EVENT_ENCODER_CHANGE, GPEVENT_CALLBACK(this->handleEncoder(event)));
+    EventManager::getInstance().registerEventHandler(GP_EVENT_ENCODER_CHANGE, GPEVENT_CALLBACK(KeyboardDriver, handleEncoder), this);
     volumeChange = 0; // no change
 }
 
@@ -197,8 +197,8 @@ uint16_t KeyboardDriver::GetJoystickMidValue() {
 	return HID_JOYSTICK_MID << 8;
 }
 
-void KeyboardDriver::handleEncoder(GPEvent* e) {
-    GPEncoderChangeEvent * encoderEvent = (GPEncoderChangeEvent*)e;
+void KeyboardDriver::handleEncoder(const GPEvent* e) {
+    const GPEncoderChangeEvent * encoderEvent = (const GPEncoderChangeEvent*)e;
     if ( encoderEvent->direction == 1 ) {
         // volume up
         volumeChange++;
@@ -2,51 +2,182 @@
 #include "storagemanager.h"
 #include "enums.pb.h"
 
+#include "pico/platform.h"
+#include "pico/time.h"
+#include "hardware/sync.h"
+
+bool EventQueue::push(const GPEvent& event) {
+    uint32_t currHead = head;
+    if ((currHead - tail) >= EVENTMGR_QUEUE_SIZE) {
+        dropped++;
+        return false;
+    }
+
+    event.copyTo(slots[currHead % EVENTMGR_QUEUE_SIZE].data);
+
+    // the event must be visible to the consumer before the slot is
+    __dmb();
+    head = currHead + 1;
+    return true;
+}
+
+const GPEvent* EventQueue::peek() {
+    uint32_t currTail = tail;
+    if (currTail == head) {
+        return nullptr;
+    }
+
+    __dmb();
+    return reinterpret_cast<const GPEvent*>(slots[currTail % EVENTMGR_QUEUE_SIZE].data);
+}
+
+void EventQueue::pop() {
+    uint32_t currTail = tail;
+    const GPEvent* event = reinterpret_cast<const GPEvent*>(slots[currTail % EVENTMGR_QUEUE_SIZE].data);
+    event->~GPEvent();
+
+    // finish with the slot before handing it back to the producer
+    __dmb();
+    tail = currTail + 1;
+}
+
+EventManager::EventManager() {
+    handlerLock = spin_lock_instance(next_striped_spin_lock_num());
+}
+
 void EventManager::init() {
     clearEventHandlers();
 }
 
-void EventManager::registerEventHandler(GPEventType eventType, EventFunction handler) {
-    typename std::vector<EventEntry>::iterator it = std::find_if(eventList.begin(), eventList.end(), [&eventType](const EventEntry& entry) { return entry.first == eventType; });
+bool EventManager::registerEventHandler(GPEventType eventType, EventFunction function, void* context) {
+    if (eventType >= EVENTMGR_NUM_EVENT_TYPES) return false;
 
-    if (it != eventList.end()) {
-        // If the event already exists, add the handler to its vector
-        it->second.push_back(handler);
-    } else {
-        // If the event does not exist, create a new entry with the handler
-        eventList.emplace_back(eventType, std::vector<EventFunction>{handler});
+    EventHandlerList& list = eventHandlers[eventType];
+    uint32_t save = spin_lock_blocking(handlerLock);
+
+    uint8_t count = list.count;
+    uint8_t slot = 0;
+    while (slot < count && list.handlers[slot].function != nullptr) {
+        slot++;
+    }
+    if (slot >= EVENTMGR_MAX_HANDLERS) {
+        spin_unlock(handlerLock, save);
+        return false;
     }
+
+    // the other core may be dispatching, publish the context and core before the function
+    EventHandler& handler = list.handlers[slot];
+    handler.context = context;
+    handler.core = get_core_num();
+    __dmb();
+    handler.function = function;
+    if (slot == count) {
+        __dmb();
+        list.count = count + 1;
+    }
+
+    spin_unlock(handlerLock, save);
+    return true;
 }
 
-void EventManager::unregisterEventHandler(GPEventType eventType, EventFunction handler) {
-    typename std::vector<EventEntry>::iterator it = std::find_if(eventList.begin(), eventList.end(), [&eventType](const EventEntry& entry) { return entry.first == eventType; });
+void EventManager::unregisterEventHandler(GPEventType eventType, EventFunction function, void* context) {
+    if (eventType >= EVENTMGR_NUM_EVENT_TYPES) return;
+
+    EventHandlerList& list = eventHandlers[eventType];
+    uint32_t save = spin_lock_blocking(handlerLock);
 
-    // Verify we have this event in our pair list
-    if (it != eventList.end()) {
-        // Verify we have this function in our function vector
-        for(std::vector<EventFunction>::iterator funcIt = it->second.begin(); funcIt != it->second.end(); it++){
-            if(*(uint32_t *)(uint8_t *)&handler == *(uint32_t *)(uint8_t *)&(*funcIt)) {
-                it->second.erase(funcIt);
-                break;
+    uint8_t count = list.count;
+    for (uint8_t i = 0; i < count; i++) {
+        if (list.handlers[i].function == function && list.handlers[i].context == context) {
+            // free the slot in place, a dispatch already past it is unaffected and one that
+            // hasn't reached it skips it
+            list.handlers[i].function = nullptr;
+            while (count > 0 && list.handlers[count - 1].function == nullptr) {
+                count--;
             }
+            list.count = count;
+            break;
         }
     }
+
+    spin_unlock(handlerLock, save);
 }
 
-void EventManager::triggerEvent(GPEvent* event) {
-    GPEventType eventType = event->eventType();
-    for (typename std::vector<EventEntry>::const_iterator it = eventList.begin(); it != eventList.end(); ++it) {
-        if (it->first == eventType) {
-            // Call all event handlers for the specified event
-            const std::vector<EventFunction>& handlers = it->second;
-            for (typename std::vector<EventFunction>::const_iterator handler = handlers.begin(); handler != handlers.end(); ++handler) {
-                (*handler)(event);
-            }
+void EventManager::triggerEvent(const GPEvent& event) {
+    uint8_t core = get_core_num();
+    bool otherCore = false;
+
+    dispatchEvent(event, core, otherCore);
+
+    // hand off to the other core rather than running its handlers on our time
+    if (otherCore) {
+        eventQueues[core ^ 1].push(event);
+    }
+}
+
+void EventManager::processEvents() {
+    uint8_t core = get_core_num();
+    bool otherCore = false; // unused, queued events are only ever for this core
+
+    while (const GPEvent* event = eventQueues[core].peek()) {
+        dispatchEvent(*event, core, otherCore);
+        eventQueues[core].pop();
+    }
+}
+
+void EventManager::dispatchEvent(const GPEvent& event, uint8_t core, bool& otherCore) {
+    GPEventType eventType = event.eventType();
+    if (eventType >= EVENTMGR_NUM_EVENT_TYPES) return;
+
+    const EventHandlerList& list = eventHandlers[eventType];
+    uint8_t count = list.count;
+    __dmb();
+
+    // Call all event handlers for the specified event that belong to this core. The other core
+    // only ever changes its own handlers, and publishes a handler's context and core before its
+    // function.
+    for (uint8_t i = 0; i < count; i++) {
+        EventFunction function = list.handlers[i].function;
+        if (function == nullptr) {
+            continue;
         }
+        __dmb();
+        if (list.handlers[i].core != core) {
+            otherCore = true;
+            continue;
+        }
+        function(list.handlers[i].context, &event);
     }
-    delete event;
 }
 
 void EventManager::clearEventHandlers() {
+    for (uint8_t eventType = 0; eventType < EVENTMGR_NUM_EVENT_TYPES; eventType++) {
+        eventHandlers[eventType].count = 0;
+    }
+}
+
+static void benchmarkHandler(void* context, const GPEvent* event) {
+    (*(volatile uint32_t*)context)++;
+}
+
+uint32_t EventManager::benchmarkDispatch(uint8_t subscribers, uint32_t iterations) {
+    // GP_EVENT_BASE is never raised by the firmware, so nothing else is listening
+    volatile uint32_t calls = 0;
+    uint8_t registered = 0;
+    while (registered < subscribers && registerEventHandler(GP_EVENT_BASE, benchmarkHandler, (void*)&calls)) {
+        registered++;
+    }
+
+    GPEvent event;
+    uint64_t start = time_us_64();
+    for (uint32_t i = 0; i < iterations; i++) {
+        triggerEvent(event);
+    }
+    uint64_t elapsed = time_us_64() - start;
+
+    for (uint8_t i = 0; i < registered; i++) {
+        unregisterEventHandler(GP_EVENT_BASE, benchmarkHandler, (void*)&calls);
+    }
 
+    return (iterations > 0) ? (uint32_t)((elapsed * 1000) / iterations) : 0;
 }
@@ -31,250 +31,268 @@ Gamepad::Gamepad() :
 {
 }
 
+/**
+ * @brief Compile the pin masks and input tables of every enabled profile, so switching profiles is
+ * only a pointer swap.
+ */
 void Gamepad::setup()
 {
-	// Configure pin mapping
-	GpioMappingInfo* pinMappings = Storage::getInstance().getProfilePinMappings();
-
-	mapDpadUp       = new GamepadButtonMapping(GAMEPAD_MASK_UP);
-	mapDpadDown     = new GamepadButtonMapping(GAMEPAD_MASK_DOWN);
-	mapDpadLeft     = new GamepadButtonMapping(GAMEPAD_MASK_LEFT);
-	mapDpadRight    = new GamepadButtonMapping(GAMEPAD_MASK_RIGHT);
-	mapButtonB1     = new GamepadButtonMapping(GAMEPAD_MASK_B1);
-	mapButtonB2     = new GamepadButtonMapping(GAMEPAD_MASK_B2);
-	mapButtonB3     = new GamepadButtonMapping(GAMEPAD_MASK_B3);
-	mapButtonB4     = new GamepadButtonMapping(GAMEPAD_MASK_B4);
-	mapButtonL1     = new GamepadButtonMapping(GAMEPAD_MASK_L1);
-	mapButtonR1     = new GamepadButtonMapping(GAMEPAD_MASK_R1);
-	mapButtonL2     = new GamepadButtonMapping(GAMEPAD_MASK_L2);
-	mapButtonR2     = new GamepadButtonMapping(GAMEPAD_MASK_R2);
-	mapButtonS1     = new GamepadButtonMapping(GAMEPAD_MASK_S1);
-	mapButtonS2     = new GamepadButtonMapping(GAMEPAD_MASK_S2);
-	mapButtonL3     = new GamepadButtonMapping(GAMEPAD_MASK_L3);
-	mapButtonR3     = new GamepadButtonMapping(GAMEPAD_MASK_R3);
-	mapButtonA1     = new GamepadButtonMapping(GAMEPAD_MASK_A1);
-	mapButtonA2     = new GamepadButtonMapping(GAMEPAD_MASK_A2);
-	mapButtonA3     = new GamepadButtonMapping(GAMEPAD_MASK_A3);
-	mapButtonA4     = new GamepadButtonMapping(GAMEPAD_MASK_A4);
-	mapButtonE1     = new GamepadButtonMapping(GAMEPAD_MASK_E1);
-	mapButtonE2     = new GamepadButtonMapping(GAMEPAD_MASK_E2);
-	mapButtonE3     = new GamepadButtonMapping(GAMEPAD_MASK_E3);
-	mapButtonE4     = new GamepadButtonMapping(GAMEPAD_MASK_E4);
-	mapButtonE5     = new GamepadButtonMapping(GAMEPAD_MASK_E5);
-	mapButtonE6     = new GamepadButtonMapping(GAMEPAD_MASK_E6);
-	mapButtonE7     = new GamepadButtonMapping(GAMEPAD_MASK_E7);
-	mapButtonE8     = new GamepadButtonMapping(GAMEPAD_MASK_E8);
-	mapButtonE9     = new GamepadButtonMapping(GAMEPAD_MASK_E9);
-	mapButtonE10    = new GamepadButtonMapping(GAMEPAD_MASK_E10);
-	mapButtonE11    = new GamepadButtonMapping(GAMEPAD_MASK_E11);
-	mapButtonE12    = new GamepadButtonMapping(GAMEPAD_MASK_E12);
-	mapButtonFn     = new GamepadButtonMapping(AUX_MASK_FUNCTION);
-	mapButtonDP     = new GamepadButtonMapping(SUSTAIN_DP_MODE_DP);
-	mapButtonLS     = new GamepadButtonMapping(SUSTAIN_DP_MODE_LS);
-	mapButtonRS     = new GamepadButtonMapping(SUSTAIN_DP_MODE_RS);
-	mapDigitalUp    = new GamepadButtonMapping(GAMEPAD_MASK_UP);
-	mapDigitalDown  = new GamepadButtonMapping(GAMEPAD_MASK_DOWN);
-	mapDigitalLeft  = new GamepadButtonMapping(GAMEPAD_MASK_LEFT);
-	mapDigitalRight = new GamepadButtonMapping(GAMEPAD_MASK_RIGHT);
-	mapAnalogLSXNeg = new GamepadButtonMapping(ANALOG_DIRECTION_LS_X_NEG);
-	mapAnalogLSXPos = new GamepadButtonMapping(ANALOG_DIRECTION_LS_X_POS);
-	mapAnalogLSYNeg = new GamepadButtonMapping(ANALOG_DIRECTION_LS_Y_NEG);
-	mapAnalogLSYPos = new GamepadButtonMapping(ANALOG_DIRECTION_LS_Y_POS);
-	mapAnalogRSXNeg = new GamepadButtonMapping(ANALOG_DIRECTION_RS_X_NEG);
-	mapAnalogRSXPos = new GamepadButtonMapping(ANALOG_DIRECTION_RS_X_POS);
-	mapAnalogRSYNeg = new GamepadButtonMapping(ANALOG_DIRECTION_RS_Y_NEG);
-	mapAnalogRSYPos = new GamepadButtonMapping(ANALOG_DIRECTION_RS_Y_POS);
-	map48WayMode    = new GamepadButtonMapping(SUSTAIN_4_8_WAY_MODE);
-	mapFocusMode    = new GamepadButtonMapping(SUSTAIN_FOCUS_MODE);
+	GpioMappingInfo pinMappings[NUM_BANK0_GPIOS];
+	for (uint8_t index = 0; index < GAMEPAD_MAX_PROFILES; index++) {
+		const uint32_t profileNumber = index + 1;
+		if (!Storage::getInstance().isProfileEnabled(profileNumber))
+			continue;
+
+		Storage::getInstance().getProfilePinMappings(profileNumber, pinMappings);
+		delete profiles[index];
+		profiles[index] = new GamepadProfile();
+		assignButtonMappings(pinMappings, *profiles[index]);
+		buildDecoder(*profiles[index]);
+	}
+
+	// Compile our hotkeys, in order
+	hotkeys.clear();
+	hotkeys.add(hotkeyOptions.hotkey01);
+	hotkeys.add(hotkeyOptions.hotkey02);
+	hotkeys.add(hotkeyOptions.hotkey03);
+	hotkeys.add(hotkeyOptions.hotkey04);
+	hotkeys.add(hotkeyOptions.hotkey05);
+	hotkeys.add(hotkeyOptions.hotkey06);
+	hotkeys.add(hotkeyOptions.hotkey07);
+	hotkeys.add(hotkeyOptions.hotkey08);
+	hotkeys.add(hotkeyOptions.hotkey09);
+	hotkeys.add(hotkeyOptions.hotkey10);
+	hotkeys.add(hotkeyOptions.hotkey11);
+	hotkeys.add(hotkeyOptions.hotkey12);
+	hotkeys.add(hotkeyOptions.hotkey13);
+	hotkeys.add(hotkeyOptions.hotkey14);
+	hotkeys.add(hotkeyOptions.hotkey15);
+	hotkeys.add(hotkeyOptions.hotkey16);
+	hotkeys.add(hotkeyOptions.hotkey17);
+	hotkeys.add(hotkeyOptions.hotkey18);
+	hotkeys.add(hotkeyOptions.hotkey19);
+	hotkeys.add(hotkeyOptions.hotkey20);
+	hotkeys.add(hotkeyOptions.hotkey21);
+	hotkeys.add(hotkeyOptions.hotkey22);
+	hotkeys.add(hotkeyOptions.hotkey23);
+	hotkeys.add(hotkeyOptions.hotkey24);
+	hotkeyInputsValid = false;
+	matchedHotkeys = 0;
+
+	reinit();
+}
+
+/**
+ * @brief Switch to the current profile's pin masks and tables. Disabled profiles use the core
+ * mappings, as in Storage.
+ */
+void Gamepad::reinit()
+{
+	profile = getProfile(options.profileNumber);
+}
+
+const GamepadProfile* Gamepad::getProfile(uint32_t profileNumber) const
+{
+	uint32_t index = profileNumber - 1;
+	if (index >= GAMEPAD_MAX_PROFILES || profiles[index] == nullptr)
+		index = 0;
+	return profiles[index];
+}
+
+/**
+ * @brief Add-ons that read their own pins from the profile only have anything to redo on a
+ * switch when this is false.
+ */
+bool Gamepad::sharesAddonPins(uint32_t profileNumber, uint32_t otherProfileNumber) const
+{
+	const GamepadProfile* first = getProfile(profileNumber);
+	const GamepadProfile* second = getProfile(otherProfileNumber);
+	return first == second || memcmp(first->addonActions, second->addonActions, sizeof(first->addonActions)) == 0;
+}
+
+/**
+ * @brief Fill in a profile's pin masks from its pin mappings, and the actions of the pins left to add-ons.
+ */
+void Gamepad::assignButtonMappings(const GpioMappingInfo* pinMappings, GamepadProfile& target)
+{
+	GamepadMappings& mappings = target.mappings;
 
 	const auto assignCustomMappingToMaps = [&](GpioMappingInfo mapInfo, Pin_t pin) -> void {
-		if (mapDpadUp->buttonMask & mapInfo.customDpadMask)	mapDpadUp->pinMask |= 1 << pin;
-		if (mapDpadDown->buttonMask & mapInfo.customDpadMask)	mapDpadDown->pinMask |= 1 << pin;
-		if (mapDpadLeft->buttonMask & mapInfo.customDpadMask)	mapDpadLeft->pinMask |= 1 << pin;
-		if (mapDpadRight->buttonMask & mapInfo.customDpadMask)	mapDpadRight->pinMask |= 1 << pin;
-		if (mapButtonB1->buttonMask & mapInfo.customButtonMask)	mapButtonB1->pinMask |= 1 << pin;
-		if (mapButtonB2->buttonMask & mapInfo.customButtonMask)	mapButtonB2->pinMask |= 1 << pin;
-		if (mapButtonB3->buttonMask & mapInfo.customButtonMask)	mapButtonB3->pinMask |= 1 << pin;
-		if (mapButtonB4->buttonMask & mapInfo.customButtonMask)	mapButtonB4->pinMask |= 1 << pin;
-		if (mapButtonL1->buttonMask & mapInfo.customButtonMask)	mapButtonL1->pinMask |= 1 << pin;
-		if (mapButtonR1->buttonMask & mapInfo.customButtonMask)	mapButtonR1->pinMask |= 1 << pin;
-		if (mapButtonL2->buttonMask & mapInfo.customButtonMask)	mapButtonL2->pinMask |= 1 << pin;
-		if (mapButtonR2->buttonMask & mapInfo.customButtonMask)	mapButtonR2->pinMask |= 1 << pin;
-		if (mapButtonS1->buttonMask & mapInfo.customButtonMask)	mapButtonS1->pinMask |= 1 << pin;
-		if (mapButtonS2->buttonMask & mapInfo.customButtonMask)	mapButtonS2->pinMask |= 1 << pin;
-		if (mapButtonL3->buttonMask & mapInfo.customButtonMask)	mapButtonL3->pinMask |= 1 << pin;
-		if (mapButtonR3->buttonMask & mapInfo.customButtonMask)	mapButtonR3->pinMask |= 1 << pin;
-		if (mapButtonA1->buttonMask & mapInfo.customButtonMask)	mapButtonA1->pinMask |= 1 << pin;
-		if (mapButtonA2->buttonMask & mapInfo.customButtonMask)	mapButtonA2->pinMask |= 1 << pin;
-		if (mapDigitalUp->buttonMask & mapInfo.customDpadMask)	mapDigitalUp->pinMask |= 1 << pin;
-		if (mapDigitalDown->buttonMask & mapInfo.customDpadMask)	mapDigitalDown->pinMask |= 1 << pin;
-		if (mapDigitalLeft->buttonMask & mapInfo.customDpadMask)	mapDigitalLeft->pinMask |= 1 << pin;
-		if (mapDigitalRight->buttonMask & mapInfo.customDpadMask)	mapDigitalRight->pinMask |= 1 << pin;
+		if (mappings.mapDpadUp.buttonMask & mapInfo.customDpadMask)	mappings.mapDpadUp.pinMask |= 1 << pin;
+		if (mappings.mapDpadDown.buttonMask & mapInfo.customDpadMask)	mappings.mapDpadDown.pinMask |= 1 << pin;
+		if (mappings.mapDpadLeft.buttonMask & mapInfo.customDpadMask)	mappings.mapDpadLeft.pinMask |= 1 << pin;
+		if (mappings.mapDpadRight.buttonMask & mapInfo.customDpadMask)	mappings.mapDpadRight.pinMask |= 1 << pin;
+		if (mappings.mapButtonB1.buttonMask & mapInfo.customButtonMask)	mappings.mapButtonB1.pinMask |= 1 << pin;
+		if (mappings.mapButtonB2.buttonMask & mapInfo.customButtonMask)	mappings.mapButtonB2.pinMask |= 1 << pin;
+		if (mappings.mapButtonB3.buttonMask & mapInfo.customButtonMask)	mappings.mapButtonB3.pinMask |= 1 << pin;
+		if (mappings.mapButtonB4.buttonMask & mapInfo.customButtonMask)	mappings.mapButtonB4.pinMask |= 1 << pin;
+		if (mappings.mapButtonL1.buttonMask & mapInfo.customButtonMask)	mappings.mapButtonL1.pinMask |= 1 << pin;
+		if (mappings.mapButtonR1.buttonMask & mapInfo.customButtonMask)	mappings.mapButtonR1.pinMask |= 1 << pin;
+		if (mappings.mapButtonL2.buttonMask & mapInfo.customButtonMask)	mappings.mapButtonL2.pinMask |= 1 << pin;
+		if (mappings.mapButtonR2.buttonMask & mapInfo.customButtonMask)	mappings.mapButtonR2.pinMask |= 1 << pin;
+		if (mappings.mapButtonS1.buttonMask & mapInfo.customButtonMask)	mappings.mapButtonS1.pinMask |= 1 << pin;
+		if (mappings.mapButtonS2.buttonMask & mapInfo.customButtonMask)	mappings.mapButtonS2.pinMask |= 1 << pin;
+		if (mappings.mapButtonL3.buttonMask & mapInfo.customButtonMask)	mappings.mapButtonL3.pinMask |= 1 << pin;
+		if (mappings.mapButtonR3.buttonMask & mapInfo.customButtonMask)	mappings.mapButtonR3.pinMask |= 1 << pin;
+		if (mappings.mapButtonA1.buttonMask & mapInfo.customButtonMask)	mappings.mapButtonA1.pinMask |= 1 << pin;
+		if (mappings.mapButtonA2.buttonMask & mapInfo.customButtonMask)	mappings.mapButtonA2.pinMask |= 1 << pin;
+		if (mappings.mapDigitalUp.buttonMask & mapInfo.customDpadMask)	mappings.mapDigitalUp.pinMask |= 1 << pin;
+		if (mappings.mapDigitalDown.buttonMask & mapInfo.customDpadMask)	mappings.mapDigitalDown.pinMask |= 1 << pin;
+		if (mappings.mapDigitalLeft.buttonMask & mapInfo.customDpadMask)	mappings.mapDigitalLeft.pinMask |= 1 << pin;
+		if (mappings.mapDigitalRight.buttonMask & mapInfo.customDpadMask)	mappings.mapDigitalRight.pinMask |= 1 << pin;
 	};
 
 	for (Pin_t pin = 0; pin < (Pin_t)NUM_BANK0_GPIOS; pin++)
 	{
+		target.addonActions[pin] = GpioAction::NONE;
 		switch (pinMappings[pin].action) {
-			case GpioAction::BUTTON_PRESS_UP:	mapDpadUp->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_DOWN:	mapDpadDown->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_LEFT:	mapDpadLeft->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_RIGHT:	mapDpadRight->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_B1:	mapButtonB1->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_B2:	mapButtonB2->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_B3:	mapButtonB3->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_B4:	mapButtonB4->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_L1:	mapButtonL1->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_R1:	mapButtonR1->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_L2:	mapButtonL2->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_R2:	mapButtonR2->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_S1:	mapButtonS1->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_S2:	mapButtonS2->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_L3:	mapButtonL3->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_R3:	mapButtonR3->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_A1:	mapButtonA1->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_A2:	mapButtonA2->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_A3:	mapButtonA3->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_A4:	mapButtonA4->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_E1:	mapButtonE1->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_E2:	mapButtonE2->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_E3:	mapButtonE3->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_E4:	mapButtonE4->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_E5:	mapButtonE5->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_E6:	mapButtonE6->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_E7:	mapButtonE7->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_E8:	mapButtonE8->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_E9:	mapButtonE9->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_E10:	mapButtonE10->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_E11:	mapButtonE11->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_E12:	mapButtonE12->pinMask |= 1 << pin; break;
-			case GpioAction::BUTTON_PRESS_FN:	mapButtonFn->pinMask |= 1 << pin; break;
-			case GpioAction::SUSTAIN_DP_MODE_DP:	mapButtonDP->pinMask |= 1 << pin; break;
-			case GpioAction::SUSTAIN_DP_MODE_LS:	mapButtonLS->pinMask |= 1 << pin; break;
-			case GpioAction::SUSTAIN_DP_MODE_RS:	mapButtonRS->pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_UP:	mappings.mapDpadUp.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_DOWN:	mappings.mapDpadDown.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_LEFT:	mappings.mapDpadLeft.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_RIGHT:	mappings.mapDpadRight.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_B1:	mappings.mapButtonB1.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_B2:	mappings.mapButtonB2.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_B3:	mappings.mapButtonB3.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_B4:	mappings.mapButtonB4.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_L1:	mappings.mapButtonL1.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_R1:	mappings.mapButtonR1.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_L2:	mappings.mapButtonL2.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_R2:	mappings.mapButtonR2.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_S1:	mappings.mapButtonS1.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_S2:	mappings.mapButtonS2.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_L3:	mappings.mapButtonL3.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_R3:	mappings.mapButtonR3.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_A1:	mappings.mapButtonA1.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_A2:	mappings.mapButtonA2.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_A3:	mappings.mapButtonA3.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_A4:	mappings.mapButtonA4.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_E1:	mappings.mapButtonE1.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_E2:	mappings.mapButtonE2.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_E3:	mappings.mapButtonE3.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_E4:	mappings.mapButtonE4.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_E5:	mappings.mapButtonE5.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_E6:	mappings.mapButtonE6.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_E7:	mappings.mapButtonE7.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_E8:	mappings.mapButtonE8.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_E9:	mappings.mapButtonE9.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_E10:	mappings.mapButtonE10.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_E11:	mappings.mapButtonE11.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_E12:	mappings.mapButtonE12.pinMask |= 1 << pin; break;
+			case GpioAction::BUTTON_PRESS_FN:	mappings.mapButtonFn.pinMask |= 1 << pin; break;
+			case GpioAction::SUSTAIN_DP_MODE_DP:	mappings.mapButtonDP.pinMask |= 1 << pin; break;
+			case GpioAction::SUSTAIN_DP_MODE_LS:	mappings.mapButtonLS.pinMask |= 1 << pin; break;
+			case GpioAction::SUSTAIN_DP_MODE_RS:	mappings.mapButtonRS.pinMask |= 1 << pin; break;
 			case GpioAction::CUSTOM_BUTTON_COMBO:	assignCustomMappingToMaps(pinMappings[pin], pin); break;
-			case GpioAction::DIGITAL_DIRECTION_UP:	mapDigitalUp->pinMask |= 1 << pin; break;
-			case GpioAction::DIGITAL_DIRECTION_DOWN:	mapDigitalDown->pinMask |= 1 << pin; break;
-			case GpioAction::DIGITAL_DIRECTION_LEFT:	mapDigitalLeft->pinMask |= 1 << pin; break;
-			case GpioAction::DIGITAL_DIRECTION_RIGHT:	mapDigitalRight->pinMask |= 1 << pin; break;
-			case GpioAction::ANALOG_DIRECTION_LS_X_NEG:	mapAnalogLSXNeg->pinMask |= 1 << pin; break;
-			case GpioAction::ANALOG_DIRECTION_LS_X_POS:	mapAnalogLSXPos->pinMask |= 1 << pin; break;
-			case GpioAction::ANALOG_DIRECTION_LS_Y_NEG:	mapAnalogLSYNeg->pinMask |= 1 << pin; break;
-			case GpioAction::ANALOG_DIRECTION_LS_Y_POS:	mapAnalogLSYPos->pinMask |= 1 << pin; break;
-			case GpioAction::ANALOG_DIRECTION_RS_X_NEG:	mapAnalogRSXNeg->pinMask |= 1 << pin; break;
-			case GpioAction::ANALOG_DIRECTION_RS_X_POS:	mapAnalogRSXPos->pinMask |= 1 << pin; break;
-			case GpioAction::ANALOG_DIRECTION_RS_Y_NEG:	mapAnalogRSYNeg->pinMask |= 1 << pin; break;
-			case GpioAction::ANALOG_DIRECTION_RS_Y_POS:	mapAnalogRSYPos->pinMask |= 1 << pin; break;
-			case GpioAction::SUSTAIN_4_8_WAY_MODE:	map48WayMode->pinMask |= 1 << pin; break;
-			case GpioAction::SUSTAIN_FOCUS_MODE: mapFocusMode->pinMask |= 1 << pin; break;
-			default:				break;
+			case GpioAction::DIGITAL_DIRECTION_UP:	mappings.mapDigitalUp.pinMask |= 1 << pin; break;
+			case GpioAction::DIGITAL_DIRECTION_DOWN:	mappings.mapDigitalDown.pinMask |= 1 << pin; break;
+			case GpioAction::DIGITAL_DIRECTION_LEFT:	mappings.mapDigitalLeft.pinMask |= 1 << pin; break;
+			case GpioAction::DIGITAL_DIRECTION_RIGHT:	mappings.mapDigitalRight.pinMask |= 1 << pin; break;
+			case GpioAction::ANALOG_DIRECTION_LS_X_NEG:	mappings.mapAnalogLSXNeg.pinMask |= 1 << pin; break;
+			case GpioAction::ANALOG_DIRECTION_LS_X_POS:	mappings.mapAnalogLSXPos.pinMask |= 1 << pin; break;
+			case GpioAction::ANALOG_DIRECTION_LS_Y_NEG:	mappings.mapAnalogLSYNeg.pinMask |= 1 << pin; break;
+			case GpioAction::ANALOG_DIRECTION_LS_Y_POS:	mappings.mapAnalogLSYPos.pinMask |= 1 << pin; break;
+			case GpioAction::ANALOG_DIRECTION_RS_X_NEG:	mappings.mapAnalogRSXNeg.pinMask |= 1 << pin; break;
+			case GpioAction::ANALOG_DIRECTION_RS_X_POS:	mappings.mapAnalogRSXPos.pinMask |= 1 << pin; break;
+			case GpioAction::ANALOG_DIRECTION_RS_Y_NEG:	mappings.mapAnalogRSYNeg.pinMask |= 1 << pin; break;
+			case GpioAction::ANALOG_DIRECTION_RS_Y_POS:	mappings.mapAnalogRSYPos.pinMask |= 1 << pin; break;
+			case GpioAction::SUSTAIN_4_8_WAY_MODE:	mappings.map48WayMode.pinMask |= 1 << pin; break;
+			case GpioAction::SUSTAIN_FOCUS_MODE: mappings.mapFocusMode.pinMask |= 1 << pin; break;
+			default:				target.addonActions[pin] = pinMappings[pin].action; break;
 		}
 	}
-
-	// Define our hotkey array
-	hotkeys[0] = hotkeyOptions.hotkey01;
-	hotkeys[1] = hotkeyOptions.hotkey02;
-	hotkeys[2] = hotkeyOptions.hotkey03;
-	hotkeys[3] = hotkeyOptions.hotkey04;
-	hotkeys[4] = hotkeyOptions.hotkey05;
-	hotkeys[5] = hotkeyOptions.hotkey06;
-	hotkeys[6] = hotkeyOptions.hotkey07;
-	hotkeys[7] = hotkeyOptions.hotkey08;
-	hotkeys[8] = hotkeyOptions.hotkey09;
-	hotkeys[9] = hotkeyOptions.hotkey10;
-	hotkeys[10] = hotkeyOptions.hotkey11;
-	hotkeys[11] = hotkeyOptions.hotkey12;
-	hotkeys[12] = hotkeyOptions.hotkey13;
-	hotkeys[13] = hotkeyOptions.hotkey14;
-	hotkeys[14] = hotkeyOptions.hotkey15;
-	hotkeys[15] = hotkeyOptions.hotkey16;
 }
 
 /**
- * @brief Undo setup().
+ * @brief Compile the button mapping pin masks into the decoder tables used by read().
  */
-void Gamepad::reinit()
+void Gamepad::buildDecoder(GamepadProfile& target)
 {
-	delete mapDpadUp;
-	delete mapDpadDown;
-	delete mapDpadLeft;
-	delete mapDpadRight;
-	delete mapButtonB1;
-	delete mapButtonB2;
-	delete mapButtonB3;
-	delete mapButtonB4;
-	delete mapButtonL1;
-	delete mapButtonR1;
-	delete mapButtonL2;
-	delete mapButtonR2;
-	delete mapButtonS1;
-	delete mapButtonS2;
-	delete mapButtonL3;
-	delete mapButtonR3;
-	delete mapButtonA1;
-	delete mapButtonA2;
-	delete mapButtonA3;
-	delete mapButtonA4;
-	delete mapButtonE1;
-	delete mapButtonE2;
-	delete mapButtonE3;
-	delete mapButtonE4;
-	delete mapButtonE5;
-	delete mapButtonE6;
-	delete mapButtonE7;
-	delete mapButtonE8;
-	delete mapButtonE9;
-	delete mapButtonE10;
-	delete mapButtonE11;
-	delete mapButtonE12;
-	delete mapButtonFn;
-	delete mapButtonDP;
-	delete mapButtonLS;
-	delete mapButtonRS;
-	delete mapDigitalUp;
-	delete mapDigitalDown;
-	delete mapDigitalLeft;
-	delete mapDigitalRight;
-	delete mapAnalogLSXNeg;
-	delete mapAnalogLSXPos;
-	delete mapAnalogLSYNeg;
-	delete mapAnalogLSYPos;
-	delete mapAnalogRSXNeg;
-	delete mapAnalogRSXPos;
-	delete mapAnalogRSYNeg;
-	delete mapAnalogRSYPos;
-	delete map48WayMode;
-	delete mapFocusMode;
-
-	// reinitialize pin mappings
-	this->setup();
+	const GamepadMappings& mappings = target.mappings;
+	GamepadDecoder& decoder = target.decoder;
+	decoder.clear();
+
+	decoder.addDpad(mappings.mapDpadUp.pinMask,            mappings.mapDpadUp.buttonMask);
+	decoder.addDpad(mappings.mapDpadDown.pinMask,          mappings.mapDpadDown.buttonMask);
+	decoder.addDpad(mappings.mapDpadLeft.pinMask,          mappings.mapDpadLeft.buttonMask);
+	decoder.addDpad(mappings.mapDpadRight.pinMask,         mappings.mapDpadRight.buttonMask);
+	decoder.addDpad(mappings.mapDigitalUp.pinMask,         mappings.mapDigitalUp.buttonMask << 4);
+	decoder.addDpad(mappings.mapDigitalDown.pinMask,       mappings.mapDigitalDown.buttonMask << 4);
+	decoder.addDpad(mappings.mapDigitalLeft.pinMask,       mappings.mapDigitalLeft.buttonMask << 4);
+	decoder.addDpad(mappings.mapDigitalRight.pinMask,      mappings.mapDigitalRight.buttonMask << 4);
+
+	decoder.addButtons(mappings.mapButtonB1.pinMask,       mappings.mapButtonB1.buttonMask);
+	decoder.addButtons(mappings.mapButtonB2.pinMask,       mappings.mapButtonB2.buttonMask);
+	decoder.addButtons(mappings.mapButtonB3.pinMask,       mappings.mapButtonB3.buttonMask);
+	decoder.addButtons(mappings.mapButtonB4.pinMask,       mappings.mapButtonB4.buttonMask);
+	decoder.addButtons(mappings.mapButtonL1.pinMask,       mappings.mapButtonL1.buttonMask);
+	decoder.addButtons(mappings.mapButtonR1.pinMask,       mappings.mapButtonR1.buttonMask);
+	decoder.addButtons(mappings.mapButtonL2.pinMask,       mappings.mapButtonL2.buttonMask);
+	decoder.addButtons(mappings.mapButtonR2.pinMask,       mappings.mapButtonR2.buttonMask);
+	decoder.addButtons(mappings.mapButtonS1.pinMask,       mappings.mapButtonS1.buttonMask);
+	decoder.addButtons(mappings.mapButtonS2.pinMask,       mappings.mapButtonS2.buttonMask);
+	decoder.addButtons(mappings.mapButtonL3.pinMask,       mappings.mapButtonL3.buttonMask);
+	decoder.addButtons(mappings.mapButtonR3.pinMask,       mappings.mapButtonR3.buttonMask);
+	decoder.addButtons(mappings.mapButtonA1.pinMask,       mappings.mapButtonA1.buttonMask);
+	decoder.addButtons(mappings.mapButtonA2.pinMask,       mappings.mapButtonA2.buttonMask);
+	decoder.addButtons(mappings.mapButtonA3.pinMask,       mappings.mapButtonA3.buttonMask);
+	decoder.addButtons(mappings.mapButtonA4.pinMask,       mappings.mapButtonA4.buttonMask);
+	decoder.addButtons(mappings.mapButtonE1.pinMask,       mappings.mapButtonE1.buttonMask);
+	decoder.addButtons(mappings.mapButtonE2.pinMask,       mappings.mapButtonE2.buttonMask);
+	decoder.addButtons(mappings.mapButtonE3.pinMask,       mappings.mapButtonE3.buttonMask);
+	decoder.addButtons(mappings.mapButtonE4.pinMask,       mappings.mapButtonE4.buttonMask);
+	decoder.addButtons(mappings.mapButtonE5.pinMask,       mappings.mapButtonE5.buttonMask);
+	decoder.addButtons(mappings.mapButtonE6.pinMask,       mappings.mapButtonE6.buttonMask);
+	decoder.addButtons(mappings.mapButtonE7.pinMask,       mappings.mapButtonE7.buttonMask);
+	decoder.addButtons(mappings.mapButtonE8.pinMask,       mappings.mapButtonE8.buttonMask);
+	decoder.addButtons(mappings.mapButtonE9.pinMask,       mappings.mapButtonE9.buttonMask);
+	decoder.addButtons(mappings.mapButtonE10.pinMask,      mappings.mapButtonE10.buttonMask);
+	decoder.addButtons(mappings.mapButtonE11.pinMask,      mappings.mapButtonE11.buttonMask);
+	decoder.addButtons(mappings.mapButtonE12.pinMask,      mappings.mapButtonE12.buttonMask);
+
+	decoder.addFlags(mappings.mapButtonFn.pinMask,         GAMEPAD_DECODER_FUNCTION);
+	decoder.addFlags(mappings.mapButtonDP.pinMask,         GAMEPAD_DECODER_DPAD_DP);
+	decoder.addFlags(mappings.mapButtonLS.pinMask,         GAMEPAD_DECODER_DPAD_LS);
+	decoder.addFlags(mappings.mapButtonRS.pinMask,         GAMEPAD_DECODER_DPAD_RS);
+	decoder.addFlags(mappings.map48WayMode.pinMask,        GAMEPAD_DECODER_4_8_WAY);
+
+	decoder.addAnalog(mappings.mapAnalogLSXNeg.pinMask,    GAMEPAD_DECODER_LS_X_NEG);
+	decoder.addAnalog(mappings.mapAnalogLSXPos.pinMask,    GAMEPAD_DECODER_LS_X_POS);
+	decoder.addAnalog(mappings.mapAnalogLSYNeg.pinMask,    GAMEPAD_DECODER_LS_Y_NEG);
+	decoder.addAnalog(mappings.mapAnalogLSYPos.pinMask,    GAMEPAD_DECODER_LS_Y_POS);
+	decoder.addAnalog(mappings.mapAnalogRSXNeg.pinMask,    GAMEPAD_DECODER_RS_X_NEG);
+	decoder.addAnalog(mappings.mapAnalogRSXPos.pinMask,    GAMEPAD_DECODER_RS_X_POS);
+	decoder.addAnalog(mappings.mapAnalogRSYNeg.pinMask,    GAMEPAD_DECODER_RS_Y_NEG);
+	decoder.addAnalog(mappings.mapAnalogRSYPos.pinMask,    GAMEPAD_DECODER_RS_Y_POS);
 }
 
 void Gamepad::process()
 {
+	const GamepadMappings& mappings = profile->mappings;
+
 	// NOTE: Inverted X/Y-axis must run before SOCD and Dpad processing
 	if (options.invertXAxis) {
-		bool left = (state.dpad & mapDpadLeft->buttonMask) != 0;
-		bool right = (state.dpad & mapDpadRight->buttonMask) != 0;
-		state.dpad &= ~(mapDpadLeft->buttonMask | mapDpadRight->buttonMask);
+		bool left = (state.dpad & mappings.mapDpadLeft.buttonMask) != 0;
+		bool right = (state.dpad & mappings.mapDpadRight.buttonMask) != 0;
+		state.dpad &= ~(mappings.mapDpadLeft.buttonMask | mappings.mapDpadRight.buttonMask);
 		if (left)
-			state.dpad |= mapDpadRight->buttonMask;
+			state.dpad |= mappings.mapDpadRight.buttonMask;
 		if (right)
-			state.dpad |= mapDpadLeft->buttonMask;
+			state.dpad |= mappings.mapDpadLeft.buttonMask;
 	}
 
 	if (options.invertYAxis) {
-		bool up = (state.dpad & mapDpadUp->buttonMask) != 0;
-		bool down = (state.dpad & mapDpadDown->buttonMask) != 0;
-		state.dpad &= ~(mapDpadUp->buttonMask | mapDpadDown->buttonMask);
+		bool up = (state.dpad & mappings.mapDpadUp.buttonMask) != 0;
+		bool down = (state.dpad & mappings.mapDpadDown.buttonMask) != 0;
+		state.dpad &= ~(mappings.mapDpadUp.buttonMask | mappings.mapDpadDown.buttonMask);
 		if (up)
-			state.dpad |= mapDpadDown->buttonMask;
+			state.dpad |= mappings.mapDpadDown.buttonMask;
 		if (down)
-			state.dpad |= mapDpadUp->buttonMask;
+			state.dpad |= mappings.mapDpadUp.buttonMask;
 	}
 
 	// 4-way before SOCD, might have better history without losing any coherent functionality
 	if (options.fourWayMode ^ map48WayModeToggle) {
-		state.dpad = filterToFourWayMode(state.dpad);
+		state.dpad = socdState.filterToFourWay(state.dpad);
 	}
 
 	// hold current dpad state regardless of input
@@ -296,7 +314,7 @@ void Gamepad::process()
 	}
 
 	// clean up after yourself. nobody likes bad inputs.
-	state.dpad = runSOCDCleaner(resolveSOCDMode(options), state.dpad);
+	state.dpad = socdState.clean(resolveSOCDMode(options), state.dpad);
 
 	// since analog modes only care about the dpad mode inputs, set the dpad state to digital only dpad values
 	switch (activeDpadMode)
@@ -328,84 +346,46 @@ void Gamepad::read()
 		joystickMid = DriverManager::getInstance().getDriver()->GetJoystickMidValue();
 	}
 
-	state.aux = 0
-		| (values & mapButtonFn->pinMask)   ? mapButtonFn->buttonMask : 0;
-
-	state.dpad = 0
-		| ((values & mapDpadUp->pinMask)       ? mapDpadUp->buttonMask              : 0)
-		| ((values & mapDpadDown->pinMask)     ? mapDpadDown->buttonMask            : 0)
-		| ((values & mapDpadLeft->pinMask)     ? mapDpadLeft->buttonMask            : 0)
-		| ((values & mapDpadRight->pinMask)    ? mapDpadRight->buttonMask           : 0)
-		| ((values & mapDigitalUp->pinMask)    ? (mapDigitalUp->buttonMask << 4)    : 0)
-		| ((values & mapDigitalDown->pinMask)  ? (mapDigitalDown->buttonMask << 4)  : 0)
-		| ((values & mapDigitalLeft->pinMask)  ? (mapDigitalLeft->buttonMask << 4)  : 0)
-		| ((values & mapDigitalRight->pinMask) ? (mapDigitalRight->buttonMask << 4) : 0)
-	;
-
-	state.buttons = 0
-		| ((values & mapButtonB1->pinMask)  ? mapButtonB1->buttonMask  : 0)
-		| ((values & mapButtonB2->pinMask)  ? mapButtonB2->buttonMask  : 0)
-		| ((values & mapButtonB3->pinMask)  ? mapButtonB3->buttonMask  : 0)
-		| ((values & mapButtonB4->pinMask)  ? mapButtonB4->buttonMask  : 0)
-		| ((values & mapButtonL1->pinMask)  ? mapButtonL1->buttonMask  : 0)
-		| ((values & mapButtonR1->pinMask)  ? mapButtonR1->buttonMask  : 0)
-		| ((values & mapButtonL2->pinMask)  ? mapButtonL2->buttonMask  : 0)
-		| ((values & mapButtonR2->pinMask)  ? mapButtonR2->buttonMask  : 0)
-		| ((values & mapButtonS1->pinMask)  ? mapButtonS1->buttonMask  : 0)
-		| ((values & mapButtonS2->pinMask)  ? mapButtonS2->buttonMask  : 0)
-		| ((values & mapButtonL3->pinMask)  ? mapButtonL3->buttonMask  : 0)
-		| ((values & mapButtonR3->pinMask)  ? mapButtonR3->buttonMask  : 0)
-		| ((values & mapButtonA1->pinMask)  ? mapButtonA1->buttonMask  : 0)
-		| ((values & mapButtonA2->pinMask)  ? mapButtonA2->buttonMask  : 0)
-		| ((values & mapButtonA3->pinMask)  ? mapButtonA3->buttonMask  : 0)
-		| ((values & mapButtonA4->pinMask)  ? mapButtonA4->buttonMask  : 0)
-		| ((values & mapButtonE1->pinMask)  ? mapButtonE1->buttonMask  : 0)
-		| ((values & mapButtonE2->pinMask)  ? mapButtonE2->buttonMask  : 0)
-		| ((values & mapButtonE3->pinMask)  ? mapButtonE3->buttonMask  : 0)
-		| ((values & mapButtonE4->pinMask)  ? mapButtonE4->buttonMask  : 0)
-		| ((values & mapButtonE5->pinMask)  ? mapButtonE5->buttonMask  : 0)
-		| ((values & mapButtonE6->pinMask)  ? mapButtonE6->buttonMask  : 0)
-		| ((values & mapButtonE7->pinMask)  ? mapButtonE7->buttonMask  : 0)
-		| ((values & mapButtonE8->pinMask)  ? mapButtonE8->buttonMask  : 0)
-		| ((values & mapButtonE9->pinMask)  ? mapButtonE9->buttonMask  : 0)
-		| ((values & mapButtonE10->pinMask) ? mapButtonE10->buttonMask : 0)
-		| ((values & mapButtonE11->pinMask) ? mapButtonE11->buttonMask : 0)
-		| ((values & mapButtonE12->pinMask) ? mapButtonE12->buttonMask : 0)
-	;
+	// one table lookup per GPIO slice, see Gamepad::buildDecoder
+	const GamepadDecoderEntry decoded = profile->decoder.decode(values);
+
+	state.aux = (decoded.flags & GAMEPAD_DECODER_FUNCTION) ? profile->mappings.mapButtonFn.buttonMask : 0;
+	state.dpad = decoded.dpad;
+	state.buttons = decoded.buttons;
 
 	// set the effective dpad mode based on settings + overrides
-	if (values & mapButtonDP->pinMask)	activeDpadMode = DpadMode::DPAD_MODE_DIGITAL;
-	else if (values & mapButtonLS->pinMask)	activeDpadMode = DpadMode::DPAD_MODE_LEFT_ANALOG;
-	else if (values & mapButtonRS->pinMask)	activeDpadMode = DpadMode::DPAD_MODE_RIGHT_ANALOG;
-	else					activeDpadMode = options.dpadMode;
+	if (decoded.flags & GAMEPAD_DECODER_DPAD_DP)		activeDpadMode = DpadMode::DPAD_MODE_DIGITAL;
+	else if (decoded.flags & GAMEPAD_DECODER_DPAD_LS)	activeDpadMode = DpadMode::DPAD_MODE_LEFT_ANALOG;
+	else if (decoded.flags & GAMEPAD_DECODER_DPAD_RS)	activeDpadMode = DpadMode::DPAD_MODE_RIGHT_ANALOG;
+	else							activeDpadMode = options.dpadMode;
 
-	map48WayModeToggle = (values & map48WayMode->pinMask);
+	map48WayModeToggle = (decoded.flags & GAMEPAD_DECODER_4_8_WAY);
 
-	if (values & mapAnalogLSXNeg->pinMask) {
+	if (decoded.analog & GAMEPAD_DECODER_LS_X_NEG) {
 		state.lx = GAMEPAD_JOYSTICK_MIN;
-	} else if (values & mapAnalogLSXPos->pinMask) {
+	} else if (decoded.analog & GAMEPAD_DECODER_LS_X_POS) {
 		state.lx = GAMEPAD_JOYSTICK_MAX;
 	} else {
 		state.lx = joystickMid;
 	}
-	if (values & mapAnalogLSYNeg->pinMask) {
+	if (decoded.analog & GAMEPAD_DECODER_LS_Y_NEG) {
 		state.ly = GAMEPAD_JOYSTICK_MIN;
-	} else if (values & mapAnalogLSYPos->pinMask) {
+	} else if (decoded.analog & GAMEPAD_DECODER_LS_Y_POS) {
 		state.ly = GAMEPAD_JOYSTICK_MAX;
 	} else {
 		state.ly = joystickMid;
 	}
 
-	if (values & mapAnalogRSXNeg->pinMask) {
+	if (decoded.analog & GAMEPAD_DECODER_RS_X_NEG) {
 		state.rx = GAMEPAD_JOYSTICK_MIN;
-	} else if (values & mapAnalogRSXPos->pinMask) {
+	} else if (decoded.analog & GAMEPAD_DECODER_RS_X_POS) {
 		state.rx = GAMEPAD_JOYSTICK_MAX;
 	} else {
 		state.rx = joystickMid;
 	}
-	if (values & mapAnalogRSYNeg->pinMask) {
+	if (decoded.analog & GAMEPAD_DECODER_RS_Y_NEG) {
 		state.ry = GAMEPAD_JOYSTICK_MIN;
-	} else if (values & mapAnalogRSYPos->pinMask) {
+	} else if (decoded.analog & GAMEPAD_DECODER_RS_Y_POS) {
 		state.ry = GAMEPAD_JOYSTICK_MAX;
 	} else {
 		state.ry = joystickMid;
@@ -415,19 +395,40 @@ void Gamepad::read()
 	state.rt = 0;
 }
 
+/**
+ * @brief Look for hotkeys when the inputs changed, otherwise take the actions of the ones matched last.
+ */
 void Gamepad::hotkey() {
-	if (options.lockHotkeys)
+	if (options.lockHotkeys) {
+		hotkeyInputsValid = false;
 		return;
+	}
 
-	// Look for a hot-key
-	bool hasHotkey = false;
-	for(int i = 0; i < 16; i++) {
-		if (pressedHotkey(hotkeys[i])) {
-			processHotkeyAction(selectHotkey(hotkeys[i]));
-			hasHotkey = true;
+	if (!hotkeyInputsValid || state.buttons != hotkeyButtons || state.dpad != hotkeyDpad || state.aux != hotkeyAux) {
+		hotkeyInputsValid = true;
+		hotkeyButtons = state.buttons;
+		hotkeyDpad = state.dpad;
+		hotkeyAux = state.aux;
+
+		// Look for a hot-key, each one sees the state left by the ones before it
+		matchedHotkeys = 0;
+		uint32_t candidates = hotkeys.candidates(state.aux);
+		const uint32_t nowMs = getMillis();
+		while (candidates != 0) {
+			const uint8_t index = __builtin_ctz(candidates);
+			candidates &= candidates - 1;
+			if (hotkeys.step(index, state.buttons, state.dpad, state.aux, nowMs)) {
+				matchedHotkeys |= 1U << index;
+				processHotkeyAction(selectHotkey(hotkeys.get(index)));
+			}
+		}
+	} else {
+		for (uint32_t matched = matchedHotkeys; matched != 0; matched &= matched - 1) {
+			processHotkeyAction(selectHotkey(hotkeys.get(__builtin_ctz(matched))));
 		}
 	}
-	if (hasHotkey == false ) {
+
+	if (matchedHotkeys == 0) {
 		lastAction = HOTKEY_NONE;
 	}
 }
@@ -693,37 +694,37 @@ void Gamepad::processHotkeyAction(GamepadHotkey action) {
 			break;
 		case HOTKEY_MENU_NAV_UP:
 			if (action != lastAction) {
-                EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_UP));
+                EventManager::getInstance().triggerEvent(GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_UP));
             }
 			break;
 		case HOTKEY_MENU_NAV_DOWN:
 			if (action != lastAction) {
-                EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_DOWN));
+                EventManager::getInstance().triggerEvent(GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_DOWN));
             }
 			break;
 		case HOTKEY_MENU_NAV_LEFT:
 			if (action != lastAction) {
-                EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_LEFT));
+                EventManager::getInstance().triggerEvent(GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_LEFT));
             }
 			break;
 		case HOTKEY_MENU_NAV_RIGHT:
 			if (action != lastAction) {
-                EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_RIGHT));
+                EventManager::getInstance().triggerEvent(GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_RIGHT));
             }
 			break;
 		case HOTKEY_MENU_NAV_SELECT:
 			if (action != lastAction) {
-                EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_SELECT));
+                EventManager::getInstance().triggerEvent(GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_SELECT));
             }
 			break;
 		case HOTKEY_MENU_NAV_BACK:
 			if (action != lastAction) {
-                EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_BACK));
+                EventManager::getInstance().triggerEvent(GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_BACK));
             }
 			break;
 		case HOTKEY_MENU_NAV_TOGGLE:
 			if (action != lastAction) {
-				EventManager::getInstance().triggerEvent(new GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_TOGGLE));
+				EventManager::getInstance().triggerEvent(GPMenuNavigateEvent(GpioAction::MENU_NAVIGATION_TOGGLE));
 			}
 			break;
 		case HOTKEY_FOCUS_MODE_TOGGLE:
@@ -788,7 +789,7 @@ void Gamepad::processHotkeyAction(GamepadHotkey action) {
 
 	// only save if requested
 	if (reqSave) {
-		EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+		EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
 	}
 
 	lastAction = action;
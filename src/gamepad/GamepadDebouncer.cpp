@@ -0,0 +1,195 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#include "GamepadDebouncer.h"
+
+GamepadDebouncer::GamepadDebouncer() :
+	delayMs(0),
+	mode(DEBOUNCE_MODE_LOCKOUT),
+	tickMs(1),
+	thresholdTicks(0)
+{
+	reset();
+}
+
+/**
+ * @brief Convert a delay into a tick length and count that fit the counters.
+ *
+ * A counter counts the tick boundaries since the pin's start, so with stretched ticks a pin can
+ * be counted as late as a tick after its start. One more tick than the delay needs is counted
+ * then, so that a pin is never let through early, only up to a tick late.
+ */
+void GamepadDebouncer::configure(uint32_t delayMs, DebounceMode mode)
+{
+	if (this->delayMs == delayMs && this->mode == mode)
+		return;
+
+	this->delayMs = delayMs;
+	this->mode = mode;
+
+	if (delayMs <= GAMEPAD_DEBOUNCER_MAX_TICKS) {
+		tickMs = 1;
+		thresholdTicks = delayMs;
+	} else {
+		tickMs = (delayMs - 1 + GAMEPAD_DEBOUNCER_MAX_TICKS - 2) / (GAMEPAD_DEBOUNCER_MAX_TICKS - 1);
+		thresholdTicks = (delayMs - 1 + tickMs - 1) / tickMs + 1;
+	}
+
+	reset();
+}
+
+void GamepadDebouncer::reset()
+{
+	for (uint8_t plane = 0; plane < GAMEPAD_DEBOUNCER_COUNTER_BITS; plane++)
+		counter[plane] = 0;
+	pending = 0;
+	locked = 0;
+	lastTick = 0;
+	counting = false;
+}
+
+/**
+ * @brief Every pin agrees with its debounced state, called instead of update.
+ *
+ * Countdowns are dropped, but a pin that is locked out stays locked out until its delay is over.
+ */
+void GamepadDebouncer::settle()
+{
+	pending = 0;
+	keep(locked);
+	counting = false;
+}
+
+/**
+ * @brief Debounce every pin at once.
+ *
+ * The debounce window starts at since, which is earlier than now when the caller knows when the
+ * pins actually changed. Pins that bounced since the last update start their window over from
+ * bouncedSince, their last edge, even if they were read in the same changed state both times.
+ */
+Mask_t GamepadDebouncer::update(Mask_t raw, Mask_t debounced, uint32_t now, uint32_t since, Mask_t bounced, uint32_t bouncedSince)
+{
+	if (delayMs == 0)
+		return raw;
+
+	advance(now);
+
+	if (mode == DEBOUNCE_MODE_LOCKOUT)
+		return updateLockout(raw, debounced, since);
+
+	// pass through the edges this mode doesn't delay
+	if (mode == DEBOUNCE_MODE_EAGER_PRESS)
+		debounced |= raw;
+	else if (mode == DEBOUNCE_MODE_DEFERRED_PRESS)
+		debounced &= raw;
+
+	// any pin that agrees with its debounced state stops counting, new and bounced pins start over
+	Mask_t changing = raw ^ debounced;
+	Mask_t restart = changing & ~pending & ~bounced;
+	Mask_t rebounced = changing & bounced;
+	pending &= changing & ~bounced;
+	keep(pending);
+	load(restart, since);
+	load(rebounced, bouncedSince);
+	pending |= restart | rebounced;
+
+	// pins whose counter reached the threshold take their raw state
+	Mask_t settled = reached(pending);
+	pending &= ~settled;
+	keep(pending);
+	counting = pending != 0;
+	return debounced ^ settled;
+}
+
+/**
+ * @brief Pass every edge through immediately, then ignore the pin until the delay is over.
+ */
+Mask_t GamepadDebouncer::updateLockout(Mask_t raw, Mask_t debounced, uint32_t since)
+{
+	locked &= ~reached(locked);
+
+	Mask_t changing = raw ^ debounced;
+	Mask_t edges = changing & ~locked;
+	keep(locked);
+	load(edges, since);
+	locked |= edges;
+
+	// a locked pin that disagrees changes once its delay is over
+	counting = (changing & locked) != 0;
+	return debounced ^ edges;
+}
+
+/**
+ * @brief Add the ticks since the last update to the counters of the pins that are counting.
+ *
+ * A ripple-carry add of the same number to every pin, counters that overflow stay at the most
+ * they can hold, which is past any threshold.
+ */
+void GamepadDebouncer::advance(uint32_t now)
+{
+	uint32_t tick = now / tickMs;
+	uint32_t ticks = tick - lastTick;
+	lastTick = tick;
+
+	Mask_t pins = pending | locked;
+	if (ticks == 0 || pins == 0)
+		return;
+
+	if (ticks >= GAMEPAD_DEBOUNCER_MAX_TICKS) {
+		for (uint8_t plane = 0; plane < GAMEPAD_DEBOUNCER_COUNTER_BITS; plane++)
+			counter[plane] |= pins;
+		return;
+	}
+
+	Mask_t carry = 0;
+	for (uint8_t plane = 0; plane < GAMEPAD_DEBOUNCER_COUNTER_BITS; plane++) {
+		Mask_t add = (ticks & (1 << plane)) ? pins : 0;
+		Mask_t sum = counter[plane] ^ add ^ carry;
+		carry = (counter[plane] & add) | (carry & (counter[plane] ^ add));
+		counter[plane] = sum;
+	}
+	for (uint8_t plane = 0; plane < GAMEPAD_DEBOUNCER_COUNTER_BITS; plane++)
+		counter[plane] |= carry;
+}
+
+/**
+ * @brief Start the counters of the pins at since, the ticks from then to the last update.
+ */
+void GamepadDebouncer::load(Mask_t pins, uint32_t since)
+{
+	if (pins == 0)
+		return;
+
+	uint32_t ticks = lastTick - since / tickMs;
+	if (ticks > GAMEPAD_DEBOUNCER_MAX_TICKS)
+		ticks = GAMEPAD_DEBOUNCER_MAX_TICKS;
+	for (uint8_t plane = 0; plane < GAMEPAD_DEBOUNCER_COUNTER_BITS; plane++)
+		counter[plane] = (counter[plane] & ~pins) | ((ticks & (1 << plane)) ? pins : 0);
+}
+
+// Clear the counters of every pin but these
+void GamepadDebouncer::keep(Mask_t pins)
+{
+	for (uint8_t plane = 0; plane < GAMEPAD_DEBOUNCER_COUNTER_BITS; plane++)
+		counter[plane] &= pins;
+}
+
+/**
+ * @brief The pins whose counter is at or past the threshold, compared from the top plane down.
+ */
+Mask_t GamepadDebouncer::reached(Mask_t pins) const
+{
+	Mask_t above = 0;
+	Mask_t equal = pins;
+	for (int8_t plane = GAMEPAD_DEBOUNCER_COUNTER_BITS - 1; plane >= 0; plane--) {
+		if (thresholdTicks & (1 << plane)) {
+			equal &= counter[plane];
+		} else {
+			above |= equal & counter[plane];
+			equal &= ~counter[plane];
+		}
+	}
+	return above | equal;
+}
@@ -0,0 +1,55 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#include "GamepadDecoder.h"
+
+#include <string.h>
+
+void GamepadDecoder::clear()
+{
+	memset(table, 0, sizeof(table));
+}
+
+void GamepadDecoder::addButtons(Mask_t pinMask, uint32_t buttons)
+{
+	add(pinMask, {buttons, 0, 0, 0, 0});
+}
+
+void GamepadDecoder::addDpad(Mask_t pinMask, uint8_t dpad)
+{
+	add(pinMask, {0, dpad, 0, 0, 0});
+}
+
+void GamepadDecoder::addAnalog(Mask_t pinMask, uint8_t analog)
+{
+	add(pinMask, {0, 0, analog, 0, 0});
+}
+
+void GamepadDecoder::addFlags(Mask_t pinMask, uint8_t flags)
+{
+	add(pinMask, {0, 0, 0, flags, 0});
+}
+
+/**
+ * @brief OR a contribution into every table entry whose index has one of the given pins set.
+ */
+void GamepadDecoder::add(Mask_t pinMask, const GamepadDecoderEntry& contribution)
+{
+	for (uint8_t slice = 0; slice < GAMEPAD_DECODER_SLICES; slice++) {
+		uint8_t slicePins = (pinMask >> (slice * GAMEPAD_DECODER_SLICE_BITS)) & 0x0F;
+		if (slicePins == 0)
+			continue;
+
+		for (uint8_t index = 0; index < (1 << GAMEPAD_DECODER_SLICE_BITS); index++) {
+			if (index & slicePins) {
+				GamepadDecoderEntry& entry = table[slice][index];
+				entry.buttons |= contribution.buttons;
+				entry.dpad |= contribution.dpad;
+				entry.analog |= contribution.analog;
+				entry.flags |= contribution.flags;
+			}
+		}
+	}
+}
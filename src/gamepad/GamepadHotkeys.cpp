@@ -0,0 +1,86 @@
+#include "GamepadHotkeys.h"
+
+static inline bool held(uint32_t buttons, uint8_t dpad, uint16_t aux, uint32_t buttonsMask, uint32_t dpadMask, uint32_t auxMask)
+{
+	return (buttons & buttonsMask) == buttonsMask && (dpad & dpadMask) == dpadMask && (aux & auxMask) == auxMask;
+}
+
+void GamepadHotkeys::clear()
+{
+	entryCount = 0;
+	groupCount = 0;
+	chords = 0;
+	armed = 0;
+	latched = 0;
+}
+
+/**
+ * @brief Add a hotkey after the ones already added. Hotkeys without an action are left out.
+ */
+bool GamepadHotkeys::add(const HotkeyEntry& entry)
+{
+	if (entry.action == HOTKEY_NONE)
+		return true;
+	if (entryCount >= GAMEPAD_HOTKEYS_MAX)
+		return false;
+
+	const uint8_t index = entryCount++;
+	entries[index] = entry;
+
+	if (entry.firstDpadMask != 0 || entry.firstButtonsMask != 0 || entry.firstAuxMask != 0) {
+		chords |= 1U << index;
+		return true;
+	}
+
+	for (uint8_t group = 0; group < groupCount; group++) {
+		if (groups[group].auxMask == entry.auxMask) {
+			groups[group].hotkeys |= 1U << index;
+			return true;
+		}
+	}
+	groups[groupCount++] = {(uint16_t)entry.auxMask, 1U << index};
+	return true;
+}
+
+uint32_t GamepadHotkeys::candidates(uint16_t aux) const
+{
+	uint32_t result = chords;
+	for (uint8_t group = 0; group < groupCount; group++) {
+		if ((aux & groups[group].auxMask) == groups[group].auxMask)
+			result |= groups[group].hotkeys;
+	}
+	return result;
+}
+
+bool GamepadHotkeys::step(uint8_t index, uint32_t buttons, uint8_t dpad, uint16_t aux, uint32_t nowMs)
+{
+	const HotkeyEntry& entry = entries[index];
+	const uint32_t bit = 1U << index;
+	const bool pressed = held(buttons, dpad, aux, entry.buttonsMask, entry.dpadMask, entry.auxMask);
+	if (!(chords & bit))
+		return pressed;
+
+	// a completed chord holds for as long as its own combination does
+	if (latched & bit) {
+		if (pressed)
+			return true;
+		latched &= ~bit;
+	}
+
+	// the first step was pressed on an earlier change
+	if (armed & bit) {
+		if ((nowMs - armedMs[index]) > HOTKEY_CHORD_TIMEOUT_MS) {
+			armed &= ~bit;
+		} else if (pressed) {
+			armed &= ~bit;
+			latched |= bit;
+			return true;
+		}
+	}
+
+	if (!pressed && held(buttons, dpad, aux, entry.firstButtonsMask, entry.firstDpadMask, entry.firstAuxMask)) {
+		armed |= bit;
+		armedMs[index] = nowMs;
+	}
+	return false;
+}
@@ -0,0 +1,39 @@
+#include "GamepadStatePublisher.h"
+
+#include <string.h>
+#include "hardware/sync.h"
+
+void GamepadStatePublisher::publish(const GamepadState& state, const GamepadAuxState& auxState)
+{
+	// only core0 writes the published copy, so it can be compared without the sequence
+	if (memcmp(&this->state, &state, sizeof(GamepadState)) == 0 &&
+		memcmp(&this->auxState, &auxState, sizeof(GamepadAuxState)) == 0)
+		return;
+
+	uint32_t currSequence = sequence;
+	sequence = currSequence + 1;
+	__dmb();
+
+	memcpy(&this->state, &state, sizeof(GamepadState));
+	memcpy(&this->auxState, &auxState, sizeof(GamepadAuxState));
+
+	__dmb();
+	sequence = currSequence + 2;
+}
+
+uint32_t GamepadStatePublisher::read(GamepadState& state, GamepadAuxState& auxState) const
+{
+	while (true) {
+		uint32_t currSequence = sequence;
+		if (currSequence & 1)
+			continue;
+
+		__dmb();
+		memcpy(&state, &this->state, sizeof(GamepadState));
+		memcpy(&auxState, &this->auxState, sizeof(GamepadAuxState));
+		__dmb();
+
+		if (sequence == currSequence)
+			return currSequence >> 1;
+	}
+}
@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#include "SOCDState.h"
+#include "GamepadState.h"
+
+// Last direction of an axis, and the axis input bits: up/left is the low bit, down/right the high one
+#define SOCD_AXIS_NONE   0
+#define SOCD_AXIS_LOW    1
+#define SOCD_AXIS_HIGH   2
+#define SOCD_AXIS_BOTH   (SOCD_AXIS_LOW | SOCD_AXIS_HIGH)
+
+// Bypass doesn't need a table
+#define SOCD_MODES       SOCD_MODE_BYPASS
+
+// A transition is the axis output in the low bits, and the next last direction above them
+#define SOCD_TRANSITION(output, last) (uint8_t)((output) | ((last) << 2))
+
+/**
+ * @brief The output and next last direction of one axis, as the SOCD cleaner has always done it.
+ */
+static constexpr uint8_t socdTransition(SOCDMode mode, bool vertical, uint8_t last, uint8_t input)
+{
+	switch (input)
+	{
+		case SOCD_AXIS_BOTH:
+			if (vertical && mode == SOCD_MODE_UP_PRIORITY)
+				return SOCD_TRANSITION(SOCD_AXIS_LOW, SOCD_AXIS_LOW);
+			else if (mode == SOCD_MODE_SECOND_INPUT_PRIORITY && last != SOCD_AXIS_NONE)
+				return SOCD_TRANSITION(last ^ SOCD_AXIS_BOTH, last);
+			else if (mode == SOCD_MODE_FIRST_INPUT_PRIORITY && last != SOCD_AXIS_NONE)
+				return SOCD_TRANSITION(last, last);
+			else
+				return SOCD_TRANSITION(SOCD_AXIS_NONE, SOCD_AXIS_NONE);
+
+		case SOCD_AXIS_LOW:
+		case SOCD_AXIS_HIGH:
+			return SOCD_TRANSITION(input, input);
+
+		default:
+			return SOCD_TRANSITION(SOCD_AXIS_NONE, SOCD_AXIS_NONE);
+	}
+}
+
+struct SOCDTransitionTables
+{
+	// [mode][vertical][last direction][axis input]
+	uint8_t table[SOCD_MODES][2][3][4];
+
+	constexpr SOCDTransitionTables() : table()
+	{
+		for (uint8_t mode = 0; mode < SOCD_MODES; mode++)
+			for (uint8_t vertical = 0; vertical < 2; vertical++)
+				for (uint8_t last = 0; last < 3; last++)
+					for (uint8_t input = 0; input < 4; input++)
+						table[mode][vertical][last][input] = socdTransition((SOCDMode)mode, vertical, last, input);
+	}
+};
+
+static constexpr SOCDTransitionTables socdTables;
+
+void SOCDState::reset()
+{
+	lastUD = SOCD_AXIS_NONE;
+	lastLR = SOCD_AXIS_NONE;
+	fourWayDepth = 0;
+	fourWayHeld = 0;
+}
+
+uint8_t SOCDState::clean(SOCDMode mode, uint8_t dpad)
+{
+	if (mode == SOCD_MODE_BYPASS)
+		return dpad;
+	else if (mode >= SOCD_MODES)
+		mode = SOCD_MODE_NEUTRAL;
+
+	const uint8_t ud = socdTables.table[mode][1][lastUD][dpad & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN)];
+	const uint8_t lr = socdTables.table[mode][0][lastLR][(dpad & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT)) >> 2];
+	lastUD = ud >> 2;
+	lastLR = lr >> 2;
+	return (ud & SOCD_AXIS_BOTH) | ((lr & SOCD_AXIS_BOTH) << 2);
+}
+
+uint8_t SOCDState::cleanDual(SOCDMode mode, uint8_t dpad)
+{
+	const uint8_t leftRight = GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT;
+	const bool unresolved = (mode == SOCD_MODE_SECOND_INPUT_PRIORITY || mode == SOCD_MODE_FIRST_INPUT_PRIORITY) &&
+		(dpad & leftRight) == leftRight && lastLR == SOCD_AXIS_NONE;
+
+	// the history stays empty either way
+	const uint8_t result = clean(mode, dpad);
+	return unresolved ? (result | leftRight) : result;
+}
+
+uint8_t SOCDState::filterToFourWay(uint8_t dpad)
+{
+	const uint8_t held = dpad & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT);
+	if (held != fourWayHeld) {
+		// released directions leave the stack, keeping the order of the others
+		const uint8_t released = fourWayHeld & ~held;
+		if (released) {
+			uint8_t depth = 0;
+			for (uint8_t i = 0; i < fourWayDepth; i++) {
+				if (!(fourWayStack[i] & released))
+					fourWayStack[depth++] = fourWayStack[i];
+			}
+			fourWayDepth = depth;
+		}
+
+		// newly pressed ones go on top, in up, down, left, right order
+		const uint8_t pressed = held & ~fourWayHeld;
+		for (uint8_t mask = GAMEPAD_MASK_UP; mask <= GAMEPAD_MASK_RIGHT; mask <<= 1) {
+			if (pressed & mask)
+				fourWayStack[fourWayDepth++] = mask;
+		}
+		fourWayHeld = held;
+	}
+
+	return fourWayDepth ? fourWayStack[fourWayDepth - 1] : 0;
+}
@@ -2,6 +2,11 @@
 #include "gp2040.h"
 #include "helper.h"
 #include "system.h"
+#include "gpioedges.h"
+#include "loopstats.h"
+#include "inputcapture.h"
+#include "latencytrace.h"
+#include "bootprofile.h"
 #include "enums.pb.h"
 
 #include "build_info.h"
@@ -10,6 +15,7 @@
 #include "addonmanager.h"
 #include "types.h"
 #include "usbhostmanager.h"
+#include "usbdriver.h"
 
 // Inputs for Core0
 #include "addons/analog.h"
@@ -48,6 +54,9 @@
 static const uint32_t REBOOT_HOTKEY_ACTIVATION_TIME_MS = 50;
 static const uint32_t REBOOT_HOTKEY_HOLD_TIME_MS = 4000;
 
+// Keep servicing TinyUSB while waiting for the sample time, unless it is this close
+static const uint32_t SOF_SYNC_TASK_GUARD_US = 100;
+
 const static uint32_t rebootDelayMs = 500;
 static absolute_time_t rebootDelayTimeout = nil_time;
 
@@ -63,11 +72,13 @@ void GP2040::setup() {
 	// I2C & SPI rely on the system clock
 	PeripheralManager::getInstance().initSPI();
 	PeripheralManager::getInstance().initI2C();
+	BootProfile::mark(BOOT_PHASE_PERIPHERALS);
 
 	Gamepad * gamepad = new Gamepad();
 	Gamepad * processedGamepad = new Gamepad();
 	Storage::getInstance().SetGamepad(gamepad);
 	Storage::getInstance().SetProcessedGamepad(processedGamepad);
+	Storage::getInstance().SetSnapshotGamepad(new Gamepad());
 
 	// Set pin mappings for all GPIO functions
 	Storage::getInstance().setFunctionalPinMappings();
@@ -85,6 +96,12 @@ void GP2040::setup() {
 
 	// now we can load the latest configured profile, which will map the
 	// new set of GPIOs to use...
+	// without a free state machine or DMA channels to oversample with, the pins are read once
+	// per loop and the edge interrupts catch the bounces between reads
+	samplerFallback = Storage::getInstance().getGamepadOptions().gpioOversampling && !gpioSampler.start();
+	// sleeping while idle relies on the edge interrupts to wake up on a press
+	GpioEdges::setup(Storage::getInstance().getGamepadOptions().gpioEdgeCapture ||
+		Storage::getInstance().getGamepadOptions().idleSleep || samplerFallback);
 	this->initializeStandardGpio();
 
 	const GamepadOptions& gamepadOptions = Storage::getInstance().getGamepadOptions();
@@ -125,6 +142,7 @@ void GP2040::setup() {
 	addons.LoadAddon(new ReverseInput());
 	addons.LoadAddon(new TurboInput()); // Turbo overrides button states and should be close to the end
 	addons.LoadAddon(new InputMacro());
+	BootProfile::mark(BOOT_PHASE_CORE0_ADDONS);
 
 	InputMode inputMode = gamepad->getOptions().inputMode;
 	const BootAction bootAction = getBootAction();
@@ -193,6 +211,10 @@ void GP2040::setup() {
 
 	// Setup USB Driver
 	DriverManager::getInstance().setup(inputMode);
+	LatencyTrace::init(inputMode);
+	LoopStats::init(inputMode);
+	AddonManager::InitProfile(inputMode);
+	INPUT_CAPTURE_INIT(inputMode);
 
 	// save to match user expectations on choosing mode at boot, and this is
 	// before USB host will be used so we can force it to ignore the check
@@ -202,42 +224,51 @@ void GP2040::setup() {
 	}
 
 	// register system event handlers
-	EventManager::getInstance().registerEventHandler(GP_EVENT_STORAGE_SAVE, GPEVENT_CALLBACK(this->handleStorageSave(event)));
-	EventManager::getInstance().registerEventHandler(GP_EVENT_RESTART, GPEVENT_CALLBACK(this->handleSystemReboot(event)));
+	EventManager::getInstance().registerEventHandler(GP_EVENT_STORAGE_SAVE, GPEVENT_CALLBACK(GP2040, handleStorageSave), this);
+	EventManager::getInstance().registerEventHandler(GP_EVENT_RESTART, GPEVENT_CALLBACK(GP2040, handleSystemReboot), this);
+
+	BootProfile::mark(BOOT_PHASE_CORE0_SETUP);
 }
 
 /**
  * @brief Initialize standard input button GPIOs that are present in the currently loaded profile.
  */
 void GP2040::initializeStandardGpio() {
-	GpioMappingInfo* pinMappings = Storage::getInstance().getProfilePinMappings();
 	buttonGpios = 0;
-	for (Pin_t pin = 0; pin < (Pin_t)NUM_BANK0_GPIOS; pin++)
-	{
-		// (NONE=-10, RESERVED=-5, ASSIGNED_TO_ADDON=0, everything else is ours)
-		if (pinMappings[pin].action > 0)
-		{
-			gpio_init(pin);             // Initialize pin
-			gpio_set_dir(pin, GPIO_IN); // Set as INPUT
-			gpio_pull_up(pin);          // Set as PULLUP
-			buttonGpios |= 1 << pin;    // mark this pin as mattering for GPIO debouncing
-		}
-	}
+	updateStandardGpio();
 }
 
 /**
- * @brief Deinitialize standard input button GPIOs that are present in the currently loaded profile.
+ * @brief Bring standard input button GPIOs in line with the currently loaded profile, only touching
+ * the pins that were added or removed since the last update.
  */
-void GP2040::deinitializeStandardGpio() {
+void GP2040::updateStandardGpio() {
 	GpioMappingInfo* pinMappings = Storage::getInstance().getProfilePinMappings();
+	Mask_t profileGpios = 0;
 	for (Pin_t pin = 0; pin < (Pin_t)NUM_BANK0_GPIOS; pin++)
 	{
 		// (NONE=-10, RESERVED=-5, ASSIGNED_TO_ADDON=0, everything else is ours)
 		if (pinMappings[pin].action > 0)
+			profileGpios |= 1 << pin;
+	}
+
+	Mask_t removedGpios = buttonGpios & ~profileGpios;
+	Mask_t addedGpios = profileGpios & ~buttonGpios;
+	for (Pin_t pin = 0; pin < (Pin_t)NUM_BANK0_GPIOS; pin++)
+	{
+		if (removedGpios & (1 << pin))
 		{
 			gpio_deinit(pin);
 		}
+		else if (addedGpios & (1 << pin))
+		{
+			gpio_init(pin);             // Initialize pin
+			gpio_set_dir(pin, GPIO_IN); // Set as INPUT
+			gpio_pull_up(pin);          // Set as PULLUP
+		}
 	}
+	buttonGpios = profileGpios;     // the pins mattering for GPIO debouncing
+	GpioEdges::setPins(buttonGpios);
 }
 
 /**
@@ -251,33 +282,111 @@ void GP2040::deinitializeStandardGpio() {
  * instead, if you don't want debounced data.
  */
 void GP2040::debounceGpioGetAll() {
-	Mask_t raw_gpio = ~gpio_get_all();
+	Mask_t raw_gpio = ~(gpioSampler.isRunning() ? gpioSampler.read() : gpio_get_all()) & buttonGpios;
+	GpioEdgeBatch edges;
+	bool haveEdges = GpioEdges::read(edges);
 	Gamepad* gamepad = Storage::getInstance().GetGamepad();
-	// return if state isn't different than the actual
-	if (gamepad->debouncedGpio == (raw_gpio & buttonGpios)) return;
-
-	uint32_t debounceDelay = Storage::getInstance().getGamepadOptions().debounceDelay;
-	// abort if no delay is configured
-	if (debounceDelay == 0) {
-		gamepad->debouncedGpio = raw_gpio;
+	// return if state isn't different than the actual, nothing is bouncing
+	if (gamepad->debouncedGpio == raw_gpio) {
+		debouncer.settle();
+		LatencyTrace::rawSettled();
 		return;
 	}
 
-	uint32_t now = getMillis();
-	// check each button use case GPIO for state
-	for (Pin_t pin = 0; pin < (Pin_t)NUM_BANK0_GPIOS; pin++) {
-		Mask_t pin_mask = 1 << pin;
-		if (buttonGpios & pin_mask) {
-			// Allow debouncer to change state if button state changed and debounce delay threshold met
-			if ((gamepad->debouncedGpio & pin_mask) != \
-					(raw_gpio & pin_mask) && ((now - gpioDebounceTime[pin]) > debounceDelay)) {
-				gamepad->debouncedGpio ^= pin_mask;
-				gpioDebounceTime[pin] = now;
-			}
-		}
+	// with edge capture, the pins changed when the first edge came in rather than when read,
+	// and the ones that bounced settled from their last edge
+	uint32_t nowUs = time_us_32();
+	uint32_t edgeUs = nowUs;
+	uint32_t lastEdgeUs = nowUs;
+	if (haveEdges && !edges.overflowed) {
+		edgeUs = edges.firstUs;
+		lastEdgeUs = edges.lastUs;
+		LOOP_STATS_SAMPLE_US(LOOP_PHASE_CORE0_EDGE_GAIN, nowUs - edgeUs);
+		// timed the same with sleeping on or off, so that the two can be compared
+		if (idleScheduler.isIdle())
+			LOOP_STATS_SAMPLE_US(LOOP_PHASE_CORE0_WAKE_LATENCY, nowUs - edgeUs);
+	}
+	LatencyTrace::rawEdge(edgeUs);
+
+	const GamepadOptions& gamepadOptions = Storage::getInstance().getGamepadOptions();
+	debouncer.configure(gamepadOptions.debounceDelay, gamepadOptions.debounceMode);
+
+	// all button GPIO are debounced at once, see GamepadDebouncer
+	uint32_t nowMs = getMillis();
+	Mask_t debouncedGpio = debouncer.update(raw_gpio, gamepad->debouncedGpio, nowMs,
+		nowMs - (nowUs - edgeUs) / 1000, edges.bounced, nowMs - (nowUs - lastEdgeUs) / 1000);
+	if (debouncedGpio != gamepad->debouncedGpio) {
+		LatencyTrace::inputEdge(debouncedGpio & ~gamepad->debouncedGpio, nowUs);
+		gamepad->debouncedGpio = debouncedGpio;
+		INPUT_CAPTURE_GPIO_WORD(debouncedGpio, nowUs);
+
+		// pins that are still bouncing start a new edge
+		if (debouncedGpio != raw_gpio)
+			LatencyTrace::rawEdge(nowUs);
 	}
 }
 
+uint32_t GP2040::waitForSampleTime(SOFSync& sofSync) {
+	uint32_t nowUs = time_us_32();
+	uint32_t sampleUs = sofSync.nextSampleTime(nowUs);
+
+	// nothing changed for a while, sleep through the wait instead of spinning
+	uint32_t wakeUs = idleScheduler.wakeTime(nowUs, sampleUs);
+	if (wakeUs != nowUs) {
+		idleUntil(nowUs, wakeUs);
+		// free running, the sample is due as soon as we're awake
+		if (sampleUs == nowUs)
+			return time_us_32();
+	}
+
+	int32_t remainingUs;
+	while ((remainingUs = (int32_t)(sampleUs - time_us_32())) > 0) {
+		// the host takes the last report while we wait, let the driver see it
+		if (remainingUs > (int32_t)SOF_SYNC_TASK_GUARD_US)
+			tud_task();
+	}
+	return time_us_32();
+}
+
+void GP2040::idleUntil(uint32_t nowUs, uint32_t wakeUs) {
+	uint32_t sleepStartUs = nowUs;
+	uint32_t edgeUs;
+	while (!GpioEdges::pending(edgeUs)) {
+		int32_t remainingUs = (int32_t)(wakeUs - time_us_32());
+		if (remainingUs <= 0 || best_effort_wfe_or_timeout(make_timeout_time_us(remainingUs)))
+			break;
+		// woken by an interrupt, keep the driver going as the spinning wait does
+		tud_task();
+	}
+
+	// a button edge is timed to when the loop reads it, see debounceGpioGetAll, and the change
+	// it brings ends the idling at the end of the loop
+	LOOP_STATS_SAMPLE_US(LOOP_PHASE_CORE0_IDLE, time_us_32() - sleepStartUs);
+}
+
+/**
+ * @brief Start the TinyUSB device, once the input driver is set up.
+ *
+ * Called while core1 is still setting up the display, LEDs and the rest of its add-ons, so that
+ * enumeration doesn't wait for the slowest of them.
+ */
+void GP2040::startUSB() {
+	bool configMode = DriverManager::getInstance().isConfigMode();
+	const GamepadOptions& gamepadOptions = Storage::getInstance().getGamepadOptions();
+	SOFSync& sofSync = get_usb_sof_sync();
+	sofSync.setup(!configMode && gamepadOptions.usbSofSync, gamepadOptions.usbSofSyncMarginUs);
+
+	// Start the TinyUSB Device functionality
+	tud_init(TUD_OPT_RHPORT);
+	BootProfile::mark(BOOT_PHASE_USB_INIT);
+	if (sofSync.isEnabled())
+		tud_sof_cb_enable(true);
+}
+
+void GP2040::serviceUSB() {
+	tud_task();
+}
+
 void GP2040::run() {
 	bool configMode = DriverManager::getInstance().isConfigMode();
 	GPDriver * inputDriver = DriverManager::getInstance().getDriver();
@@ -285,66 +394,115 @@ void GP2040::run() {
 	Gamepad * processedGamepad = Storage::getInstance().GetProcessedGamepad();
 	GamepadState prevState;
 
-	// Start the TinyUSB Device functionality
-	tud_init(TUD_OPT_RHPORT);
+	const GamepadOptions& gamepadOptions = Storage::getInstance().getGamepadOptions();
+	SOFSync& sofSync = get_usb_sof_sync();
 
 	// Initialize our USB manager
 	USBHostManager::getInstance().start();
 
+	// USB host reports don't wake the loop up, don't sleep with a host port
+	idleScheduler.setup(!configMode && gamepadOptions.idleSleep && !USBHostManager::getInstance().isRunning());
+
 	if (configMode == true ) {
 		rndis_init();
 	}
 
+	// core1's add-ons are set up by now, so the display is listening
+	if (samplerFallback)
+		EventManager::getInstance().triggerEvent(GPSystemErrorEvent("Oversampling unavailable, using edges"));
+
+	LOOP_STATS_INIT(0);
+	BootProfile::mark(BOOT_PHASE_LOOP);
+
 	while (1) { // LOOP
+		LOOP_STATS_BEGIN(0);
+
 		this->getReinitGamepad(gamepad);
 
+		// Run our handlers for events raised on core1
+		EventManager::getInstance().processEvents();
+
 		memcpy(&prevState, &gamepad->state, sizeof(GamepadState));
+		LOOP_STATS_MARK(LOOP_PHASE_CORE0_EVENTS);
+
+		// Sample so that the report is ready just before the host polls for it
+		uint32_t sampleUs = waitForSampleTime(sofSync);
+		LOOP_STATS_MARK(LOOP_PHASE_CORE0_SOF_WAIT);
+
+		// Debug builds count heap operations in the input path, which should be none
+		System::startHeapOperationsWindow();
 
 		// Debounce
 		debounceGpioGetAll();
+		LOOP_STATS_MARK(LOOP_PHASE_CORE0_DEBOUNCE);
 		// Read Gamepad
 		gamepad->read();
 
-		checkRawState(prevState, gamepad->state);
+		inputFrame.setRaw(prevState, gamepad->state);
+		LOOP_STATS_MARK(LOOP_PHASE_CORE0_READ);
 
 		// Process USB Host on Core0
 		USBHostManager::getInstance().process();
+		LOOP_STATS_MARK(LOOP_PHASE_CORE0_USB_HOST);
 
 		// Config Loop (Web-Config skips Core0 add-ons)
 		if (configMode == true) {
 			inputDriver->process(gamepad);
+			LOOP_STATS_MARK(LOOP_PHASE_CORE0_DRIVER);
 			rebootHotkeys.process(gamepad, configMode);
+			triggerInputFrame();
 			checkSaveRebootState();
+			LOOP_STATS_END(0);
 			continue;
 		}
 
 		// Pre-Process add-ons for MPGS
 		addons.PreprocessAddons();
+		LOOP_STATS_MARK(LOOP_PHASE_CORE0_PREPROCESS_ADDONS);
 
 		gamepad->hotkey(); 	// check for MPGS hotkeys
 		rebootHotkeys.process(gamepad, configMode);
+		LOOP_STATS_MARK(LOOP_PHASE_CORE0_HOTKEY);
 
 		gamepad->process(); // process through MPGS
+		LOOP_STATS_MARK(LOOP_PHASE_CORE0_PROCESS);
 
 		// (Post) Process for add-ons
 		addons.ProcessAddons();
 
-		checkProcessedState(processedGamepad->state, gamepad->state);
+		inputFrame.setProcessed(processedGamepad->state, gamepad->state);
+		triggerInputFrame();
 
 		// Copy Processed Gamepad for Core1 (race condition otherwise)
 		memcpy(&processedGamepad->state, &gamepad->state, sizeof(GamepadState));
+		Storage::getInstance().PublishProcessedGamepad();
+		LOOP_STATS_MARK(LOOP_PHASE_CORE0_PROCESS_ADDONS);
 
 		// Process Input Driver
 		bool processed = inputDriver->process(gamepad);
+		uint32_t processedUs = time_us_32();
+		if (processed)
+			LatencyTrace::reportSent(processedUs);
+		sofSync.onCycleDone(sampleUs, processedUs, processed);
+		LOOP_STATS_MARK(LOOP_PHASE_CORE0_DRIVER);
 
 		// TinyUSB Task update
 		tud_task();
+		LOOP_STATS_MARK(LOOP_PHASE_CORE0_TUD_TASK);
 
 		// Post-Process Add-ons with USB Report Processed Sent
 		addons.PostprocessAddons(processed);
+		LOOP_STATS_MARK(LOOP_PHASE_CORE0_POSTPROCESS_ADDONS);
+
+		// pins still bouncing need the loop to time them
+		idleScheduler.onLoop(inputFrame.changes != 0 || debouncer.isCounting());
+
+		System::endHeapOperationsWindow();
 
 		// Check if we have a pending save
 		checkSaveRebootState();
+
+		LOOP_STATS_END(0);
 	}
 }
 
@@ -356,32 +514,29 @@ void GP2040::getReinitGamepad(Gamepad * gamepad) {
 		uint32_t previousProfile = gamepad->lastReinitProfileNumber;
 		uint32_t currentProfile = gamepadOptions.profileNumber;
 
-		// deinitialize the ordinary (non-reserved, non-addon) GPIO pins, since
-		// we are moving off of them and onto potentially different pin assignments
-		// we currently don't support ASSIGNED_TO_ADDON pins being reinitialized,
-		// but if they were to be, that'd be the addon's duty, not ours
-		this->deinitializeStandardGpio();
-
-		// now we can load the latest configured profile, which will map the
-		// new set of GPIOs to use...
+		// load the latest configured profile, which will map the new set of GPIOs to use. the
+		// display, web config and add-ons read the current pin mappings from there...
 		Storage::getInstance().setFunctionalPinMappings();
 
-		// ...and initialize the pins again
-		this->initializeStandardGpio();
+		// ...and reconfigure the ordinary (non-reserved, non-addon) GPIO pins whose role
+		// changed, pins kept by the new profile stay as they are. we currently don't support
+		// ASSIGNED_TO_ADDON pins being reinitialized, but if they were to be, that'd be the
+		// addon's duty, not ours
+		this->updateStandardGpio();
 
-		// now we can tell the gamepad that the new mappings are in place
-		// and ready to use, and the pins are ready, so it should reinitialize itself
+		// now the gamepad can switch to the new profile's pin masks and input tables, compiled at setup
 		gamepad->reinit();
 
-		// ...and addons on this core, if they implemented reinit (just things
-		// with simple GPIO pin usage, at time of writing)
-		addons.ReinitializeAddons();
+		// ...and addons on this core, if they implemented reinit (just things with simple
+		// GPIO pin usage, at time of writing) and the new profile moved any of their pins
+		if (!gamepad->sharesAddonPins(previousProfile, currentProfile))
+			addons.ReinitializeAddons();
 
 		// Update the last reinit profile
 		gamepad->lastReinitProfileNumber = currentProfile;
 
 		// Trigger the profile change event now that reinit is complete
-		EventManager::getInstance().triggerEvent(new GPProfileChangeEvent(previousProfile, currentProfile));
+		EventManager::getInstance().triggerEvent(GPProfileChangeEvent(previousProfile, currentProfile));
 	}
 }
 
@@ -409,6 +564,7 @@ GP2040::BootAction GP2040::getBootAction() {
 
 				// Copy Processed Gamepad for Core1 (race condition otherwise)
 				memcpy(&processedGamepad->state, &gamepad->state, sizeof(GamepadState));
+				Storage::getInstance().PublishProcessedGamepad();
 
                 const ForcedSetupOptions& forcedSetupOptions = Storage::getInstance().getForcedSetupOptions();
                 bool modeSwitchLocked = forcedSetupOptions.mode == FORCED_SETUP_MODE_LOCK_MODE_SWITCH ||
@@ -517,55 +673,13 @@ void GP2040::RebootHotkeys::process(Gamepad* gamepad, bool configMode) {
 	}
 }
 
-void GP2040::checkRawState(GamepadState prevState, GamepadState currState) {
-    // buttons pressed
-    if (
-        ((currState.aux & ~prevState.aux) != 0) ||
-        ((currState.dpad & ~prevState.dpad) != 0) ||
-        ((currState.buttons & ~prevState.buttons) != 0)
-    ) {
-        EventManager::getInstance().triggerEvent(new GPButtonDownEvent((currState.dpad & ~prevState.dpad), (currState.buttons & ~prevState.buttons), (currState.aux & ~prevState.aux)));
-    }
-
-    // buttons released
-    if (
-        ((prevState.aux & ~currState.aux) != 0) ||
-        ((prevState.dpad & ~currState.dpad) != 0) ||
-        ((prevState.buttons & ~currState.buttons) != 0)
-    ) {
-        EventManager::getInstance().triggerEvent(new GPButtonUpEvent((prevState.dpad & ~currState.dpad), (prevState.buttons & ~currState.buttons), (prevState.aux & ~currState.aux)));
-    }
-}
-
-void GP2040::checkProcessedState(GamepadState prevState, GamepadState currState) {
-    // buttons pressed
-    if (
-        ((currState.aux & ~prevState.aux) != 0) ||
-        ((currState.dpad & ~prevState.dpad) != 0) ||
-        ((currState.buttons & ~prevState.buttons) != 0)
-    ) {
-        EventManager::getInstance().triggerEvent(new GPButtonProcessedDownEvent((currState.dpad & ~prevState.dpad), (currState.buttons & ~prevState.buttons), (currState.aux & ~prevState.aux)));
-    }
-
-    // buttons released
-    if (
-        ((prevState.aux & ~currState.aux) != 0) ||
-        ((prevState.dpad & ~currState.dpad) != 0) ||
-        ((prevState.buttons & ~currState.buttons) != 0)
-    ) {
-        EventManager::getInstance().triggerEvent(new GPButtonProcessedUpEvent((prevState.dpad & ~currState.dpad), (prevState.buttons & ~currState.buttons), (prevState.aux & ~currState.aux)));
-    }
-
-    if (
-        (currState.lx != prevState.lx) ||
-        (currState.ly != prevState.ly) ||
-        (currState.rx != prevState.rx) ||
-        (currState.ry != prevState.ry) ||
-        (currState.lt != prevState.lt) ||
-        (currState.rt != prevState.rt)
-    ) {
-        EventManager::getInstance().triggerEvent(new GPAnalogProcessedMoveEvent(currState.lx, currState.ly, currState.rx, currState.ry, currState.lt, currState.rt));
-    }
+/**
+ * @brief Raise the loop's input frame event, if anything changed in it.
+ */
+void GP2040::triggerInputFrame() {
+	if (inputFrame.changes != 0) {
+		EventManager::getInstance().triggerEvent(inputFrame);
+	}
 }
 
 void GP2040::checkSaveRebootState() {
@@ -574,6 +688,9 @@ void GP2040::checkSaveRebootState() {
 		Storage::getInstance().save(forceSave);
 	}
 
+	// the report for this poll is out, write a bit of a pending save before the next one
+	EEPROM.step();
+
 	if (rebootRequested) {
 		rebootRequested = false;
 		rebootDelayTimeout = make_timeout_time_ms(rebootDelayMs);
@@ -584,14 +701,14 @@ void GP2040::checkSaveRebootState() {
 	}
 }
 
-void GP2040::handleStorageSave(GPEvent* e) {
+void GP2040::handleStorageSave(const GPEvent* e) {
 	saveRequested = true;
-	forceSave = ((GPStorageSaveEvent*)e)->forceSave;
-	rebootRequested = ((GPStorageSaveEvent*)e)->restartAfterSave;
+	forceSave = ((const GPStorageSaveEvent*)e)->forceSave;
+	rebootRequested = ((const GPStorageSaveEvent*)e)->restartAfterSave;
 	rebootMode = System::BootMode::DEFAULT;
 }
 
-void GP2040::handleSystemReboot(GPEvent* e) {
+void GP2040::handleSystemReboot(const GPEvent* e) {
 	rebootRequested = true;
-	rebootMode = ((GPRestartEvent*)e)->bootMode;
+	rebootMode = ((const GPRestartEvent*)e)->bootMode;
 }
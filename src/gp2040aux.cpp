@@ -3,6 +3,10 @@
 #include "gamepad.h"
 
 #include "drivermanager.h"
+#include "eventmanager.h"
+#include "bootprofile.h"
+#include "config_utils.h"
+#include "loopstats.h"
 #include "storagemanager.h"
 #include "usbhostmanager.h"
 
@@ -25,6 +29,9 @@ GP2040Aux::~GP2040Aux() {
 // GP2040Aux will always come after GP2040 setup(), so we can rely on the
 // GP2040 setup function for certain setup functions.
 void GP2040Aux::setup() {
+	// The display and LED add-ons are the first to need the config sections left out at boot
+	Storage::getInstance().loadDeferredConfig();
+
 	// Initialize our input driver's auxilliary functions
 	inputDriver = DriverManager::getInstance().getDriver();
 	if ( inputDriver != nullptr ) {
@@ -46,19 +53,41 @@ void GP2040Aux::setup() {
 	addons.LoadAddon(new DRV8833RumbleAddon());
 	addons.LoadAddon(new ReactiveLEDAddon());
 
+	BootProfile::mark(BOOT_PHASE_CORE1_SETUP);
+
 	// Ready to sync Core0 and Core1
 	isReady = true;
 }
 
 void GP2040Aux::run() {
+	// The display is set up by now, so it can show that its own settings were lost
+	if (ConfigUtils::loadDeferredFailed())
+		EventManager::getInstance().triggerEvent(GPSystemErrorEvent("Display/LED settings unreadable, using defaults"));
+
+	LOOP_STATS_INIT(1);
+
 	while (1) {
+		LOOP_STATS_BEGIN(1);
+
+		// Run our handlers for events raised on core0
+		EventManager::getInstance().processEvents();
+
+		// Take a coherent copy of the state core0 last published
+		Storage::getInstance().UpdateSnapshotGamepad();
+		LOOP_STATS_MARK(LOOP_PHASE_CORE1_EVENTS);
+
 		// Pre, Process, and Post
 		addons.PreprocessAddons();
+		LOOP_STATS_MARK(LOOP_PHASE_CORE1_PREPROCESS_ADDONS);
 		addons.ProcessAddons();
+		LOOP_STATS_MARK(LOOP_PHASE_CORE1_PROCESS_ADDONS);
 
 		// Run auxiliary functions for input driver on Core1
 		if ( inputDriver != nullptr ) {
 			inputDriver->processAux();
 		}
+		LOOP_STATS_MARK(LOOP_PHASE_CORE1_DRIVER_AUX);
+
+		LOOP_STATS_END(1);
 	}
 }
@@ -0,0 +1,134 @@
+#include "gpioedges.h"
+
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/structs/io_bank0.h"
+#include "pico/platform.h"
+#include "pico/time.h"
+
+#define GPIO_EDGES_EVENTS (GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE)
+
+// Button pins are a Mask_t, eight pins per interrupt register
+#define GPIO_EDGES_WORDS 4
+
+struct GpioEdge {
+    Mask_t pins;
+    Mask_t bounced;
+    uint32_t timeUs;
+};
+
+static bool edgesEnabled = false;
+static Mask_t irqPins = 0;
+static uint32_t edgeEvents[GPIO_EDGES_WORDS];   // the edge event bits of irqPins, per register
+
+static GpioEdge ring[GPIO_EDGES_SIZE];
+static volatile uint32_t ringHead = 0;          // written by the handler only
+static volatile uint32_t ringTail = 0;          // written by the loop only
+static volatile bool overflowed = false;
+
+// Bit 0 of each pin's four event bits to one bit per pin
+static inline uint32_t pinsOfWord(uint32_t nibbles) {
+    nibbles = (nibbles | (nibbles >> 3)) & 0x03030303;
+    nibbles = (nibbles | (nibbles >> 6)) & 0x000F000F;
+    return (nibbles | (nibbles >> 12)) & 0xFF;
+}
+
+static void __not_in_flash_func(edgeHandler)() {
+    uint32_t nowUs = time_us_32();
+
+    Mask_t pins = 0;
+    Mask_t bounced = 0;
+    for (uint8_t word = 0; word < GPIO_EDGES_WORDS; word++) {
+        uint32_t events = io_bank0_hw->proc0_irq_ctrl.ints[word] & edgeEvents[word];
+        if (events == 0)
+            continue;
+        io_bank0_hw->intr[word] = events;
+
+        // the fall bit of each pin is bit 2, rise is bit 3
+        pins |= pinsOfWord(((events | (events >> 1)) >> 2) & 0x11111111) << (word * 8);
+        bounced |= pinsOfWord(((events & (events >> 1)) >> 2) & 0x11111111) << (word * 8);
+    }
+
+    if (pins == 0)
+        return;
+
+    uint32_t head = ringHead;
+    if (head - ringTail >= GPIO_EDGES_SIZE) {
+        overflowed = true;
+        return;
+    }
+    ring[head & (GPIO_EDGES_SIZE - 1)] = {pins, bounced, nowUs};
+    ringHead = head + 1;
+}
+
+void GpioEdges::setup(bool enabled) {
+    edgesEnabled = enabled;
+}
+
+bool GpioEdges::isEnabled() {
+    return edgesEnabled;
+}
+
+void GpioEdges::setPins(Mask_t pins) {
+    if (!edgesEnabled || pins == irqPins)
+        return;
+
+    if (irqPins != 0) {
+        for (Pin_t pin = 0; pin < (Pin_t)NUM_BANK0_GPIOS; pin++) {
+            if (irqPins & (1 << pin))
+                gpio_set_irq_enabled(pin, GPIO_EDGES_EVENTS, false);
+        }
+        gpio_remove_raw_irq_handler_masked(irqPins, edgeHandler);
+    }
+
+    irqPins = pins;
+    for (uint8_t word = 0; word < GPIO_EDGES_WORDS; word++) {
+        edgeEvents[word] = 0;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            if (pins & (1 << (word * 8 + bit)))
+                edgeEvents[word] |= GPIO_EDGES_EVENTS << (bit * 4);
+        }
+    }
+
+    if (pins != 0) {
+        gpio_add_raw_irq_handler_masked(pins, edgeHandler);
+        for (Pin_t pin = 0; pin < (Pin_t)NUM_BANK0_GPIOS; pin++) {
+            if (pins & (1 << pin))
+                gpio_set_irq_enabled(pin, GPIO_EDGES_EVENTS, true);
+        }
+        irq_set_enabled(IO_IRQ_BANK0, true);
+    }
+}
+
+bool GpioEdges::pending(uint32_t& firstUs) {
+    uint32_t tail = ringTail;
+    if (ringHead == tail)
+        return false;
+    firstUs = ring[tail & (GPIO_EDGES_SIZE - 1)].timeUs;
+    return true;
+}
+
+bool GpioEdges::read(GpioEdgeBatch& batch) {
+    batch = {};
+
+    uint32_t head = ringHead;
+    uint32_t tail = ringTail;
+    if (head == tail)
+        return false;
+
+    for (; tail != head; tail++) {
+        const GpioEdge& edge = ring[tail & (GPIO_EDGES_SIZE - 1)];
+        if (batch.pins == 0)
+            batch.firstUs = edge.timeUs;
+        batch.lastUs = edge.timeUs;
+        batch.bounced |= edge.bounced | (batch.pins & edge.pins);
+        batch.pins |= edge.pins;
+    }
+    ringTail = tail;
+
+    if (overflowed) {
+        overflowed = false;
+        batch.overflowed = true;
+    }
+    return true;
+}
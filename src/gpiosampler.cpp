@@ -0,0 +1,98 @@
+#include "gpiosampler.h"
+
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/pio.h"
+#include "gpiosampler.pio.h"
+
+/**
+ * @brief Claim a free state machine, from the last one of the last PIO down.
+ *
+ * NeoPico drives PIO0:0 without claiming it, and PIO USB claims fixed state machines from the
+ * bottom of each PIO, so the top ones are the least likely to be wanted later.
+ */
+static bool claimStateMachine(PIO& pio, uint& sm, uint& offset) {
+    for (int index = NUM_PIOS - 1; index >= 0; index--) {
+        PIO candidate = pio_get_instance(index);
+        if (!pio_can_add_program(candidate, &gpio_sampler_program))
+            continue;
+        for (int candidateSm = NUM_PIO_STATE_MACHINES - 1; candidateSm >= 0; candidateSm--) {
+            if (pio_sm_is_claimed(candidate, candidateSm))
+                continue;
+            pio_sm_claim(candidate, candidateSm);
+            pio = candidate;
+            sm = candidateSm;
+            offset = pio_add_program(candidate, &gpio_sampler_program);
+            return true;
+        }
+    }
+    return false;
+}
+
+// PIO USB claims its fixed channel from the bottom too
+static int claimDmaChannel() {
+    for (int channel = NUM_DMA_CHANNELS - 1; channel >= 0; channel--) {
+        if (!dma_channel_is_claimed(channel)) {
+            dma_channel_claim(channel);
+            return channel;
+        }
+    }
+    return -1;
+}
+
+bool GpioSampler::start() {
+    if (running)
+        return true;
+
+    int data = claimDmaChannel();
+    if (data < 0)
+        return false;
+    int control = claimDmaChannel();
+    if (control < 0) {
+        dma_channel_unclaim(data);
+        return false;
+    }
+
+    PIO pio;
+    uint sm, offset;
+    if (!claimStateMachine(pio, sm, offset)) {
+        dma_channel_unclaim(data);
+        dma_channel_unclaim(control);
+        return false;
+    }
+    dataChannel = data;
+    controlChannel = control;
+
+    // released until the first samples come in
+    for (uint32_t i = 0; i < GPIO_SAMPLER_RING_SIZE; i++)
+        samples[i] = ~0U;
+    ringStart = samples;
+
+    dma_channel_config dataConfig = dma_channel_get_default_config(dataChannel);
+    channel_config_set_transfer_data_size(&dataConfig, DMA_SIZE_32);
+    channel_config_set_read_increment(&dataConfig, false);
+    channel_config_set_write_increment(&dataConfig, true);
+    channel_config_set_dreq(&dataConfig, pio_get_dreq(pio, sm, false));
+    channel_config_set_chain_to(&dataConfig, controlChannel);
+    dma_channel_configure(dataChannel, &dataConfig, samples, &pio->rxf[sm], GPIO_SAMPLER_RING_SIZE, false);
+
+    // writes the start of the ring back into the data channel, which triggers it again
+    dma_channel_config controlConfig = dma_channel_get_default_config(controlChannel);
+    channel_config_set_transfer_data_size(&controlConfig, DMA_SIZE_32);
+    channel_config_set_read_increment(&controlConfig, false);
+    channel_config_set_write_increment(&controlConfig, false);
+    dma_channel_configure(controlChannel, &controlConfig, &dma_hw->ch[dataChannel].al2_write_addr_trig,
+        &ringStart, 1, false);
+
+    gpio_sampler_program_init(pio, sm, offset, (float)clock_get_hz(clk_sys) / GPIO_SAMPLER_RATE_HZ);
+    dma_channel_start(dataChannel);
+    pio_sm_set_enabled(pio, sm, true);
+
+    running = true;
+    return true;
+}
+
+Mask_t GpioSampler::read() const {
+    uint32_t head = headOf(dma_hw->ch[dataChannel].write_addr, (uintptr_t)samples);
+    return majority(samples, head, GPIO_SAMPLER_VOTES);
+}
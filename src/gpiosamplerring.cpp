@@ -0,0 +1,41 @@
+#include "gpiosampler.h"
+
+// The ring indexing and the vote, apart from the hardware so the host build can run them
+
+uint32_t GpioSampler::headOf(uintptr_t writeAddress, uintptr_t ringAddress) {
+    // between the end of the ring and the restart, the write address is one past the end
+    return ((writeAddress - ringAddress) / sizeof(uint32_t)) & (GPIO_SAMPLER_RING_SIZE - 1);
+}
+
+/**
+ * @brief Count the high samples of every pin at once in vertical counters, then compare every
+ * counter against more than half of the votes.
+ */
+Mask_t GpioSampler::majority(const volatile uint32_t* ring, uint32_t head, uint8_t votes) {
+    if (votes > GPIO_SAMPLER_MAX_VOTES)
+        votes = GPIO_SAMPLER_MAX_VOTES;
+
+    Mask_t counter[GPIO_SAMPLER_COUNTER_BITS] = {};
+    for (uint8_t vote = 1; vote <= votes; vote++) {
+        Mask_t carry = ring[(head - vote) & (GPIO_SAMPLER_RING_SIZE - 1)];
+        for (uint8_t plane = 0; plane < GPIO_SAMPLER_COUNTER_BITS; plane++) {
+            Mask_t next = counter[plane] ^ carry;
+            carry &= counter[plane];
+            counter[plane] = next;
+        }
+    }
+
+    // counter >= threshold, from the most significant plane down
+    const uint32_t threshold = votes / 2 + 1;
+    Mask_t greater = 0;
+    Mask_t equal = ~0U;
+    for (int plane = GPIO_SAMPLER_COUNTER_BITS - 1; plane >= 0; plane--) {
+        if (threshold & (1 << plane)) {
+            equal &= counter[plane];
+        } else {
+            greater |= equal & counter[plane];
+            equal &= ~counter[plane];
+        }
+    }
+    return greater | equal;
+}
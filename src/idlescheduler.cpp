@@ -0,0 +1,27 @@
+#include "idlescheduler.h"
+
+void IdleScheduler::setup(bool enabled) {
+    this->enabled = enabled;
+    stableLoops = 0;
+}
+
+void IdleScheduler::onLoop(bool inputsChanged) {
+    if (inputsChanged)
+        stableLoops = 0;
+    else if (stableLoops < IDLE_STABLE_LOOPS)
+        stableLoops++;
+}
+
+uint32_t IdleScheduler::wakeTime(uint32_t nowUs, uint32_t sampleUs) const {
+    if (!canSleep())
+        return nowUs;
+
+    // free running, nothing to wait for but the inputs that aren't interrupt driven
+    int32_t untilSampleUs = (int32_t)(sampleUs - nowUs);
+    if (untilSampleUs <= 0)
+        return nowUs + IDLE_MAX_SLEEP_US;
+
+    if (untilSampleUs <= (int32_t)IDLE_WAKE_GUARD_US)
+        return nowUs;
+    return sampleUs - IDLE_WAKE_GUARD_US;
+}
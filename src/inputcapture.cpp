@@ -0,0 +1,58 @@
+#include "inputcapture.h"
+
+#include "pico/platform.h"
+#include "pico/time.h"
+
+#if GP2040_INPUT_CAPTURE
+
+static InputCaptureRing __uninitialized_ram(captureRing);
+static InputCaptureWriter writer;
+static bool recording = false;
+
+void InputCapture::init(InputMode inputMode) {
+    // web config doesn't run the input pipeline, keep what the last session recorded
+    recording = inputMode != INPUT_MODE_CONFIG;
+    if (recording)
+        writer.begin(captureRing);
+    else if (!captureRing.isValid())
+        captureRing.clear();
+}
+
+void InputCapture::gpio(uint32_t debouncedGpio, uint32_t nowUs) {
+    if (recording)
+        writer.gpio(debouncedGpio, nowUs);
+}
+
+void InputCapture::adc(uint8_t source, uint16_t value) {
+    if (recording)
+        writer.adc(source, value, time_us_32());
+}
+
+void InputCapture::report(uint8_t devAddr, uint8_t instance, const uint8_t* report, uint16_t len) {
+    if (recording)
+        writer.report(devAddr, instance, report, len, time_us_32());
+}
+
+uint32_t InputCapture::getCount() {
+    return captureRing.getCount();
+}
+
+size_t InputCapture::getEncodedSize() {
+    return captureRing.getBase64Size();
+}
+
+void InputCapture::encode(std::string& out) {
+    captureRing.appendBase64(out);
+}
+
+#else
+
+void InputCapture::init(InputMode inputMode) {}
+void InputCapture::gpio(uint32_t debouncedGpio, uint32_t nowUs) {}
+void InputCapture::adc(uint8_t source, uint16_t value) {}
+void InputCapture::report(uint8_t devAddr, uint8_t instance, const uint8_t* report, uint16_t len) {}
+uint32_t InputCapture::getCount() { return 0; }
+size_t InputCapture::getEncodedSize() { return 0; }
+void InputCapture::encode(std::string& out) {}
+
+#endif
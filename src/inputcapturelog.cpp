@@ -0,0 +1,239 @@
+#include "inputcapturelog.h"
+
+#include <cstring>
+
+static const char base64Table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+void InputCaptureRing::clear() {
+    memset(this, 0, sizeof(*this));
+    magic = INPUT_CAPTURE_MAGIC;
+    version = INPUT_CAPTURE_VERSION;
+}
+
+uint32_t InputCaptureRing::getCount() const {
+    return head < INPUT_CAPTURE_SIZE ? head : INPUT_CAPTURE_SIZE;
+}
+
+uint32_t InputCaptureRing::getFirst(uint32_t& count) const {
+    count = getCount();
+    uint32_t first = head - count;
+
+    // a report cut by the ring wrapping can't be decoded, start at the next whole record
+    while (count > 0 && records[first & (INPUT_CAPTURE_SIZE - 1)].type == INPUT_CAPTURE_REPORT_DATA) {
+        first++;
+        count--;
+    }
+    return first;
+}
+
+size_t InputCaptureRing::getBase64Size() const {
+    uint32_t count;
+    getFirst(count);
+    return 4 * ((count * sizeof(InputCaptureRecord) + 2) / 3);
+}
+
+void InputCaptureRing::appendBase64(std::string& out) const {
+    uint32_t count;
+    uint32_t first = getFirst(count);
+    out.reserve(out.size() + getBase64Size());
+
+    // records don't line up with the 3 byte groups, carry the bytes left over to the next one
+    uint32_t group = 0;
+    uint8_t grouped = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&records[(first + i) & (INPUT_CAPTURE_SIZE - 1)]);
+        for (uint8_t b = 0; b < sizeof(InputCaptureRecord); b++) {
+            group = (group << 8) | bytes[b];
+            if (++grouped == 3) {
+                out.push_back(base64Table[(group >> 18) & 0x3F]);
+                out.push_back(base64Table[(group >> 12) & 0x3F]);
+                out.push_back(base64Table[(group >> 6) & 0x3F]);
+                out.push_back(base64Table[group & 0x3F]);
+                group = 0;
+                grouped = 0;
+            }
+        }
+    }
+
+    if (grouped > 0) {
+        group <<= 8 * (3 - grouped);
+        out.push_back(base64Table[(group >> 18) & 0x3F]);
+        out.push_back(base64Table[(group >> 12) & 0x3F]);
+        out.push_back(grouped == 2 ? base64Table[(group >> 6) & 0x3F] : '=');
+        out.push_back('=');
+    }
+}
+
+void InputCaptureWriter::begin(InputCaptureRing& ring) {
+    this->ring = &ring;
+    ring.clear();
+    gpioRecorded = false;
+    memset(lastAdc, 0xFF, sizeof(lastAdc));
+    memset(sources, 0, sizeof(sources));
+    nextSource = 0;
+}
+
+InputCaptureRecord& InputCaptureWriter::nextRecord(uint32_t nowUs, uint8_t type, uint8_t info) {
+    InputCaptureRecord& record = ring->records[ring->head & (INPUT_CAPTURE_SIZE - 1)];
+    record.timeUs = nowUs;
+    record.sequence = ring->head;
+    record.type = type;
+    record.info = info;
+    memset(record.data, 0, sizeof(record.data));
+    ring->head++;
+    return record;
+}
+
+void InputCaptureWriter::gpio(uint32_t debouncedGpio, uint32_t nowUs) {
+    if (gpioRecorded && debouncedGpio == lastGpio)
+        return;
+
+    InputCaptureRecord& record = nextRecord(nowUs, INPUT_CAPTURE_GPIO, 0);
+    memcpy(record.data, &debouncedGpio, sizeof(debouncedGpio));
+    lastGpio = debouncedGpio;
+    gpioRecorded = true;
+}
+
+void InputCaptureWriter::adc(uint8_t source, uint16_t value, uint32_t nowUs) {
+    if (lastAdc[source] == value)
+        return;
+
+    InputCaptureRecord& record = nextRecord(nowUs, INPUT_CAPTURE_ADC, source);
+    memcpy(record.data, &value, sizeof(value));
+    lastAdc[source] = value;
+}
+
+void InputCaptureWriter::report(uint8_t devAddr, uint8_t instance, const uint8_t* report, uint16_t len, uint32_t nowUs) {
+    const uint16_t recordedLen = len < INPUT_CAPTURE_REPORT_MAX ? len : INPUT_CAPTURE_REPORT_MAX;
+
+    InputCaptureReportSource* source = nullptr;
+    for (InputCaptureReportSource& candidate : sources) {
+        if (candidate.used && candidate.devAddr == devAddr && candidate.instance == instance) {
+            source = &candidate;
+            break;
+        }
+    }
+
+    bool whole;
+    if (source == nullptr) {
+        // a new device takes the place of the one that came first
+        source = &sources[nextSource];
+        nextSource = (nextSource + 1) % INPUT_CAPTURE_REPORT_SOURCES;
+        source->used = true;
+        source->devAddr = devAddr;
+        source->instance = instance;
+        whole = true;
+    } else if (source->length != len) {
+        whole = true;
+    } else if (memcmp(source->data, report, recordedLen) == 0) {
+        return;
+    } else {
+        whole = source->sinceWhole + 1 >= INPUT_CAPTURE_REPORT_KEY_INTERVAL;
+    }
+
+    uint8_t parts = 0;
+    for (uint16_t offset = 0; offset < recordedLen; offset += INPUT_CAPTURE_REPORT_PART) {
+        const uint16_t partLen = recordedLen - offset < INPUT_CAPTURE_REPORT_PART ? recordedLen - offset : INPUT_CAPTURE_REPORT_PART;
+        if (whole || memcmp(source->data + offset, report + offset, partLen) != 0)
+            parts |= 1 << (offset / INPUT_CAPTURE_REPORT_PART);
+    }
+
+    InputCaptureRecord& header = nextRecord(nowUs, INPUT_CAPTURE_REPORT, devAddr);
+    header.data[0] = instance;
+    memcpy(&header.data[1], &len, sizeof(len));
+    header.data[3] = parts;
+    header.data[4] = whole ? INPUT_CAPTURE_REPORT_WHOLE : 0;
+
+    for (uint16_t offset = 0; offset < recordedLen; offset += INPUT_CAPTURE_REPORT_PART) {
+        const uint8_t part = offset / INPUT_CAPTURE_REPORT_PART;
+        if (!(parts & (1 << part)))
+            continue;
+        InputCaptureRecord& record = nextRecord(nowUs, INPUT_CAPTURE_REPORT_DATA, part);
+        const uint16_t partLen = recordedLen - offset < INPUT_CAPTURE_REPORT_PART ? recordedLen - offset : INPUT_CAPTURE_REPORT_PART;
+        memcpy(record.data, report + offset, partLen);
+    }
+
+    if (whole)
+        memset(source->data, 0, sizeof(source->data));
+    memcpy(source->data, report, recordedLen);
+    source->length = len;
+    source->sinceWhole = whole ? 0 : source->sinceWhole + 1;
+}
+
+InputCaptureReader::InputCaptureReader(const InputCaptureRecord* records, uint32_t count) :
+    records(records), count(count) {
+}
+
+InputCaptureReportSource* InputCaptureReader::sourceOf(uint8_t devAddr, uint8_t instance, bool add) {
+    for (InputCaptureReportSource& source : sources) {
+        if (source.used && source.devAddr == devAddr && source.instance == instance)
+            return &source;
+    }
+    if (!add)
+        return nullptr;
+
+    // the same order the writer replaces them in
+    InputCaptureReportSource* source = &sources[nextSource];
+    nextSource = (nextSource + 1) % INPUT_CAPTURE_REPORT_SOURCES;
+    source->used = true;
+    source->devAddr = devAddr;
+    source->instance = instance;
+    return source;
+}
+
+bool InputCaptureReader::next(InputCaptureEvent& event) {
+    while (index < count) {
+        const InputCaptureRecord& record = records[index];
+        if (index > 0 && (uint16_t)(records[index - 1].sequence + 1) != record.sequence)
+            gaps++;
+        index++;
+
+        event.timeUs = record.timeUs;
+        event.type = record.type;
+        event.source = record.info;
+        event.instance = 0;
+        event.length = 0;
+        event.value = 0;
+        event.report = nullptr;
+
+        switch (record.type) {
+            case INPUT_CAPTURE_GPIO:
+                memcpy(&event.value, record.data, sizeof(uint32_t));
+                return true;
+            case INPUT_CAPTURE_ADC: {
+                uint16_t value;
+                memcpy(&value, record.data, sizeof(value));
+                event.value = value;
+                return true;
+            }
+            case INPUT_CAPTURE_REPORT: {
+                event.instance = record.data[0];
+                memcpy(&event.length, &record.data[1], sizeof(event.length));
+                const uint8_t parts = record.data[3];
+                const bool whole = record.data[4] & INPUT_CAPTURE_REPORT_WHOLE;
+
+                InputCaptureReportSource* source = sourceOf(record.info, event.instance, whole);
+                if (source != nullptr && whole)
+                    memset(source->data, 0, sizeof(source->data));
+
+                while (index < count && records[index].type == INPUT_CAPTURE_REPORT_DATA) {
+                    const InputCaptureRecord& part = records[index++];
+                    if (source != nullptr && (parts & (1 << part.info)) && part.info < INPUT_CAPTURE_REPORT_MAX / INPUT_CAPTURE_REPORT_PART)
+                        memcpy(source->data + part.info * INPUT_CAPTURE_REPORT_PART, part.data, INPUT_CAPTURE_REPORT_PART);
+                }
+
+                if (source == nullptr) {
+                    skippedReports++;
+                    continue;
+                }
+                source->length = event.length;
+                event.report = source->data;
+                return true;
+            }
+            default:
+                // a part without its report, from the ring wrapping
+                continue;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,95 @@
+#include "latencytrace.h"
+
+#include <cstring>
+#include "base64.h"
+#include "pico/platform.h"
+
+#define LATENCY_TRACE_MAGIC 0x4C544E43 // LTNC
+
+struct LatencyTraceRing {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t head;      // total samples written, wraps
+    LatencySample samples[LATENCY_TRACE_SIZE];
+};
+
+static LatencyTraceRing __uninitialized_ram(traceRing);
+
+static uint8_t currentInputMode = 0;
+static bool rawPending = false;
+static uint32_t rawEdgeUs = 0;
+static bool edgePending = false;
+static LatencySample pendingSample;
+static uint32_t pendingEdgeUs = 0;
+
+void LatencyTrace::init(InputMode inputMode) {
+    currentInputMode = inputMode;
+
+    bool valid = traceRing.magic == LATENCY_TRACE_MAGIC && traceRing.version == LATENCY_TRACE_VERSION;
+    if (!valid || inputMode != INPUT_MODE_CONFIG) {
+        memset(&traceRing, 0, sizeof(traceRing));
+        traceRing.magic = LATENCY_TRACE_MAGIC;
+        traceRing.version = LATENCY_TRACE_VERSION;
+    }
+}
+
+void LatencyTrace::rawEdge(uint32_t nowUs) {
+    if (!rawPending) {
+        rawPending = true;
+        rawEdgeUs = nowUs;
+    }
+}
+
+void LatencyTrace::rawSettled() {
+    rawPending = false;
+}
+
+void LatencyTrace::inputEdge(Mask_t pressed, uint32_t nowUs) {
+    uint32_t edgeUs = rawPending ? rawEdgeUs : nowUs;
+    rawPending = false;
+
+    // the report will carry every edge so far, but only the oldest is timed
+    if (edgePending) {
+        pendingSample.flags |= LATENCY_SAMPLE_COALESCED;
+        if (pressed)
+            pendingSample.flags |= LATENCY_SAMPLE_PRESS;
+        return;
+    }
+
+    uint32_t debounceUs = nowUs - edgeUs;
+    pendingSample.edgeUs = edgeUs;
+    pendingSample.debounceUs = debounceUs > UINT16_MAX ? UINT16_MAX : debounceUs;
+    pendingSample.inputMode = currentInputMode;
+    pendingSample.flags = pressed ? LATENCY_SAMPLE_PRESS : 0;
+    pendingEdgeUs = nowUs;
+    edgePending = true;
+}
+
+void LatencyTrace::reportSent(uint32_t nowUs) {
+    if (!edgePending)
+        return;
+
+    uint32_t reportUs = nowUs - pendingEdgeUs;
+    pendingSample.reportUs = reportUs > UINT16_MAX ? UINT16_MAX : reportUs;
+    pendingSample.sequence = traceRing.head;
+    traceRing.samples[traceRing.head & (LATENCY_TRACE_SIZE - 1)] = pendingSample;
+    traceRing.head++;
+    edgePending = false;
+}
+
+uint32_t LatencyTrace::getCount() {
+    return traceRing.head < LATENCY_TRACE_SIZE ? traceRing.head : LATENCY_TRACE_SIZE;
+}
+
+std::string LatencyTrace::encode() {
+    uint32_t count = getCount();
+    uint32_t first = traceRing.head - count;
+
+    std::string data;
+    data.reserve(count * sizeof(LatencySample));
+    for (uint32_t i = 0; i < count; i++) {
+        const LatencySample& sample = traceRing.samples[(first + i) & (LATENCY_TRACE_SIZE - 1)];
+        data.append(reinterpret_cast<const char*>(&sample), sizeof(LatencySample));
+    }
+    return Base64::Encode(data);
+}
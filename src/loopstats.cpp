@@ -0,0 +1,232 @@
+#include "loopstats.h"
+
+#include <cstring>
+
+#include "pico/platform.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+#include "hardware/timer.h"
+
+#define LOOPSTATS_TIMER_MASK ((1U << LOOPSTATS_TIMER_BITS) - 1)
+#define LOOPSTATS_MAGIC 0x5453504C // LPST
+#define LOOPSTATS_NUM_CORES 2
+
+static const char* const phaseNames[LOOP_PHASE_COUNT] = {
+    "core0 loop",
+    "events",
+    "sof wait",
+    "debounce",
+    "read",
+    "usb host",
+    "preprocess",
+    "hotkey",
+    "process",
+    "addons",
+    "driver",
+    "tud_task",
+    "postprocess",
+    "edge gain",
+    "idle",
+    "wake latency",
+    "core1 loop",
+    "events",
+    "preprocess",
+    "addons",
+    "driver aux",
+};
+
+const char* LoopStats::getPhaseName(LoopPhase phase) {
+    return phase < LOOP_PHASE_COUNT ? phaseNames[phase] : "";
+}
+
+#if GP2040_LOOP_STATS
+
+struct PhaseHistogram {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t buckets[LOOPSTATS_NUM_BUCKETS];
+};
+
+struct LoopStatsStore {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t clockMhz;  // of the boot that recorded them
+    PhaseHistogram histograms[LOOP_PHASE_COUNT];
+};
+
+static LoopStatsStore __uninitialized_ram(store);
+static PhaseHistogram* const histograms = store.histograms;
+
+// SysTick and microsecond timer readings at the start of the loop and the last mark, per core
+struct PhaseStart {
+    uint32_t cycles;
+    uint32_t us;
+};
+
+static PhaseStart loopStart[LOOPSTATS_NUM_CORES];
+static PhaseStart lastMark[LOOPSTATS_NUM_CORES];
+static uint32_t sampleClockMhz = 1; // converts microseconds into cycles
+static uint32_t systickRangeUs = 1;  // phases this long are timed in microseconds
+static bool recording = true;
+static bool previousBoot = false;
+
+static inline uint32_t bucketIndex(uint32_t cycles) {
+    if (cycles < (1U << LOOPSTATS_SUB_BUCKET_BITS))
+        return cycles;
+    uint32_t msb = 31 - __builtin_clz(cycles);
+    uint32_t sub = (cycles >> (msb - LOOPSTATS_SUB_BUCKET_BITS)) & ((1U << LOOPSTATS_SUB_BUCKET_BITS) - 1);
+    return ((msb - 1) << LOOPSTATS_SUB_BUCKET_BITS) + sub;
+}
+
+// Smallest cycle count that falls into the bucket after this one
+static uint64_t bucketLimit(uint32_t index) {
+    index++;
+    if (index < (1U << LOOPSTATS_SUB_BUCKET_BITS))
+        return index;
+    uint32_t msb = (index >> LOOPSTATS_SUB_BUCKET_BITS) + 1;
+    uint32_t sub = index & ((1U << LOOPSTATS_SUB_BUCKET_BITS) - 1);
+    return (uint64_t)((1U << LOOPSTATS_SUB_BUCKET_BITS) + sub) << (msb - LOOPSTATS_SUB_BUCKET_BITS);
+}
+
+static inline uint32_t usToCycles(uint32_t us) {
+    uint64_t cycles = (uint64_t)us * sampleClockMhz;
+    return cycles > UINT32_MAX ? UINT32_MAX : cycles;
+}
+
+static inline void record(LoopPhase phase, uint32_t cycles) {
+    if (!recording)
+        return;
+
+    PhaseHistogram& histogram = histograms[phase];
+    if (histogram.count == 0 || cycles < histogram.min)
+        histogram.min = cycles;
+    if (cycles > histogram.max)
+        histogram.max = cycles;
+    histogram.sum += cycles;
+    histogram.count++;
+    histogram.buckets[bucketIndex(cycles)]++;
+}
+
+static inline PhaseStart now() {
+    return { systick_hw->cvr, timer_hw->timerawl };
+}
+
+// SysTick counts down and wraps every 2^24 cycles. Anything longer than half of that is taken from
+// the microsecond timer instead, at a microsecond's resolution.
+static inline uint32_t elapsedSince(const PhaseStart& start, const PhaseStart& now) {
+    uint32_t us = now.us - start.us;
+    if (us >= systickRangeUs)
+        return usToCycles(us);
+    return (start.cycles - now.cycles) & LOOPSTATS_TIMER_MASK;
+}
+
+static inline uint32_t cyclesToNs(uint64_t cycles, uint32_t clockMhz) {
+    uint64_t ns = cycles * 1000 / clockMhz;
+    return ns > UINT32_MAX ? UINT32_MAX : ns;
+}
+
+void LoopStats::init(InputMode inputMode) {
+    sampleClockMhz = clock_get_hz(clk_sys) / 1000000;
+    systickRangeUs = (LOOPSTATS_TIMER_MASK >> 1) / sampleClockMhz;
+
+    bool valid = store.magic == LOOPSTATS_MAGIC && store.version == LOOPSTATS_VERSION;
+    previousBoot = valid && inputMode == INPUT_MODE_CONFIG;
+    recording = !previousBoot;
+    if (!previousBoot)
+        reset();
+}
+
+bool LoopStats::isPreviousBoot() {
+    return previousBoot;
+}
+
+void LoopStats::initCore(uint8_t core) {
+    systick_hw->csr = 0;
+    systick_hw->rvr = LOOPSTATS_TIMER_MASK;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // enabled, processor clock, no interrupt
+    lastMark[core] = loopStart[core] = now();
+}
+
+void LoopStats::begin(uint8_t core) {
+    lastMark[core] = loopStart[core] = now();
+}
+
+void LoopStats::mark(LoopPhase phase) {
+    PhaseStart time = now();
+    uint8_t core = (phase >= LOOP_PHASE_CORE1_LOOP) ? 1 : 0;
+    record(phase, elapsedSince(lastMark[core], time));
+    lastMark[core] = time;
+}
+
+void LoopStats::end(uint8_t core) {
+    PhaseStart time = now();
+    record(core == 0 ? LOOP_PHASE_CORE0_LOOP : LOOP_PHASE_CORE1_LOOP, elapsedSince(loopStart[core], time));
+}
+
+void LoopStats::sampleUs(LoopPhase phase, uint32_t us) {
+    record(phase, usToCycles(us));
+}
+
+void LoopStats::reset() {
+    memset(&store, 0, sizeof(store));
+    store.magic = LOOPSTATS_MAGIC;
+    store.version = LOOPSTATS_VERSION;
+    store.clockMhz = sampleClockMhz;
+    previousBoot = false;
+    recording = true;
+}
+
+bool LoopStats::getSummary(LoopPhase phase, LoopPhaseSummary& summary) {
+    summary = {};
+    if (phase >= LOOP_PHASE_COUNT)
+        return false;
+
+    // the owning core may record while we read, close enough for statistics
+    const PhaseHistogram& histogram = histograms[phase];
+    uint32_t count = histogram.count;
+    if (count == 0)
+        return true;
+
+    uint32_t target = count - count / 100;
+    uint32_t seen = 0;
+    uint64_t p99 = histogram.max;
+    for (uint32_t index = 0; index < LOOPSTATS_NUM_BUCKETS; index++) {
+        seen += histogram.buckets[index];
+        if (seen >= target) {
+            p99 = bucketLimit(index);
+            break;
+        }
+    }
+    if (p99 > histogram.max)
+        p99 = histogram.max;
+
+    // the stats of the previous boot were counted at its clock
+    const uint32_t clockMhz = store.clockMhz ? store.clockMhz : 1;
+    summary.count = count;
+    summary.minNs = cyclesToNs(histogram.min, clockMhz);
+    summary.avgNs = cyclesToNs(histogram.sum / count, clockMhz);
+    summary.p99Ns = cyclesToNs(p99, clockMhz);
+    summary.maxNs = cyclesToNs(histogram.max, clockMhz);
+    return true;
+}
+
+#else
+
+void LoopStats::init(InputMode inputMode) {}
+bool LoopStats::isPreviousBoot() { return false; }
+void LoopStats::initCore(uint8_t core) {}
+void LoopStats::begin(uint8_t core) {}
+void LoopStats::mark(LoopPhase phase) {}
+void LoopStats::end(uint8_t core) {}
+void LoopStats::sampleUs(LoopPhase phase, uint32_t us) {}
+void LoopStats::reset() {}
+
+bool LoopStats::getSummary(LoopPhase phase, LoopPhaseSummary& summary) {
+    summary = {};
+    return false;
+}
+
+#endif
@@ -9,6 +9,7 @@
 // GP2040 includes
 #include "gp2040.h"
 #include "gp2040aux.h"
+#include "bootprofile.h"
 
 #include <cstdlib>
 
@@ -33,6 +34,8 @@ void core1() {
 }
 
 int main() {
+	BootProfile::init();
+
 	// Create GP2040 Main Core (core0), Core1 is dependent on Core0
 	gp2040Core0 = new GP2040();
 	gp2040Core1 = new GP2040Aux();
@@ -43,9 +46,12 @@ int main() {
 	// Create GP2040 Thread for Core1
 	multicore_launch_core1(core1);
 
+	// Enumerate while Core1 sets up its add-ons, only the loops need to wait for each other
+	gp2040Core0->startUSB();
+
 	// Sync Core0 and Core1
 	while(gp2040Core1->ready() == false ) {
-		__asm volatile ("nop\n");
+		gp2040Core0->serviceUSB();
 	}
 	gp2040Core0->run();
 
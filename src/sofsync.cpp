@@ -0,0 +1,158 @@
+#include "sofsync.h"
+
+static uint32_t gcd(uint32_t a, uint32_t b) {
+    while (b != 0) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+void SOFSync::setup(bool enabled, uint32_t marginUs) {
+    this->enabled = enabled;
+    this->marginUs = marginUs;
+    reset();
+}
+
+void SOFSync::reset() {
+    lockCount = 0;
+    frameUs16 = SOF_SYNC_FRAME_US << 4;
+    workUs = 0;
+    scheduled = false;
+    checkSent = false;
+    restartLearning();
+}
+
+void SOFSync::restartLearning() {
+    haveLastPoll = false;
+    pollGap = 0;
+    pollInterval = 1;
+    pollsSeen = 0;
+    missedPolls = 0;
+}
+
+void SOFSync::onStartOfFrame(uint32_t nowUs, bool reportTaken) {
+    if (reportTaken) {
+        takenFrame = frameCount;
+        takenCount = takenCount + 1;
+    }
+
+    uint32_t delta = nowUs - lastSofUs;
+    if (delta > SOF_SYNC_FRAME_US * 3 / 4 && delta < SOF_SYNC_FRAME_US * 5 / 4) {
+        frameUs16 = frameUs16 - (frameUs16 >> 4) + delta;
+        if (lockCount < SOF_SYNC_LOCK_FRAMES)
+            lockCount = lockCount + 1;
+    } else {
+        // first SOF, or some went missing and the frame count can't be trusted
+        lockCount = 0;
+    }
+    lastSofUs = nowUs;
+    frameCount = frameCount + 1;
+}
+
+bool SOFSync::readTakenFrame(uint32_t& frame) {
+    uint32_t count = readTaken(frame);
+    if (count == takenCountRead)
+        return false;
+
+    // the takes in between were a whole number of polls apart too, the poll interval doesn't need them
+    takenCountRead = count;
+    return true;
+}
+
+void SOFSync::onReportTaken(uint32_t frame) {
+    if (haveLastPoll) {
+        // a second IN endpoint in the same frame tells nothing new
+        if (frame == lastPollFrame)
+            return;
+
+        pollGap = gcd(pollGap, frame - lastPollFrame);
+        if (pollsSeen < SOF_SYNC_LEARN_REPORTS)
+            pollsSeen++;
+        if (pollsSeen == SOF_SYNC_LEARN_REPORTS)
+            pollInterval = (pollGap <= SOF_SYNC_MAX_POLL_INTERVAL) ? pollGap : 1;
+    }
+    lastPollFrame = frame;
+    haveLastPoll = true;
+}
+
+// The interrupt only ever updates the time before the count
+void SOFSync::readFrame(uint32_t& frame, uint32_t& sofUs) const {
+    do {
+        frame = frameCount;
+        sofUs = lastSofUs;
+    } while (frame != frameCount);
+}
+
+// The interrupt only ever updates the frame before the count
+uint32_t SOFSync::readTaken(uint32_t& frame) const {
+    uint32_t count;
+    do {
+        count = takenCount;
+        frame = takenFrame;
+    } while (count != takenCount);
+    return count;
+}
+
+uint32_t SOFSync::nextSampleTime(uint32_t nowUs) {
+    scheduled = false;
+    if (!enabled || !isLocked())
+        return nowUs;
+
+    uint32_t frame, sofUs;
+    readFrame(frame, sofUs);
+    const uint32_t frameUs = getFrameUs();
+    if ((int32_t)(nowUs - sofUs) > (int32_t)(frameUs * SOF_SYNC_LOST_FRAMES)) {
+        lockCount = 0;
+        return nowUs;
+    }
+
+    // the report has to be armed before the polled frame starts
+    const uint32_t leadUs = workUs + marginUs;
+    if (leadUs >= frameUs * pollInterval)
+        return nowUs;
+
+    uint32_t target = frame + 1;
+    if (pollInterval > 1) {
+        uint32_t offset = (target - lastPollFrame) % pollInterval;
+        if (offset != 0)
+            target += pollInterval - offset;
+    }
+    // too late for that poll, go for the next one
+    while ((int32_t)(sofUs + (target - frame) * frameUs - leadUs - nowUs) < 0)
+        target += pollInterval;
+
+    targetFrame = target;
+    scheduled = true;
+    return sofUs + (target - frame) * frameUs - leadUs;
+}
+
+void SOFSync::onCycleDone(uint32_t sampleUs, uint32_t doneUs, bool reportSent) {
+    // Rises quickly and falls slowly, so it settles near the slow end of the usual loops. A one-off
+    // slow loop only misses its poll, chasing it would make the next ones late too.
+    uint32_t elapsedUs = doneUs - sampleUs;
+    if (elapsedUs >= workUs)
+        workUs += (elapsedUs - workUs + 3) >> 2;
+    else
+        workUs -= (workUs - elapsedUs + 63) >> 6;
+
+    // By now the host had its chance to take the last scheduled report
+    if (checkSent) {
+        checkSent = false;
+        // from the interrupt, the completion may not have reached onReportTaken() yet
+        uint32_t frame;
+        const bool taken = readTaken(frame) != 0;
+        if (pollInterval > 1 && !(taken && frame == sentFrame)) {
+            if (++missedPolls >= SOF_SYNC_MISSES_BEFORE_RELEARN)
+                restartLearning();
+        } else {
+            missedPolls = 0;
+        }
+    }
+
+    if (scheduled && reportSent) {
+        sentFrame = targetFrame;
+        checkSent = true;
+    }
+}
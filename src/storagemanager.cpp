@@ -27,6 +27,10 @@ void Storage::init() {
 	ConfigUtils::load(config);
 }
 
+void Storage::loadDeferredConfig() {
+	ConfigUtils::loadDeferred(config);
+}
+
 /**
  * @brief Save the config, but only if it is safe to (as in USB host is not being used.)
  */
@@ -57,99 +61,6 @@ bool Storage::save(const bool force) {
 void Storage::ResetSettings()
 {
 	EEPROM.reset();
+	EEPROM.flush();
 	watchdog_reboot(0, SRAM_END, 2000);
 }
-
-bool Storage::setProfile(const uint32_t profileNum)
-{
-	// is this profile defined?
-	if (profileNum >= 1 && profileNum <= config.profileOptions.gpioMappingsSets_count + 1) {
-		// is this profile enabled?
-		// profile 1 (core) is always enabled, others we must check
-		if (profileNum == 1 || config.profileOptions.gpioMappingsSets[profileNum-2].enabled) {
-			// Update the profile number - reinit will be triggered automatically in gp2040.cpp
-			this->config.gamepadOptions.profileNumber = profileNum;
-			return true;
-		}
-	}
-	// if we get here, the requested profile doesn't exist or isn't enabled, so don't change it
-	return false;
-}
-
-void Storage::nextProfile()
-{
-	uint32_t profileCeiling = config.profileOptions.gpioMappingsSets_count + 1;
-	uint32_t requestedProfile = (this->config.gamepadOptions.profileNumber % profileCeiling) + 1;
-	while (!setProfile(requestedProfile)) {
-		// if the set failed, try again with the next in the sequence
-		requestedProfile = (requestedProfile % profileCeiling) + 1;
-	}
-}
-void Storage::previousProfile()
-{
-	uint32_t profileCeiling = config.profileOptions.gpioMappingsSets_count + 1;
-	uint32_t requestedProfile = this->config.gamepadOptions.profileNumber > 1 ?
-			config.gamepadOptions.profileNumber - 1 : profileCeiling;
-	while (!setProfile(requestedProfile)) {
-		// if the set failed, try again with the next in the sequence
-		requestedProfile = requestedProfile > 1 ? requestedProfile - 1 : profileCeiling;
-	}
-}
-
-/**
- * @brief Return the current profile label.
- */
-char* Storage::currentProfileLabel() {
-	if (this->config.gamepadOptions.profileNumber == 1)
-		return this->config.gpioMappings.profileLabel;
-	else
-		return this->config.profileOptions.gpioMappingsSets[config.gamepadOptions.profileNumber-2].profileLabel;
-}
-
-void Storage::setFunctionalPinMappings()
-{
-	GpioMappingInfo* alts = nullptr;
-	if (config.gamepadOptions.profileNumber >= 2 &&
-			config.gamepadOptions.profileNumber <= config.profileOptions.gpioMappingsSets_count + 1) {
-		if (config.profileOptions.gpioMappingsSets[config.gamepadOptions.profileNumber-2].enabled) {
-			alts = config.profileOptions.gpioMappingsSets[config.gamepadOptions.profileNumber-2].pins;
-		}
-	}
-
-	for (Pin_t pin = 0; pin < (Pin_t)NUM_BANK0_GPIOS; pin++) {
-		// assign the functional pin to the profile pin if:
-		// 1: there was a profile to load
-		// 2: the new action isn't RESERVED or ASSIGNED_TO_ADDON (profiles can't affect special addons)
-		// 3: the old action isn't RESERVED or ASSIGNED_TO_ADDON (profiles can't affect special addons)
-		// else use whatever is in the core mapping
-		if (alts != nullptr &&
-				alts[pin].action != GpioAction::RESERVED &&
-				alts[pin].action != GpioAction::ASSIGNED_TO_ADDON &&
-				this->config.gpioMappings.pins[pin].action != GpioAction::RESERVED &&
-				this->config.gpioMappings.pins[pin].action != GpioAction::ASSIGNED_TO_ADDON) {
-			functionalPinMappings[pin] = alts[pin];
-		} else {
-			functionalPinMappings[pin] = this->config.gpioMappings.pins[pin];
-		}
-	}
-}
-
-void Storage::SetGamepad(Gamepad * newpad)
-{
-	gamepad = newpad;
-}
-
-Gamepad * Storage::GetGamepad()
-{
-	return gamepad;
-}
-
-void Storage::SetProcessedGamepad(Gamepad * newpad)
-{
-	processedGamepad = newpad;
-}
-
-Gamepad * Storage::GetProcessedGamepad()
-{
-	return processedGamepad;
-}
@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2024 OpenStickCommunity (gp2040-ce.info)
+ */
+
+#include "storagemanager.h"
+
+// The profiles and the gamepads, apart from the flash and the peripherals so the host build can run them
+
+bool Storage::isProfileEnabled(const uint32_t profileNum)
+{
+	// is this profile defined?
+	if (profileNum >= 1 && profileNum <= config.profileOptions.gpioMappingsSets_count + 1) {
+		// profile 1 (core) is always enabled, others we must check
+		return profileNum == 1 || config.profileOptions.gpioMappingsSets[profileNum-2].enabled;
+	}
+	return false;
+}
+
+bool Storage::setProfile(const uint32_t profileNum)
+{
+	if (isProfileEnabled(profileNum)) {
+		// Update the profile number - reinit will be triggered automatically in gp2040.cpp
+		this->config.gamepadOptions.profileNumber = profileNum;
+		return true;
+	}
+	// if we get here, the requested profile doesn't exist or isn't enabled, so don't change it
+	return false;
+}
+
+void Storage::nextProfile()
+{
+	uint32_t profileCeiling = config.profileOptions.gpioMappingsSets_count + 1;
+	uint32_t requestedProfile = (this->config.gamepadOptions.profileNumber % profileCeiling) + 1;
+	while (!setProfile(requestedProfile)) {
+		// if the set failed, try again with the next in the sequence
+		requestedProfile = (requestedProfile % profileCeiling) + 1;
+	}
+}
+void Storage::previousProfile()
+{
+	uint32_t profileCeiling = config.profileOptions.gpioMappingsSets_count + 1;
+	uint32_t requestedProfile = this->config.gamepadOptions.profileNumber > 1 ?
+			config.gamepadOptions.profileNumber - 1 : profileCeiling;
+	while (!setProfile(requestedProfile)) {
+		// if the set failed, try again with the next in the sequence
+		requestedProfile = requestedProfile > 1 ? requestedProfile - 1 : profileCeiling;
+	}
+}
+
+/**
+ * @brief Return the current profile label.
+ */
+char* Storage::currentProfileLabel() {
+	if (this->config.gamepadOptions.profileNumber == 1)
+		return this->config.gpioMappings.profileLabel;
+	else
+		return this->config.profileOptions.gpioMappingsSets[config.gamepadOptions.profileNumber-2].profileLabel;
+}
+
+void Storage::setFunctionalPinMappings()
+{
+	getProfilePinMappings(config.gamepadOptions.profileNumber, functionalPinMappings);
+}
+
+/**
+ * @brief Fill in the pin mappings a profile would have as the current one, the core mappings for a disabled profile.
+ */
+void Storage::getProfilePinMappings(const uint32_t profileNum, GpioMappingInfo* pinMappings)
+{
+	GpioMappingInfo* alts = nullptr;
+	if (profileNum >= 2 && isProfileEnabled(profileNum)) {
+		alts = config.profileOptions.gpioMappingsSets[profileNum-2].pins;
+	}
+
+	for (Pin_t pin = 0; pin < (Pin_t)NUM_BANK0_GPIOS; pin++) {
+		// assign the functional pin to the profile pin if:
+		// 1: there was a profile to load
+		// 2: the new action isn't RESERVED or ASSIGNED_TO_ADDON (profiles can't affect special addons)
+		// 3: the old action isn't RESERVED or ASSIGNED_TO_ADDON (profiles can't affect special addons)
+		// else use whatever is in the core mapping
+		if (alts != nullptr &&
+				alts[pin].action != GpioAction::RESERVED &&
+				alts[pin].action != GpioAction::ASSIGNED_TO_ADDON &&
+				this->config.gpioMappings.pins[pin].action != GpioAction::RESERVED &&
+				this->config.gpioMappings.pins[pin].action != GpioAction::ASSIGNED_TO_ADDON) {
+			pinMappings[pin] = alts[pin];
+		} else {
+			pinMappings[pin] = this->config.gpioMappings.pins[pin];
+		}
+	}
+}
+
+void Storage::SetGamepad(Gamepad * newpad)
+{
+	gamepad = newpad;
+}
+
+Gamepad * Storage::GetGamepad()
+{
+	return gamepad;
+}
+
+void Storage::SetProcessedGamepad(Gamepad * newpad)
+{
+	processedGamepad = newpad;
+}
+
+Gamepad * Storage::GetProcessedGamepad()
+{
+	return processedGamepad;
+}
+
+void Storage::SetSnapshotGamepad(Gamepad * newpad)
+{
+	snapshotGamepad = newpad;
+}
+
+Gamepad * Storage::GetSnapshotGamepad()
+{
+	return snapshotGamepad;
+}
+
+void Storage::PublishProcessedGamepad()
+{
+	processedPublisher.publish(processedGamepad->state, processedGamepad->auxState);
+}
+
+void Storage::UpdateSnapshotGamepad()
+{
+	// always refreshed, core1 add-ons may have modified the last snapshot (e.g. masking hotkeys)
+	if (snapshotGamepad == nullptr)
+		return;
+
+	snapshotFrame = processedPublisher.read(snapshotGamepad->state, snapshotGamepad->auxState);
+}
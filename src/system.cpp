@@ -1,6 +1,7 @@
 #include "system.h"
 
 #include "usbhostmanager.h"
+#include "FlashPROM.h"
 
 #include <hardware/flash.h>
 #include <hardware/sync.h>
@@ -8,6 +9,7 @@
 #include <pico/multicore.h>
 
 #include <malloc.h>
+#include <new>
 
 extern char __flash_binary_start;
 extern char __flash_binary_end;
@@ -58,7 +60,86 @@ uint32_t System::getUsedHeap() {
     return mallinfo().uordblks;
 }
 
+#if defined(GP2040_COUNT_HEAP_OPERATIONS)
+static volatile uint32_t heapOperations = 0;
+static uint32_t heapOperationsWindowStart = 0;
+static uint32_t maxLoopHeapOperations = 0;
+
+static inline void countHeapOperation() {
+    // only the input loop core is of interest, and this keeps the counter single writer
+    if (get_core_num() == 0) {
+        heapOperations = heapOperations + 1;
+    }
+}
+
+void* operator new(size_t size) {
+    countHeapOperation();
+    return malloc(size);
+}
+
+void* operator new[](size_t size) {
+    countHeapOperation();
+    return malloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    countHeapOperation();
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    countHeapOperation();
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    countHeapOperation();
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    countHeapOperation();
+    free(ptr);
+}
+
+uint32_t System::getHeapOperations() {
+    return heapOperations;
+}
+
+void System::startHeapOperationsWindow() {
+    heapOperationsWindowStart = heapOperations;
+}
+
+void System::endHeapOperationsWindow() {
+    uint32_t loopHeapOperations = heapOperations - heapOperationsWindowStart;
+    if (loopHeapOperations > maxLoopHeapOperations) {
+        maxLoopHeapOperations = loopHeapOperations;
+    }
+}
+
+uint32_t System::getMaxLoopHeapOperations() {
+    return maxLoopHeapOperations;
+}
+#else
+uint32_t System::getHeapOperations() {
+    return 0;
+}
+
+void System::startHeapOperationsWindow() {
+}
+
+void System::endHeapOperationsWindow() {
+}
+
+uint32_t System::getMaxLoopHeapOperations() {
+    return 0;
+}
+#endif
+
 void System::reboot(BootMode bootMode) {
+    // Don't lose a save that is still being written
+    EEPROM.flush();
+
     // Halt all running USB instances
     USBHostManager::getInstance().shutdown();
 
@@ -8,10 +8,19 @@
 
 #include "tusb.h"
 #include "drivermanager.h"
+#include "usbdriver.h"
+#include "bootprofile.h"
+
+#include "pico/time.h"
+#include "hardware/structs/usb.h"
 
 static bool usb_mounted;
 static bool usb_suspended;
 
+static SOFSync sof_sync;
+static const usbd_class_driver_t *input_class_driver;
+static usbd_class_driver_t sof_sync_class_driver;
+
 bool get_usb_mounted(void) {
 	return usb_mounted;
 }
@@ -20,9 +29,64 @@ bool get_usb_suspended(void) {
 	return usb_suspended;
 }
 
+SOFSync& get_usb_sof_sync(void) {
+	return sof_sync;
+}
+
+// IN endpoints the input driver sends its reports on, from the completed transfers
+static volatile uint16_t sof_sync_in_endpoints;
+// Buffer control of each of them at the last SOF
+static uint32_t sof_sync_in_buf_ctrl[USB_NUM_ENDPOINTS];
+
+// Called from the USB interrupt. The host polls an interrupt IN endpoint at most once a frame, so
+// a buffer that was armed at the last SOF and has since been handed back, or armed again with
+// the other data PID, was taken in the frame that just ended.
+static bool sof_sync_report_taken(void) {
+	bool taken = false;
+	uint16_t endpoints = sof_sync_in_endpoints;
+	for (uint8_t ep = 1; ep < USB_NUM_ENDPOINTS; ep++) {
+		if (!(endpoints & (1 << ep)))
+			continue;
+		uint32_t buf_ctrl = usb_dpram->ep_buf_ctrl[ep].in;
+		uint32_t last = sof_sync_in_buf_ctrl[ep];
+		if ((last & USB_BUF_CTRL_AVAIL) &&
+			(!(buf_ctrl & USB_BUF_CTRL_AVAIL) || ((buf_ctrl ^ last) & USB_BUF_CTRL_DATA1_PID)))
+			taken = true;
+		sof_sync_in_buf_ctrl[ep] = buf_ctrl;
+	}
+	return taken;
+}
+
+// Called from the USB interrupt
+static void sof_sync_sof_cb(uint8_t rhport, uint32_t frame_count) {
+	sof_sync.onStartOfFrame(time_us_32(), sof_sync_report_taken());
+	if (input_class_driver->sof)
+		input_class_driver->sof(rhport, frame_count);
+}
+
+// Called from tud_task(), which may be frames after the host took the report
+static bool sof_sync_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes) {
+	if (tu_edpt_dir(ep_addr) == TUSB_DIR_IN && result == XFER_RESULT_SUCCESS) {
+		sof_sync_in_endpoints = sof_sync_in_endpoints | (1 << tu_edpt_number(ep_addr));
+		uint32_t frame;
+		if (sof_sync.readTakenFrame(frame))
+			sof_sync.onReportTaken(frame);
+	}
+	return input_class_driver->xfer_cb(rhport, ep_addr, result, xferred_bytes);
+}
+
 const usbd_class_driver_t *usbd_app_driver_get_cb(uint8_t *driver_count) {
 	*driver_count = 1;
-	return DriverManager::getInstance().getDriver()->get_class_driver();
+	const usbd_class_driver_t *class_driver = DriverManager::getInstance().getDriver()->get_class_driver();
+	if (!sof_sync.isEnabled())
+		return class_driver;
+
+	// Wrap the input driver to see the SOFs and the reports taken by the host
+	input_class_driver = class_driver;
+	sof_sync_class_driver = *class_driver;
+	sof_sync_class_driver.sof = sof_sync_sof_cb;
+	sof_sync_class_driver.xfer_cb = sof_sync_xfer_cb;
+	return &sof_sync_class_driver;
 }
 
 uint16_t tud_hid_get_report_cb(uint8_t itf, uint8_t report_id, hid_report_type_t report_type, uint8_t *buffer, uint16_t reqlen) {
@@ -38,6 +102,7 @@ void tud_hid_set_report_cb(uint8_t itf, uint8_t report_id, hid_report_type_t rep
 // Invoked when device is mounted
 void tud_mount_cb(void)
 {
+	BootProfile::mark(BOOT_PHASE_USB_MOUNTED);
 	usb_mounted = true;
 	usb_suspended = false;
 }
@@ -2,6 +2,7 @@
 #include "storagemanager.h"
 #include "peripheralmanager.h"
 #include "eventmanager.h"
+#include "inputcapture.h"
 
 #include "pio_usb.h"
 #include "tusb.h"
@@ -57,6 +58,7 @@ void USBHostManager::hid_umount_cb(uint8_t dev_addr, uint8_t instance) {
 }
 
 void USBHostManager::hid_report_received_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len) {
+    INPUT_CAPTURE_HOST_REPORT(dev_addr, instance, report, len);
     if ( listeners.size() == 0 ) return;
     for( std::vector<USBListener*>::iterator it = listeners.begin(); it != listeners.end(); it++ ){
         (*it)->report_received(dev_addr, instance, report, len);
@@ -92,6 +94,7 @@ void USBHostManager::xinput_umount_cb(uint8_t dev_addr) {
 }
 
 void USBHostManager::xinput_report_received_cb(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len) {
+    INPUT_CAPTURE_HOST_REPORT(dev_addr, instance, report, len);
     if ( listeners.size() == 0 ) return;
     for( std::vector<USBListener*>::iterator it = listeners.begin(); it != listeners.end(); it++ ){
         (*it)->report_received(dev_addr, instance, report, len);
@@ -119,7 +122,7 @@ void tuh_mount_cb(uint8_t dev_addr) {
         vid = 0xFFFF;
         pid = 0xFFFF;
     }
-    EventManager::getInstance().triggerEvent(new GPUSBHostMountEvent(dev_addr, vid, pid));
+    EventManager::getInstance().triggerEvent(GPUSBHostMountEvent(dev_addr, vid, pid));
 }
 
 void tuh_umount_cb(uint8_t dev_addr) {
@@ -128,7 +131,7 @@ void tuh_umount_cb(uint8_t dev_addr) {
         vid = 0xFFFF;
         pid = 0xFFFF;
     }
-    EventManager::getInstance().triggerEvent(new GPUSBHostUnmountEvent(dev_addr, vid, pid));
+    EventManager::getInstance().triggerEvent(GPUSBHostUnmountEvent(dev_addr, vid, pid));
 }
 
 /// Invoked when device is unmounted (bus reset/unplugged)
@@ -10,6 +10,11 @@
 #include "peripheralmanager.h"
 #include "animationstorage.h"
 #include "system.h"
+#include "addonmanager.h"
+#include "loopstats.h"
+#include "inputcapture.h"
+#include "latencytrace.h"
+#include "bootprofile.h"
 #include "config_utils.h"
 #include "types.h"
 #include "version.h"
@@ -281,10 +286,9 @@ DynamicJsonDocument get_post_data()
     return doc;
 }
 
-void save_hotkey(HotkeyEntry* hotkey, const DynamicJsonDocument& doc, const string hotkey_key)
+// The web config keeps hotkey dpad directions in the buttons mask
+static uint32_t hotkey_dpad_from_buttons(uint32_t buttonsMask)
 {
-    readDoc(hotkey->auxMask, doc, hotkey_key, "auxMask");
-    uint32_t buttonsMask = doc[hotkey_key]["buttonsMask"];
     uint32_t dpadMask = 0;
     if (buttonsMask & GAMEPAD_MASK_DU) {
         dpadMask |= GAMEPAD_MASK_UP;
@@ -298,30 +302,51 @@ void save_hotkey(HotkeyEntry* hotkey, const DynamicJsonDocument& doc, const stri
     if (buttonsMask & GAMEPAD_MASK_DR) {
         dpadMask |= GAMEPAD_MASK_RIGHT;
     }
-    buttonsMask &= ~(GAMEPAD_MASK_DU | GAMEPAD_MASK_DD | GAMEPAD_MASK_DL | GAMEPAD_MASK_DR);
-    hotkey->dpadMask = dpadMask;
-    hotkey->buttonsMask = buttonsMask;
-    readDoc(hotkey->action, doc, hotkey_key, "action");
+    return dpadMask;
 }
 
-void load_hotkey(const HotkeyEntry* hotkey, DynamicJsonDocument& doc, const string hotkey_key)
+static uint32_t hotkey_buttons_with_dpad(uint32_t buttonsMask, uint32_t dpadMask)
 {
-    writeDoc(doc, hotkey_key, "auxMask", hotkey->auxMask);
-    uint32_t buttonsMask = hotkey->buttonsMask;
-    if (hotkey->dpadMask & GAMEPAD_MASK_UP) {
+    if (dpadMask & GAMEPAD_MASK_UP) {
         buttonsMask |= GAMEPAD_MASK_DU;
     }
-    if (hotkey->dpadMask & GAMEPAD_MASK_DOWN) {
+    if (dpadMask & GAMEPAD_MASK_DOWN) {
         buttonsMask |= GAMEPAD_MASK_DD;
     }
-    if (hotkey->dpadMask & GAMEPAD_MASK_LEFT) {
+    if (dpadMask & GAMEPAD_MASK_LEFT) {
         buttonsMask |= GAMEPAD_MASK_DL;
     }
-    if (hotkey->dpadMask & GAMEPAD_MASK_RIGHT) {
+    if (dpadMask & GAMEPAD_MASK_RIGHT) {
         buttonsMask |= GAMEPAD_MASK_DR;
     }
-    writeDoc(doc, hotkey_key, "buttonsMask", buttonsMask);
+    return buttonsMask;
+}
+
+void save_hotkey(HotkeyEntry* hotkey, const DynamicJsonDocument& doc, const string hotkey_key)
+{
+    const uint32_t dpadButtons = GAMEPAD_MASK_DU | GAMEPAD_MASK_DD | GAMEPAD_MASK_DL | GAMEPAD_MASK_DR;
+    readDoc(hotkey->auxMask, doc, hotkey_key, "auxMask");
+    uint32_t buttonsMask = doc[hotkey_key]["buttonsMask"];
+    hotkey->dpadMask = hotkey_dpad_from_buttons(buttonsMask);
+    hotkey->buttonsMask = buttonsMask & ~dpadButtons;
+    readDoc(hotkey->action, doc, hotkey_key, "action");
+
+    // chords are optional, older pages don't send them
+    if (hasValue(doc, hotkey_key.c_str(), "firstButtonsMask")) {
+        uint32_t firstButtonsMask = doc[hotkey_key]["firstButtonsMask"];
+        hotkey->firstDpadMask = hotkey_dpad_from_buttons(firstButtonsMask);
+        hotkey->firstButtonsMask = firstButtonsMask & ~dpadButtons;
+        readDoc(hotkey->firstAuxMask, doc, hotkey_key, "firstAuxMask");
+    }
+}
+
+void load_hotkey(const HotkeyEntry* hotkey, DynamicJsonDocument& doc, const string hotkey_key)
+{
+    writeDoc(doc, hotkey_key, "auxMask", hotkey->auxMask);
+    writeDoc(doc, hotkey_key, "buttonsMask", hotkey_buttons_with_dpad(hotkey->buttonsMask, hotkey->dpadMask));
     writeDoc(doc, hotkey_key, "action", hotkey->action);
+    writeDoc(doc, hotkey_key, "firstAuxMask", hotkey->firstAuxMask);
+    writeDoc(doc, hotkey_key, "firstButtonsMask", hotkey_buttons_with_dpad(hotkey->firstButtonsMask, hotkey->firstDpadMask));
 }
 
 // LWIP callback on HTTP POST to validate the URI
@@ -464,7 +489,7 @@ std::string setDisplayOptions(DisplayOptions& displayOptions)
 std::string setDisplayOptions()
 {
     std::string response = setDisplayOptions(Storage::getInstance().getDisplayOptions());
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
     return response;
 }
 
@@ -541,7 +566,7 @@ std::string setSplashImage()
     memcpy(displayOptions.splashImage.bytes, decoded.data(), length);
     displayOptions.splashImage.size = length;
 
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
 
     return serialize_json(doc);
 }
@@ -586,7 +611,7 @@ std::string setProfileOptions()
         if (altsIndex > 4) break;
     }
 
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
     return serialize_json(doc);
 }
 
@@ -665,6 +690,12 @@ std::string setGamepadOptions()
     readDoc(gamepadOptions.fourWayMode, doc, "fourWayMode");
     readDoc(gamepadOptions.profileNumber, doc, "profileNumber");
     readDoc(gamepadOptions.debounceDelay, doc, "debounceDelay");
+    readDoc(gamepadOptions.debounceMode, doc, "debounceMode");
+    readDoc(gamepadOptions.usbSofSync, doc, "usbSofSync");
+    readDoc(gamepadOptions.usbSofSyncMarginUs, doc, "usbSofSyncMarginUs");
+    readDoc(gamepadOptions.gpioEdgeCapture, doc, "gpioEdgeCapture");
+    readDoc(gamepadOptions.gpioOversampling, doc, "gpioOversampling");
+    readDoc(gamepadOptions.idleSleep, doc, "idleSleep");
     readDoc(gamepadOptions.inputModeB1, doc, "inputModeB1");
     readDoc(gamepadOptions.inputModeB2, doc, "inputModeB2");
     readDoc(gamepadOptions.inputModeB3, doc, "inputModeB3");
@@ -711,11 +742,19 @@ std::string setGamepadOptions()
     save_hotkey(&hotkeyOptions.hotkey14, doc, "hotkey14");
     save_hotkey(&hotkeyOptions.hotkey15, doc, "hotkey15");
     save_hotkey(&hotkeyOptions.hotkey16, doc, "hotkey16");
+    save_hotkey(&hotkeyOptions.hotkey17, doc, "hotkey17");
+    save_hotkey(&hotkeyOptions.hotkey18, doc, "hotkey18");
+    save_hotkey(&hotkeyOptions.hotkey19, doc, "hotkey19");
+    save_hotkey(&hotkeyOptions.hotkey20, doc, "hotkey20");
+    save_hotkey(&hotkeyOptions.hotkey21, doc, "hotkey21");
+    save_hotkey(&hotkeyOptions.hotkey22, doc, "hotkey22");
+    save_hotkey(&hotkeyOptions.hotkey23, doc, "hotkey23");
+    save_hotkey(&hotkeyOptions.hotkey24, doc, "hotkey24");
 
     ForcedSetupOptions& forcedSetupOptions = Storage::getInstance().getForcedSetupOptions();
     readDoc(forcedSetupOptions.mode, doc, "forcedSetupMode");
 
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
 
     return serialize_json(doc);
 }
@@ -735,6 +774,12 @@ std::string getGamepadOptions()
     writeDoc(doc, "fourWayMode", gamepadOptions.fourWayMode ? 1 : 0);
     writeDoc(doc, "profileNumber", gamepadOptions.profileNumber);
     writeDoc(doc, "debounceDelay", gamepadOptions.debounceDelay);
+    writeDoc(doc, "debounceMode", gamepadOptions.debounceMode);
+    writeDoc(doc, "usbSofSync", gamepadOptions.usbSofSync ? 1 : 0);
+    writeDoc(doc, "usbSofSyncMarginUs", gamepadOptions.usbSofSyncMarginUs);
+    writeDoc(doc, "gpioEdgeCapture", gamepadOptions.gpioEdgeCapture ? 1 : 0);
+    writeDoc(doc, "gpioOversampling", gamepadOptions.gpioOversampling ? 1 : 0);
+    writeDoc(doc, "idleSleep", gamepadOptions.idleSleep ? 1 : 0);
     writeDoc(doc, "inputModeB1", gamepadOptions.inputModeB1);
     writeDoc(doc, "inputModeB2", gamepadOptions.inputModeB2);
     writeDoc(doc, "inputModeB3", gamepadOptions.inputModeB3);
@@ -785,6 +830,14 @@ std::string getGamepadOptions()
     load_hotkey(&hotkeyOptions.hotkey14, doc, "hotkey14");
     load_hotkey(&hotkeyOptions.hotkey15, doc, "hotkey15");
     load_hotkey(&hotkeyOptions.hotkey16, doc, "hotkey16");
+    load_hotkey(&hotkeyOptions.hotkey17, doc, "hotkey17");
+    load_hotkey(&hotkeyOptions.hotkey18, doc, "hotkey18");
+    load_hotkey(&hotkeyOptions.hotkey19, doc, "hotkey19");
+    load_hotkey(&hotkeyOptions.hotkey20, doc, "hotkey20");
+    load_hotkey(&hotkeyOptions.hotkey21, doc, "hotkey21");
+    load_hotkey(&hotkeyOptions.hotkey22, doc, "hotkey22");
+    load_hotkey(&hotkeyOptions.hotkey23, doc, "hotkey23");
+    load_hotkey(&hotkeyOptions.hotkey24, doc, "hotkey24");
 
     ForcedSetupOptions& forcedSetupOptions = Storage::getInstance().getForcedSetupOptions();
     writeDoc(doc, "forcedSetupMode", forcedSetupOptions.mode);
@@ -844,7 +897,7 @@ std::string setLedOptions()
     readDoc(ledOptions.caseRGBIndex, doc, "caseRGBIndex");
     readDoc(ledOptions.caseRGBCount, doc, "caseRGBCount");
 
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
     return serialize_json(doc);
 }
 
@@ -1058,7 +1111,7 @@ std::string setCustomTheme()
     readDoc(pressCooldown, doc, "buttonPressColorCooldownTimeInMs");
     options.buttonPressColorCooldownTimeInMs = pressCooldown;
 
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
     return serialize_json(doc);
 }
 
@@ -1134,7 +1187,7 @@ std::string setPinMappings()
     gpioMappings.profileLabel[profileLabelSize - 1] = '\0';
     gpioMappings.enabled = doc["enabled"];
 
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
 
     return serialize_json(doc);
 }
@@ -1229,7 +1282,7 @@ std::string setKeyMappings()
     readDoc(keyboardMapping.keyButtonE11, doc, "E11");
     readDoc(keyboardMapping.keyButtonE12, doc, "E12");
 
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
 
     return serialize_json(doc);
 }
@@ -1391,7 +1444,7 @@ std::string setPeripheralOptions()
         profiles.gpioMappingsSets[2].pins[oldPinDplus+adjacent].action = GpioAction::NONE;
     }
 
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
 
     return serialize_json(doc);
 }
@@ -1456,7 +1509,7 @@ std::string setExpansionPins()
     }
     Storage::getInstance().getAddonOptions().pcf8575Options.pins_count = 16;
 
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
 
     return serialize_json(doc);
 }
@@ -1622,7 +1675,7 @@ std::string setHETriggerOptions()
     }
     
     Storage::getInstance().getAddonOptions().heTriggerOptions.triggers_count = 32;
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
 
     return serialize_json(doc);
 }
@@ -1658,7 +1711,7 @@ std::string setReactiveLEDs()
     }
     Storage::getInstance().getAddonOptions().reactiveLEDOptions.leds_count = 10;
 
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
 
     return serialize_json(doc);
 }
@@ -1879,7 +1932,27 @@ std::string setAddonOptions()
     docToValue(heTriggerOptions.emaSmoothing, doc, "heTriggerSmoothing");
     docToValue(heTriggerOptions.smoothingFactor, doc, "heTriggerSmoothingFactor");
 
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    AddonProfilerOptions& addonProfilerOptions = Storage::getInstance().getAddonOptions().addonProfilerOptions;
+    docToValue(addonProfilerOptions.budgetUs, doc, "addonBudgetUs");
+    docToValue(addonProfilerOptions.demoteOverBudget, doc, "addonDemoteOverBudget");
+    docToValue(addonProfilerOptions.demotedInterval, doc, "addonDemotedInterval");
+    if (doc.containsKey("addonBudgets")) {
+        JsonArray budgets = doc["addonBudgets"];
+        pb_size_t budgetsIndex = 0;
+        for (JsonObject budget : budgets) {
+            if (budgetsIndex >= sizeof(addonProfilerOptions.budgets) / sizeof(addonProfilerOptions.budgets[0]))
+                break;
+
+            size_t nameSize = sizeof(addonProfilerOptions.budgets[budgetsIndex].name);
+            strncpy(addonProfilerOptions.budgets[budgetsIndex].name, budget["name"] | "", nameSize - 1);
+            addonProfilerOptions.budgets[budgetsIndex].name[nameSize - 1] = '\0';
+            addonProfilerOptions.budgets[budgetsIndex].budgetUs = budget["budgetUs"].as<uint32_t>();
+            budgetsIndex++;
+        }
+        addonProfilerOptions.budgets_count = budgetsIndex;
+    }
+
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
 
     return serialize_json(doc);
 }
@@ -1952,7 +2025,7 @@ std::string setPS4Options()
     if (ps4Options.rsaQP.size != 0) ps4Options.rsaQP.size = 0;
     if (ps4Options.rsaRN.size != 0) ps4Options.rsaRN.size = 0;
 
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
 
     return "{\"success\":true}";
 }
@@ -2035,7 +2108,7 @@ std::string setWiiControls()
     readDoc(wiiOptions.controllers.turntable.effects.axisType, doc, "turntable.analogEffects.axisType");
     readDoc(wiiOptions.controllers.turntable.fader.axisType, doc, "turntable.analogFader.axisType");
 
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
 
     return "{\"success\":true}";
 }
@@ -2337,6 +2410,17 @@ std::string getAddonOptions()
     writeDoc(doc, "heTriggerSmoothing", heTriggerOptions.emaSmoothing);
     writeDoc(doc, "heTriggerSmoothingFactor", heTriggerOptions.smoothingFactor);
 
+    const AddonProfilerOptions& addonProfilerOptions = Storage::getInstance().getAddonOptions().addonProfilerOptions;
+    writeDoc(doc, "addonBudgetUs", addonProfilerOptions.budgetUs);
+    writeDoc(doc, "addonDemoteOverBudget", addonProfilerOptions.demoteOverBudget);
+    writeDoc(doc, "addonDemotedInterval", addonProfilerOptions.demotedInterval);
+    JsonArray addonBudgets = doc.createNestedArray("addonBudgets");
+    for (pb_size_t i = 0; i < addonProfilerOptions.budgets_count; i++) {
+        JsonObject budget = addonBudgets.createNestedObject();
+        budget["name"] = addonProfilerOptions.budgets[i].name;
+        budget["budgetUs"] = addonProfilerOptions.budgets[i].budgetUs;
+    }
+
     return serialize_json(doc);
 }
 
@@ -2379,7 +2463,7 @@ std::string setMacroAddonOptions()
 
     macroOptions.macroList_count = MAX_MACRO_LIMIT;
 
-    EventManager::getInstance().triggerEvent(new GPStorageSaveEvent(true));
+    EventManager::getInstance().triggerEvent(GPStorageSaveEvent(true));
     return serialize_json(doc);
 }
 
@@ -2432,7 +2516,7 @@ std::string getFirmwareVersion()
 
 std::string getMemoryReport()
 {
-    const size_t capacity = JSON_OBJECT_SIZE(10);
+    const size_t capacity = JSON_OBJECT_SIZE(16);
     DynamicJsonDocument doc(capacity);
     writeDoc(doc, "totalFlash", System::getTotalFlash());
     writeDoc(doc, "usedFlash", System::getUsedFlash());
@@ -2440,6 +2524,127 @@ std::string getMemoryReport()
     writeDoc(doc, "staticAllocs", System::getStaticAllocs());
     writeDoc(doc, "totalHeap", System::getTotalHeap());
     writeDoc(doc, "usedHeap", System::getUsedHeap());
+    writeDoc(doc, "heapOperations", System::getHeapOperations());
+    writeDoc(doc, "maxLoopHeapOperations", System::getMaxLoopHeapOperations());
+    const FlashPROMWriteStats& flashWrites = EEPROM.writeStats;
+    writeDoc(doc, "flashSaves", flashWrites.saves);
+    writeDoc(doc, "flashSectorsChanged", flashWrites.sectorsChanged);
+    writeDoc(doc, "flashSectorsErased", flashWrites.sectorsErased);
+    writeDoc(doc, "flashPagesProgrammed", flashWrites.pagesProgrammed);
+    writeDoc(doc, "flashStallUs", flashWrites.stallUs);
+    writeDoc(doc, "maxFlashStallUs", flashWrites.maxStallUs);
+    return serialize_json(doc);
+}
+
+std::string getAddonProfile()
+{
+    const char* phaseNames[ADDON_PHASE_COUNT] = { "preprocess", "process", "postprocess" };
+
+    size_t numAddons = 0;
+    for (uint8_t core = 0; core < ADDONMGR_NUM_CORES; core++)
+        numAddons += AddonManager::GetProfileCount(core);
+
+    const size_t capacity = JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(numAddons) +
+        numAddons * (JSON_OBJECT_SIZE(6 + ADDON_PHASE_COUNT) + ADDON_PHASE_COUNT * JSON_OBJECT_SIZE(3));
+    DynamicJsonDocument doc(capacity);
+
+    // in web config these are the add-ons of the previous boot, which core0 ran in gamepad mode
+    writeDoc(doc, "previousBoot", AddonManager::IsPreviousBootProfile());
+    JsonArray addons = doc.createNestedArray("addons");
+    for (uint8_t core = 0; core < ADDONMGR_NUM_CORES; core++) {
+        for (uint8_t index = 0; index < AddonManager::GetProfileCount(core); index++) {
+            const AddonProfile* profile = AddonManager::GetProfile(core, index);
+            JsonObject addon = addons.createNestedObject();
+            addon["name"] = (const char*)profile->name;
+            addon["core"] = core;
+            addon["budgetUs"] = profile->budgetUs;
+            addon["overruns"] = profile->overruns;
+            addon["overBudget"] = profile->overBudget;
+            addon["interval"] = profile->interval;
+            for (uint8_t phase = 0; phase < ADDON_PHASE_COUNT; phase++) {
+                JsonObject phaseStats = addon.createNestedObject(phaseNames[phase]);
+                phaseStats["lastUs"] = profile->phases[phase].lastUs;
+                phaseStats["avgUs"] = profile->phases[phase].avgUs16 >> 4;
+                phaseStats["maxUs"] = profile->phases[phase].maxUs;
+            }
+        }
+    }
+    return serialize_json(doc);
+}
+
+std::string getLatencyTrace()
+{
+    const std::string data = LatencyTrace::encode();
+    const size_t capacity = JSON_OBJECT_SIZE(4) + data.size() + 1;
+    DynamicJsonDocument doc(capacity);
+    writeDoc(doc, "version", LATENCY_TRACE_VERSION);
+    writeDoc(doc, "sampleSize", sizeof(LatencySample));
+    writeDoc(doc, "count", LatencyTrace::getCount());
+    writeDoc(doc, "data", data);
+    return serialize_json(doc);
+}
+
+std::string getBootProfile()
+{
+    const size_t capacity = JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(BOOT_PHASE_COUNT) + BOOT_PHASE_COUNT * JSON_OBJECT_SIZE(3);
+    DynamicJsonDocument doc(capacity);
+    writeDoc(doc, "version", BOOT_PROFILE_VERSION);
+    JsonArray phases = doc.createNestedArray("phases");
+    for (uint8_t phase = 0; phase < BOOT_PHASE_COUNT; phase++) {
+        JsonObject phaseDoc = phases.createNestedObject();
+        phaseDoc["name"] = BootProfile::getPhaseName((BootPhase)phase);
+        phaseDoc["us"] = BootProfile::getUs((BootPhase)phase);
+        phaseDoc["previousUs"] = BootProfile::getPreviousUs((BootPhase)phase);
+    }
+    return serialize_json(doc);
+}
+
+std::string getInputCapture()
+{
+    // the capture is most of the response: encode it once, straight from the ring, as a quoted
+    // string the document links to instead of copying, and serialize into a buffer of the right size
+    std::string data;
+    data.reserve(InputCapture::getEncodedSize() + 2);
+    data.push_back('"');
+    InputCapture::encode(data);
+    data.push_back('"');
+
+    const size_t capacity = JSON_OBJECT_SIZE(5);
+    DynamicJsonDocument doc(capacity);
+    writeDoc(doc, "enabled", GP2040_INPUT_CAPTURE ? true : false);
+    writeDoc(doc, "version", INPUT_CAPTURE_VERSION);
+    writeDoc(doc, "recordSize", sizeof(InputCaptureRecord));
+    writeDoc(doc, "count", InputCapture::getCount());
+    doc["data"] = serialized(data.c_str(), data.size());
+
+    std::string json;
+    json.reserve(measureJson(doc));
+    serializeJson(doc, json);
+    return json;
+}
+
+std::string getLoopStats()
+{
+    const size_t capacity = JSON_OBJECT_SIZE(3) + JSON_ARRAY_SIZE(LOOP_PHASE_COUNT) + LOOP_PHASE_COUNT * JSON_OBJECT_SIZE(7);
+    DynamicJsonDocument doc(capacity);
+    writeDoc(doc, "enabled", GP2040_LOOP_STATS ? true : false);
+    writeDoc(doc, "previousBoot", LoopStats::isPreviousBoot());
+
+    JsonArray phases = doc.createNestedArray("phases");
+    LoopPhaseSummary summary;
+    for (uint8_t phase = 0; phase < LOOP_PHASE_COUNT; phase++) {
+        if (!LoopStats::getSummary((LoopPhase)phase, summary))
+            break;
+
+        JsonObject phaseStats = phases.createNestedObject();
+        phaseStats["name"] = LoopStats::getPhaseName((LoopPhase)phase);
+        phaseStats["core"] = phase >= LOOP_PHASE_CORE1_LOOP ? 1 : 0;
+        phaseStats["count"] = summary.count;
+        phaseStats["minNs"] = summary.minNs;
+        phaseStats["avgNs"] = summary.avgNs;
+        phaseStats["p99Ns"] = summary.p99Ns;
+        phaseStats["maxNs"] = summary.maxNs;
+    }
     return serialize_json(doc);
 }
 
@@ -2554,6 +2759,17 @@ std::string echo()
     DynamicJsonDocument doc = get_post_data();
     return serialize_json(doc);
 }
+
+std::string getEventBenchmark()
+{
+    const uint32_t iterations = 10000;
+    DynamicJsonDocument doc(JSON_OBJECT_SIZE(4));
+    writeDoc(doc, "iterations", iterations);
+    writeDoc(doc, "subscribers1", EventManager::getInstance().benchmarkDispatch(1, iterations));
+    writeDoc(doc, "subscribers4", EventManager::getInstance().benchmarkDispatch(4, iterations));
+    writeDoc(doc, "subscribers16", EventManager::getInstance().benchmarkDispatch(16, iterations));
+    return serialize_json(doc);
+}
 #endif
 
 // MUST MATCH NAVIGATION.JSX
@@ -2574,7 +2790,7 @@ std::string reboot() {
     } else if (bootMode == BOOT_MODES::BOOTSEL ) {
         systemBootMode = System::BootMode::USB;
     }
-    EventManager::getInstance().triggerEvent(new GPRestartEvent((System::BootMode)systemBootMode));
+    EventManager::getInstance().triggerEvent(GPRestartEvent((System::BootMode)systemBootMode));
     doc["success"] = true;
     return serialize_json(doc);
 }
@@ -2711,6 +2927,11 @@ static const std::pair<const char*, HandlerFuncPtr> handlerFuncs[] =
     { "/api/getSplashImage", getSplashImage },
     { "/api/getFirmwareVersion", getFirmwareVersion },
     { "/api/getMemoryReport", getMemoryReport },
+    { "/api/getLoopStats", getLoopStats },
+    { "/api/getAddonProfile", getAddonProfile },
+    { "/api/getLatencyTrace", getLatencyTrace },
+    { "/api/getBootProfile", getBootProfile },
+    { "/api/getInputCapture", getInputCapture },
     { "/api/getHeldPins", getHeldPins },
     { "/api/abortGetHeldPins", abortGetHeldPins },
     { "/api/getUsedPins", getUsedPins },
@@ -2719,6 +2940,7 @@ static const std::pair<const char*, HandlerFuncPtr> handlerFuncs[] =
     { "/api/getJoystickCenter2", getJoystickCenter2 },
 #if !defined(NDEBUG)
     { "/api/echo", echo },
+    { "/api/getEventBenchmark", getEventBenchmark },
 #endif
 };
 
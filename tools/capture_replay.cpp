@@ -0,0 +1,447 @@
+/*
+ * Host-side replay of an input capture (GP2040_INPUT_CAPTURE builds, /api/getInputCapture).
+ *
+ * The capture is read back with InputCaptureReader, the firmware's own format code, and replayed
+ * through the core0 loop of the host build (tools/host/hostloop.h): every debounced GPIO word and
+ * ADC sample is set on the host HAL and the firmware's Gamepad, input add-ons and driver run on it
+ * once a millisecond of capture time, and at every input. Each input prints one line, the GPIO
+ * word, the ADC sample or the USB host report as received, and each report the driver sends
+ * prints its bytes. Two firmware versions behave the same on a capture when their outputs are
+ * identical, --expect compares against a saved output byte for byte. The USB host add-ons aren't
+ * in the host build, so the host reports are printed but not fed back in.
+ *
+ * The stick is the one configureHostStick sets up, without debouncing as the capture already is:
+ * 2-5 the dpad, 6-17 the buttons. --input-mode picks the driver, generic HID by default, see
+ * tools/host/drivermanager.cpp for the ones the host build has.
+ *
+ * --self-test records a synthetic session with InputCaptureWriter instead, USB host pad at
+ * 1 kHz included, checks that what is read back from the base64 matches what was recorded, and
+ * that the HID report after every GPIO word is the one its buttons and SOCD cleaned dpad make.
+ *
+ * Build and run with the host build (tools/CMakeLists.txt):
+ *   cmake -S tools -B build-host && cmake --build build-host
+ *   ./build-host/capture_replay capture.json [--input-mode <mode>] [--socd <mode>] [--four-way] [--output <file>] [--expect <file>]
+ *   ./build-host/capture_replay --self-test [seconds]
+ */
+
+#include "base64.h"
+#include "GamepadDecoder.h"
+#include "GamepadState.h"
+#include "host_hal.h"
+#include "hostloop.h"
+#include "inputcapturelog.h"
+#include "SOCDState.h"
+#include "storagemanager.h"
+#include "drivers/hid/HIDDescriptors.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static const uint8_t DPAD_PINS[4] = { 2, 3, 4, 5 };
+static const uint8_t DPAD_MASKS[4] = { GAMEPAD_MASK_UP, GAMEPAD_MASK_DOWN, GAMEPAD_MASK_LEFT, GAMEPAD_MASK_RIGHT };
+static const uint8_t BUTTON_FIRST_PIN = 6;
+static const uint8_t BUTTON_COUNT = 12;
+
+// The loop runs at least this often between inputs, as the firmware does at 1 kHz polling
+static const uint32_t LOOP_INTERVAL_US = 1000;
+
+struct Replay {
+    HostLoop loop;
+    uint32_t captureUs = 0;
+    uint64_t hostUs = 0;
+    bool started = false;
+    char line[64];
+
+    Replay(SOCDMode mode, bool fourWay) {
+        Storage::getInstance().init();
+        configureHostStick(0);
+        GamepadOptions& gamepadOptions = Storage::getInstance().getGamepadOptions();
+        gamepadOptions.socdMode = mode;
+        gamepadOptions.fourWayMode = fourWay;
+    }
+
+    // The config changes go between the constructor and start()
+    void start(InputMode inputMode) {
+        HostHal::setGpio(~0U);
+        HostHal::setTimeUs(0);
+        loop.setup(inputMode);
+    }
+
+    // One loop at the current time, printing the report the driver sent if it did
+    void runLoop(std::string& out) {
+        HostHal::setTimeUs(hostUs);
+        if (!loop.run())
+            return;
+        uint16_t length;
+        const uint8_t* report = HostHal::usbReport(length);
+        snprintf(line, sizeof(line), "%u usb ", captureUs);
+        out += line;
+        for (uint16_t i = 0; i < length; i++) {
+            snprintf(line, sizeof(line), "%02x", report[i]);
+            out += line;
+        }
+        out += '\n';
+    }
+
+    // Loops every interval up to an input's time, the capture time wraps every 71 minutes
+    void runUntil(uint32_t timeUs, std::string& out) {
+        if (!started) {
+            started = true;
+            captureUs = timeUs;
+        }
+        uint32_t elapsed = timeUs - captureUs;
+        while (elapsed > LOOP_INTERVAL_US) {
+            captureUs += LOOP_INTERVAL_US;
+            hostUs += LOOP_INTERVAL_US;
+            elapsed -= LOOP_INTERVAL_US;
+            runLoop(out);
+        }
+        captureUs = timeUs;
+        hostUs += elapsed;
+    }
+
+    // Replays one input, returns false once the capture is done
+    bool step(InputCaptureReader& reader, InputCaptureEvent& event, std::string& out) {
+        if (!reader.next(event))
+            return false;
+        runUntil(event.timeUs, out);
+        switch (event.type) {
+            case INPUT_CAPTURE_GPIO:
+                snprintf(line, sizeof(line), "%u gpio %08x\n", event.timeUs, event.value);
+                out += line;
+                // the capture has the pressed pins, they read low
+                HostHal::setGpio(~event.value);
+                break;
+            case INPUT_CAPTURE_ADC:
+                snprintf(line, sizeof(line), "%u adc %02x %u\n", event.timeUs, event.source, event.value);
+                out += line;
+                HostHal::setAdc(event.source, event.value);
+                break;
+            case INPUT_CAPTURE_REPORT: {
+                snprintf(line, sizeof(line), "%u report %u:%u %u ", event.timeUs, event.source, event.instance, event.length);
+                out += line;
+                const uint16_t length = event.length < INPUT_CAPTURE_REPORT_MAX ? event.length : INPUT_CAPTURE_REPORT_MAX;
+                for (uint16_t i = 0; i < length; i++) {
+                    snprintf(line, sizeof(line), "%02x", event.report[i]);
+                    out += line;
+                }
+                out += '\n';
+                break;
+            }
+        }
+        runLoop(out);
+        return true;
+    }
+
+    void run(InputCaptureReader& reader, std::string& out) {
+        InputCaptureEvent event;
+        while (step(reader, event, out));
+    }
+};
+
+// The HID report a debounced GPIO word makes on the replay's stick, from the pin decoder and
+// SOCD cleaning on their own and HIDDriver's button order
+struct ExpectedHIDReport {
+    GamepadDecoder decoder;
+    SOCDState socd;
+    SOCDMode mode;
+
+    ExpectedHIDReport(SOCDMode mode) : mode(mode) {
+        decoder.clear();
+        for (int i = 0; i < 4; i++)
+            decoder.addDpad(1U << DPAD_PINS[i], DPAD_MASKS[i]);
+        for (int i = 0; i < BUTTON_COUNT; i++)
+            decoder.addButtons(1U << (BUTTON_FIRST_PIN + i), 1U << i);
+    }
+
+    HIDReport build(uint32_t gpio) {
+        static const uint8_t hats[16] = {
+            HID_HAT_NOTHING, HID_HAT_UP, HID_HAT_DOWN, HID_HAT_NOTHING,
+            HID_HAT_LEFT, HID_HAT_UPLEFT, HID_HAT_DOWNLEFT, HID_HAT_NOTHING,
+            HID_HAT_RIGHT, HID_HAT_UPRIGHT, HID_HAT_DOWNRIGHT, HID_HAT_NOTHING,
+            HID_HAT_NOTHING, HID_HAT_NOTHING, HID_HAT_NOTHING, HID_HAT_NOTHING,
+        };
+        GamepadDecoderEntry entry = decoder.decode(gpio);
+        const uint8_t dpad = socd.clean(mode, entry.dpad & 0x0F);
+        const uint32_t buttons = entry.buttons;
+
+        HIDReport report = {};
+        report.buttons = (buttons & ~(uint32_t)(GAMEPAD_MASK_B1 | GAMEPAD_MASK_B2 | GAMEPAD_MASK_B3))
+            | ((buttons & GAMEPAD_MASK_B1) ? GAMEPAD_MASK_B2 : 0)
+            | ((buttons & GAMEPAD_MASK_B2) ? GAMEPAD_MASK_B3 : 0)
+            | ((buttons & GAMEPAD_MASK_B3) ? GAMEPAD_MASK_B1 : 0)
+            | ((dpad & GAMEPAD_MASK_UP) ? GAMEPAD_MASK_DU : 0)
+            | ((dpad & GAMEPAD_MASK_DOWN) ? GAMEPAD_MASK_DD : 0)
+            | ((dpad & GAMEPAD_MASK_LEFT) ? GAMEPAD_MASK_DL : 0)
+            | ((dpad & GAMEPAD_MASK_RIGHT) ? GAMEPAD_MASK_DR : 0);
+        report.direction = hats[dpad];
+        report.l_x_axis = HID_JOYSTICK_MID;
+        report.l_y_axis = HID_JOYSTICK_MID;
+        report.r_x_axis = HID_JOYSTICK_MID;
+        report.r_y_axis = HID_JOYSTICK_MID;
+        return report;
+    }
+};
+
+static bool readFile(const char* path, std::string& contents) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+// The records of a saved /api/getInputCapture response
+static bool loadCapture(const std::string& json, std::vector<InputCaptureRecord>& records) {
+    const char* versionKey = "\"version\":";
+    size_t version = json.find(versionKey);
+    if (version == std::string::npos || atoi(json.c_str() + version + strlen(versionKey)) != INPUT_CAPTURE_VERSION) {
+        fprintf(stderr, "not a version %d capture\n", INPUT_CAPTURE_VERSION);
+        return false;
+    }
+
+    const char* dataKey = "\"data\":\"";
+    size_t start = json.find(dataKey);
+    if (start == std::string::npos)
+        return false;
+    start += strlen(dataKey);
+    size_t end = json.find('"', start);
+    if (end == std::string::npos)
+        return false;
+
+    std::string data;
+    if (!Base64::Decode(json.data() + start, end - start, data))
+        return false;
+    records.resize(data.size() / sizeof(InputCaptureRecord));
+    memcpy(records.data(), data.data(), records.size() * sizeof(InputCaptureRecord));
+    return true;
+}
+
+// What the writer was given, to compare with what is read back
+struct SourceEvent {
+    uint32_t timeUs;
+    uint8_t type;
+    uint8_t source;
+    uint32_t value;
+    std::vector<uint8_t> report;
+};
+
+// Replays the self-test capture on generic HID, comparing the report after every GPIO word with
+// the expected one, returns the mismatches
+static uint32_t replayChecked(const std::vector<InputCaptureRecord>& records, std::string& out, uint32_t& checked) {
+    Replay replay(SOCD_MODE_SECOND_INPUT_PRIORITY, false);
+    // S1 + S2 + up would switch the SOCD mode under the expected reports
+    Storage::getInstance().getHotkeyOptions().hotkey01.action = HOTKEY_NONE;
+    replay.start(INPUT_MODE_GENERIC);
+
+    ExpectedHIDReport expected(SOCD_MODE_SECOND_INPUT_PRIORITY);
+    InputCaptureReader reader(records.data(), records.size());
+    InputCaptureEvent event;
+    uint32_t mismatches = 0;
+    while (replay.step(reader, event, out)) {
+        if (event.type != INPUT_CAPTURE_GPIO)
+            continue;
+        const HIDReport report = expected.build(event.value);
+        uint16_t length;
+        const uint8_t* sent = HostHal::usbReport(length);
+        checked++;
+        if (length != sizeof(report) || memcmp(sent, &report, sizeof(report)) != 0) {
+            if (mismatches++ < 5)
+                printf("  HID report mismatch: %u gpio %08x\n", event.timeUs, event.value);
+        }
+    }
+    return mismatches;
+}
+
+static InputCaptureRing ring;
+
+static int selfTest(uint32_t seconds) {
+    std::mt19937 rng(1);
+    InputCaptureWriter writer;
+    writer.begin(ring);
+
+    std::vector<SourceEvent> events;
+    uint32_t gpio = 0;
+    uint16_t adc = 2048;
+    uint8_t pad[20] = { 0x00, 0x14 };     // an XInput report, buttons in bytes 2-3
+    uint32_t reports = 0;
+    for (uint32_t us = 0; us < seconds * 1000000; us += 125) {
+        if (rng() % 400 == 0) {
+            gpio ^= 1U << (2 + rng() % 16);
+            writer.gpio(gpio, us);
+            events.push_back({ us, INPUT_CAPTURE_GPIO, 0, gpio, {} });
+        }
+        if (us % 1000 == 0) {
+            // a settled stick sample only moves now and then
+            if (rng() % 20 == 0)
+                adc = 2048 + rng() % 16;
+            writer.adc(1, adc, us);
+            events.push_back({ us, INPUT_CAPTURE_ADC, 1, adc, {} });
+
+            // the pad reports every poll, a button or the triggers change now and then
+            if (rng() % 50 == 0)
+                pad[2 + rng() % 2] ^= 1 << (rng() % 8);
+            if (rng() % 25 == 0)
+                pad[4 + rng() % 2] = rng();
+            writer.report(1, 0, pad, sizeof(pad), us);
+            events.push_back({ us, INPUT_CAPTURE_REPORT, 1, 0, std::vector<uint8_t>(pad, pad + sizeof(pad)) });
+            reports++;
+        }
+    }
+
+    std::string encoded;
+    ring.appendBase64(encoded);
+    if (encoded.size() != ring.getBase64Size()) {
+        printf("FAIL: base64 is %zu characters, expected %zu\n", encoded.size(), ring.getBase64Size());
+        return 1;
+    }
+    std::string data;
+    Base64::Decode(encoded, data);
+    std::vector<InputCaptureRecord> records(data.size() / sizeof(InputCaptureRecord));
+    memcpy(records.data(), data.data(), records.size() * sizeof(InputCaptureRecord));
+    uint32_t count;
+    const uint32_t firstRecord = ring.getFirst(count);
+    for (uint32_t i = 0; i < count; i++) {
+        if (i >= records.size() || memcmp(&records[i], &ring.records[(firstRecord + i) & (INPUT_CAPTURE_SIZE - 1)], sizeof(InputCaptureRecord)) != 0) {
+            printf("FAIL: record %u doesn't match the ring after base64\n", i);
+            return 1;
+        }
+    }
+
+    // every input read back is the newest one of its source at that time
+    InputCaptureReader reader(records.data(), records.size());
+    InputCaptureEvent event;
+    size_t source = 0;
+    uint32_t read = 0;
+    uint32_t mismatches = 0;
+    uint32_t firstUs = 0;
+    uint32_t lastGpio = 0, lastAdc = 0;
+    std::vector<uint8_t> lastReport;
+    bool haveGpio = false, haveAdc = false, haveReport = false;
+    while (reader.next(event)) {
+        if (read++ == 0)
+            firstUs = event.timeUs;
+        for (; source < events.size() && events[source].timeUs <= event.timeUs; source++) {
+            const SourceEvent& e = events[source];
+            if (e.type == INPUT_CAPTURE_GPIO) { lastGpio = e.value; haveGpio = true; }
+            if (e.type == INPUT_CAPTURE_ADC) { lastAdc = e.value; haveAdc = true; }
+            if (e.type == INPUT_CAPTURE_REPORT) { lastReport = e.report; haveReport = true; }
+        }
+        bool match = true;
+        if (event.type == INPUT_CAPTURE_GPIO)
+            match = haveGpio && event.value == lastGpio;
+        else if (event.type == INPUT_CAPTURE_ADC)
+            match = haveAdc && event.value == lastAdc;
+        else if (event.type == INPUT_CAPTURE_REPORT)
+            match = haveReport && event.length == lastReport.size() &&
+                memcmp(event.report, lastReport.data(), lastReport.size()) == 0;
+        if (!match && mismatches++ < 5)
+            printf("  mismatch: %u type %u\n", event.timeUs, event.type);
+    }
+
+    const uint32_t coveredMs = (events.back().timeUs - firstUs) / 1000;
+    // a whole report took 1 record plus one for every 8 bytes
+    const uint32_t wholeRecords = 1 + (sizeof(pad) + INPUT_CAPTURE_REPORT_PART - 1) / INPUT_CAPTURE_REPORT_PART;
+    printf("%u reports, %u records written, %u kept, %u inputs read back over %u ms "
+        "(whole reports: %u ms), %u reports skipped, %u gaps\n",
+        reports, ring.head, ring.getCount(), read, coveredMs,
+        INPUT_CAPTURE_SIZE / wholeRecords, reader.getSkippedReports(), reader.getGaps());
+
+    // the driver's report after every GPIO word is the one the word makes, and the same capture
+    // replays to the same output
+    std::string first, second;
+    uint32_t checked = 0;
+    const uint32_t reportMismatches = replayChecked(records, first, checked);
+    uint32_t unused = 0;
+    replayChecked(records, second, unused);
+    printf("%u HID reports checked against their GPIO words\n", checked);
+
+    if (mismatches != 0 || reportMismatches != 0 || read == 0 || checked == 0 || first != second || reader.getGaps() != 0) {
+        printf("FAIL: %u mismatches, %u HID report mismatches%s\n", mismatches, reportMismatches,
+            first != second ? ", the replays differ" : "");
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--self-test") == 0)
+        return selfTest(argc > 2 ? (uint32_t)atoi(argv[2]) : 10);
+
+    const char* capturePath = nullptr;
+    const char* outputPath = nullptr;
+    const char* expectPath = nullptr;
+    InputMode inputMode = INPUT_MODE_GENERIC;
+    SOCDMode mode = SOCD_MODE_SECOND_INPUT_PRIORITY;
+    bool fourWay = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--input-mode") == 0 && i + 1 < argc)
+            inputMode = (InputMode)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--socd") == 0 && i + 1 < argc)
+            mode = (SOCDMode)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--four-way") == 0)
+            fourWay = true;
+        else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+            outputPath = argv[++i];
+        else if (strcmp(argv[i], "--expect") == 0 && i + 1 < argc)
+            expectPath = argv[++i];
+        else
+            capturePath = argv[i];
+    }
+    if (capturePath == nullptr) {
+        printf("usage: capture_replay capture.json [--input-mode <mode>] [--socd <mode>] [--four-way] [--output <file>] [--expect <file>]\n"
+            "       capture_replay --self-test [seconds]\n");
+        return 1;
+    }
+
+    std::string json;
+    std::vector<InputCaptureRecord> records;
+    if (!readFile(capturePath, json) || !loadCapture(json, records)) {
+        fprintf(stderr, "can't read a capture from %s\n", capturePath);
+        return 1;
+    }
+
+    std::string out;
+    InputCaptureReader reader(records.data(), records.size());
+    Replay replay(mode, fourWay);
+    replay.start(inputMode);
+    if (replay.loop.getDriver() == nullptr) {
+        fprintf(stderr, "input mode %d has no driver in the host build\n", inputMode);
+        return 1;
+    }
+    replay.run(reader, out);
+    printf("%zu records, %u gaps, %u reports skipped\n", records.size(), reader.getGaps(), reader.getSkippedReports());
+
+    if (outputPath != nullptr) {
+        std::ofstream(outputPath, std::ios::binary) << out;
+    } else if (expectPath == nullptr) {
+        fputs(out.c_str(), stdout);
+    }
+
+    if (expectPath != nullptr) {
+        std::string expected;
+        if (!readFile(expectPath, expected)) {
+            fprintf(stderr, "can't read %s\n", expectPath);
+            return 1;
+        }
+        if (expected != out) {
+            size_t at = 0;
+            while (at < expected.size() && at < out.size() && expected[at] == out[at])
+                at++;
+            const size_t line = std::count(out.begin(), out.begin() + at, '\n') + 1;
+            printf("FAIL: the output differs from %s at line %zu\n", expectPath, line);
+            return 1;
+        }
+        printf("the output matches %s\n", expectPath);
+    }
+    return 0;
+}
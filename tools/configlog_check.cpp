@@ -0,0 +1,198 @@
+/*
+ * Host-side check of the config record log (ConfigLog) on a simulated flash, with power cuts.
+ *
+ * SimFlash behaves like the FlashPROM region: erasing sets a whole sector to 0xFF, programming
+ * a page can only clear bits. Saves go the way ConfigUtils::save and FlashPROM do them: the
+ * record is reserved and sealed in the write cache, then the writer walks the region and
+ * erases or programs whatever differs from the cache, in FlashPROM::writeNext's order.
+ *
+ * Every save is cut short at every one of its flash operations in turn, and also half way
+ * through programming the page it was on, then the flash is read back as at boot: the newest
+ * valid record has to be the config being saved or the one before it, never anything else and
+ * never nothing. The save is then done in full and the next one starts from there, so the log
+ * wraps around the region several times with records of changing sizes.
+ *
+ * It prints the flash operations per save and the erases per sector, against rewriting the
+ * whole region on every save.
+ *
+ * Build and run with the host build (tools/CMakeLists.txt):
+ *   cmake -S tools -B build-host && cmake --build build-host
+ *   ./build-host/configlog_check [saves]
+ */
+
+#include "configlog.h"
+#include "CRC32.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#define REGION_SIZE 0x8000
+#define SECTORS (REGION_SIZE / CONFIG_LOG_SECTOR_SIZE)
+
+struct SimFlash {
+    uint8_t data[REGION_SIZE];
+    uint32_t erases[SECTORS] = {};
+    uint32_t programs = 0;
+
+    SimFlash() { memset(data, 0xFF, sizeof(data)); }
+
+    void erase(uint32_t sector) {
+        memset(data + sector, 0xFF, CONFIG_LOG_SECTOR_SIZE);
+        erases[sector / CONFIG_LOG_SECTOR_SIZE]++;
+    }
+
+    // bytes of the page actually programmed, less when the power goes half way through
+    void program(uint32_t page, const uint8_t* cache, uint32_t bytes = CONFIG_LOG_PAGE_SIZE) {
+        for (uint32_t i = 0; i < bytes; i++)
+            data[page + i] &= cache[page + i];
+        programs++;
+    }
+};
+
+static bool programOnly(const uint8_t* flash, const uint8_t* cache, uint32_t size) {
+    for (uint32_t i = 0; i < size; i++) {
+        if ((flash[i] & cache[i]) != cache[i])
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Write the cache to the flash as FlashPROM::writeNext does, for at most maxOperations.
+ *
+ * A cut that lands on a page program leaves that page half programmed when tornPage is set.
+ * Returns the operations done, less than maxOperations once the flash matches the cache.
+ */
+static uint32_t writeCache(SimFlash& flash, const uint8_t* cache, uint32_t maxOperations, bool tornPage) {
+    uint32_t operations = 0;
+    uint32_t position = 0;
+    while (position < REGION_SIZE) {
+        const uint32_t sector = position & ~(CONFIG_LOG_SECTOR_SIZE - 1);
+        if (position == sector && memcmp(flash.data + sector, cache + sector, CONFIG_LOG_SECTOR_SIZE) == 0) {
+            position += CONFIG_LOG_SECTOR_SIZE;
+            continue;
+        }
+        if (memcmp(flash.data + position, cache + position, CONFIG_LOG_PAGE_SIZE) == 0) {
+            position += CONFIG_LOG_PAGE_SIZE;
+            continue;
+        }
+
+        const bool program = programOnly(flash.data + position, cache + position, CONFIG_LOG_PAGE_SIZE);
+        if (operations == maxOperations) {
+            if (program && tornPage)
+                flash.program(position, cache, CONFIG_LOG_PAGE_SIZE / 2);
+            return operations;
+        }
+        operations++;
+        if (program) {
+            flash.program(position, cache);
+            position += CONFIG_LOG_PAGE_SIZE;
+        } else {
+            flash.erase(sector);
+            position = sector;
+        }
+    }
+    return operations;
+}
+
+// Append a record as ConfigUtils::save does, into the cache
+static bool appendRecord(uint8_t* cache, const std::vector<uint8_t>& config) {
+    const ConfigLogRecord latest = ConfigLog::findLatest(cache, REGION_SIZE);
+    ConfigLogRecord record;
+    uint8_t* data = ConfigLog::reserve(cache, REGION_SIZE, latest, config.size(), record);
+    if (data == nullptr)
+        return false;
+    memcpy(data, config.data(), config.size());
+    ConfigLog::seal(cache, record, CRC32::calculate(config.data(), config.size()));
+    return true;
+}
+
+static bool holds(const uint8_t* region, const ConfigLogRecord& record, const std::vector<uint8_t>& config) {
+    return record.valid && record.dataSize == config.size() &&
+        memcmp(record.data(region), config.data(), config.size()) == 0;
+}
+
+int main(int argc, char** argv) {
+    const uint32_t saves = argc > 1 ? (uint32_t)atoi(argv[1]) : 200;
+
+    std::mt19937 rng(1);
+    SimFlash flash;
+    static uint8_t cache[REGION_SIZE];
+    memset(cache, 0xFF, sizeof(cache));
+
+    std::vector<uint8_t> previous;
+    uint32_t failures = 0;
+    uint32_t cuts = 0;
+    uint32_t lastSequence = 0;
+    uint64_t operationsTotal = 0;
+    SimFlash counted;   // erases and programs of the saves that weren't cut
+
+    for (uint32_t save = 0; save < saves; save++) {
+        // a config of a typical size, now and then a large one that pushes older records out
+        std::vector<uint8_t> config(rng() % 8 == 0 ? 6000 + rng() % 6000 : 1500 + rng() % 1500);
+        for (uint8_t& byte : config)
+            byte = rng();
+
+        // the write cache starts from the flash, as after a boot
+        memcpy(cache, flash.data, REGION_SIZE);
+        if (!appendRecord(cache, config)) {
+            printf("save %u: no room for %zu bytes\n", save, config.size());
+            failures++;
+            continue;
+        }
+
+        // cut the power at every operation of this save, with and without a torn page
+        for (uint32_t cut = 0; ; cut++) {
+            bool done = false;
+            for (int torn = 0; torn < 2; torn++) {
+                SimFlash trial = flash;
+                done = writeCache(trial, cache, cut, torn) < cut;
+                cuts++;
+
+                const ConfigLogRecord latest = ConfigLog::findLatest(trial.data, REGION_SIZE);
+                const bool ok = holds(trial.data, latest, config) || (!previous.empty() && holds(trial.data, latest, previous)) ||
+                    (previous.empty() && !latest.valid);
+                if (!ok && failures++ < 5)
+                    printf("save %u, cut after %u operations%s: lost the config\n", save, cut, torn ? " (torn page)" : "");
+            }
+            if (done)
+                break;
+        }
+
+        // then the save goes through
+        const uint32_t operations = writeCache(flash, cache, UINT32_MAX, false);
+        writeCache(counted, cache, UINT32_MAX, false);
+        operationsTotal += operations;
+        const ConfigLogRecord latest = ConfigLog::findLatest(flash.data, REGION_SIZE);
+        if (!holds(flash.data, latest, config) || latest.sequence <= lastSequence) {
+            if (failures++ < 5)
+                printf("save %u: the newest record isn't the one saved\n", save);
+        }
+        lastSequence = latest.sequence;
+        previous = config;
+    }
+
+    uint32_t erases = 0, maxErases = 0;
+    for (uint32_t sector = 0; sector < SECTORS; sector++) {
+        erases += counted.erases[sector];
+        if (counted.erases[sector] > maxErases)
+            maxErases = counted.erases[sector];
+    }
+    printf("%u saves, %u power cuts: %.2f sector erases and %.1f page programs per save "
+        "(rewriting the region: %u and %u), at most %u erases of one sector\n",
+        saves, cuts, (double)erases / saves, (double)counted.programs / saves,
+        SECTORS, REGION_SIZE / CONFIG_LOG_PAGE_SIZE, maxErases);
+    printf("erases per sector:");
+    for (uint32_t sector = 0; sector < SECTORS; sector++)
+        printf(" %u", counted.erases[sector]);
+    printf("\n");
+
+    if (failures != 0) {
+        printf("FAIL: %u failures\n", failures);
+        return 1;
+    }
+    return 0;
+}
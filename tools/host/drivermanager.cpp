@@ -0,0 +1,57 @@
+/*
+ * The driver manager for the host build, with only the drivers that build on the host: those
+ * sending their reports through the TinyUSB HID class, see tools/host/tusb.cpp.
+ */
+
+#include "drivermanager.h"
+#include "usbhostmanager.h"
+
+#include "drivers/astro/AstroDriver.h"
+#include "drivers/egret/EgretDriver.h"
+#include "drivers/hid/HIDDriver.h"
+#include "drivers/mdmini/MDMiniDriver.h"
+#include "drivers/neogeo/NeoGeoDriver.h"
+#include "drivers/pcengine/PCEngineDriver.h"
+#include "drivers/psclassic/PSClassicDriver.h"
+#include "drivers/switch/SwitchDriver.h"
+
+void DriverManager::setup(InputMode mode) {
+    switch (mode) {
+        case INPUT_MODE_ASTRO:
+            driver = new AstroDriver();
+            break;
+        case INPUT_MODE_EGRET:
+            driver = new EgretDriver();
+            break;
+        case INPUT_MODE_GENERIC:
+            driver = new HIDDriver();
+            break;
+        case INPUT_MODE_MDMINI:
+            driver = new MDMiniDriver();
+            break;
+        case INPUT_MODE_NEOGEO:
+            driver = new NeoGeoDriver();
+            break;
+        case INPUT_MODE_PSCLASSIC:
+            driver = new PSClassicDriver();
+            break;
+        case INPUT_MODE_PCEMINI:
+            driver = new PCEngineDriver();
+            break;
+        case INPUT_MODE_SWITCH:
+            driver = new SwitchDriver();
+            break;
+        default:
+            driver = nullptr;
+            return;
+    }
+
+    driver->initialize();
+    inputMode = mode;
+}
+
+// No USB host port, the USB host add-ons are never loaded
+void USBHostManager::start() {}
+void USBHostManager::shutdown() {}
+void USBHostManager::pushListener(USBListener* listener) {}
+void USBHostManager::process() {}
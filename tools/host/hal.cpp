@@ -0,0 +1,45 @@
+/*
+ * The pico-sdk functions the host build links against instead of the hardware, see
+ * tools/host/include/host_hal.h.
+ */
+
+#include "host_hal.h"
+
+#include "hardware/adc.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+#include "pico/time.h"
+
+static uint32_t gpioLevels = 0xFFFFFFFF;
+static uint16_t adcValues[NUM_ADC_CHANNELS] = {};
+static uint adcInput = 0;
+static uint64_t nowUs = 0;
+static spin_lock_t spinLocks[32];
+
+void HostHal::setGpio(uint32_t levels) { gpioLevels = levels; }
+
+void HostHal::setAdc(uint32_t input, uint16_t value) {
+    if (input < NUM_ADC_CHANNELS)
+        adcValues[input] = value & 0x0FFF;
+}
+
+void HostHal::setTimeUs(uint64_t us) { nowUs = us; }
+void HostHal::advanceUs(uint64_t us) { nowUs += us; }
+uint64_t HostHal::timeUs() { return nowUs; }
+
+uint32_t gpio_get_all() { return gpioLevels; }
+bool gpio_get(uint gpio) { return (gpioLevels >> gpio) & 1; }
+
+void adc_select_input(uint input) { adcInput = input; }
+uint adc_get_selected_input() { return adcInput; }
+uint16_t adc_read() { return adcInput < NUM_ADC_CHANNELS ? adcValues[adcInput] : 0; }
+
+// Waiting moves the timer on, nothing else would
+void sleep_us(uint64_t us) { nowUs += us; }
+void sleep_ms(uint32_t ms) { nowUs += ms * 1000ull; }
+void sleep_until(absolute_time_t t) {
+    if (t > nowUs)
+        nowUs = t;
+}
+
+spin_lock_t* spin_lock_instance(uint lock_num) { return &spinLocks[lock_num & 31]; }
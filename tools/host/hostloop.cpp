@@ -0,0 +1,156 @@
+#include "hostloop.h"
+
+#include "drivermanager.h"
+#include "storagemanager.h"
+
+#include "addons/analog.h"
+#include "addons/dualdirectional.h"
+#include "addons/focus_mode.h"
+#include "addons/input_macro.h"
+#include "addons/reverse.h"
+#include "addons/slider_socd.h"
+#include "addons/tilt.h"
+#include "addons/turbo.h"
+
+#include <string.h>
+
+void configureHostStick(uint32_t debounceDelay) {
+    static const GpioAction buttonActions[] = {
+        GpioAction::BUTTON_PRESS_UP, GpioAction::BUTTON_PRESS_DOWN, GpioAction::BUTTON_PRESS_LEFT, GpioAction::BUTTON_PRESS_RIGHT,
+        GpioAction::BUTTON_PRESS_B1, GpioAction::BUTTON_PRESS_B2, GpioAction::BUTTON_PRESS_B3, GpioAction::BUTTON_PRESS_B4,
+        GpioAction::BUTTON_PRESS_L1, GpioAction::BUTTON_PRESS_R1, GpioAction::BUTTON_PRESS_L2, GpioAction::BUTTON_PRESS_R2,
+        GpioAction::BUTTON_PRESS_S1, GpioAction::BUTTON_PRESS_S2, GpioAction::BUTTON_PRESS_L3, GpioAction::BUTTON_PRESS_R3,
+        GpioAction::BUTTON_PRESS_TURBO, GpioAction::BUTTON_PRESS_INPUT_REVERSE,
+    };
+    GpioMappings& gpioMappings = Storage::getInstance().getGpioMappings();
+    gpioMappings.pins_count = NUM_BANK0_GPIOS;
+    for (Pin_t pin = 0; pin < (Pin_t)NUM_BANK0_GPIOS; pin++)
+        gpioMappings.pins[pin].action = GpioAction::NONE;
+    for (size_t i = 0; i < sizeof(buttonActions) / sizeof(buttonActions[0]); i++)
+        gpioMappings.pins[2 + i].action = buttonActions[i];
+
+    GamepadOptions& gamepadOptions = Storage::getInstance().getGamepadOptions();
+    gamepadOptions.debounceDelay = debounceDelay;
+    gamepadOptions.debounceMode = DEBOUNCE_MODE_SYMMETRIC;
+    gamepadOptions.socdMode = SOCD_MODE_SECOND_INPUT_PRIORITY;
+    gamepadOptions.dpadMode = DPAD_MODE_DIGITAL;
+
+    HotkeyEntry& hotkey = Storage::getInstance().getHotkeyOptions().hotkey01;
+    hotkey.action = HOTKEY_SOCD_UP_PRIORITY;
+    hotkey.dpadMask = GAMEPAD_MASK_UP;
+    hotkey.buttonsMask = GAMEPAD_MASK_S1 | GAMEPAD_MASK_S2;
+
+    AddonOptions& addonOptions = Storage::getInstance().getAddonOptions();
+    TurboOptions& turboOptions = addonOptions.turboOptions;
+    turboOptions.enabled = true;
+    turboOptions.shotCount = 20;
+    turboOptions.ledPin = -1;
+    turboOptions.shmupDialPin = -1;
+    ReverseOptions& reverseOptions = addonOptions.reverseOptions;
+    reverseOptions.enabled = true;
+    reverseOptions.ledPin = -1;
+    reverseOptions.actionUp = 1;
+    reverseOptions.actionDown = 1;
+    reverseOptions.actionLeft = 1;
+    reverseOptions.actionRight = 1;
+}
+
+void HostLoop::setup(InputMode inputMode) {
+    gamepad = new Gamepad();
+    processedGamepad = new Gamepad();
+    Storage::getInstance().SetGamepad(gamepad);
+    Storage::getInstance().SetProcessedGamepad(processedGamepad);
+    Storage::getInstance().SetSnapshotGamepad(new Gamepad());
+    Storage::getInstance().setFunctionalPinMappings();
+
+    gamepad->setup();
+    gamepad->lastReinitProfileNumber = Storage::getInstance().getGamepadOptions().profileNumber;
+    buttonGpios = 0;
+    updateStandardGpio();
+
+    // in the order GP2040::setup loads them
+    addons.LoadAddon(new AnalogInput());
+    addons.LoadAddon(new DualDirectionalInput());
+    addons.LoadAddon(new FocusModeAddon());
+    addons.LoadAddon(new SliderSOCDInput());
+    addons.LoadAddon(new TiltInput());
+    addons.LoadAddon(new ReverseInput());
+    addons.LoadAddon(new TurboInput());
+    addons.LoadAddon(new InputMacro());
+
+    DriverManager::getInstance().setup(inputMode);
+    driver = DriverManager::getInstance().getDriver();
+    AddonManager::InitProfile(inputMode);
+}
+
+bool HostLoop::run() {
+    GamepadState prevState;
+
+    reinitGamepad();
+    EventManager::getInstance().processEvents();
+    memcpy(&prevState, &gamepad->state, sizeof(GamepadState));
+
+    debounceGpioGetAll();
+    gamepad->read();
+    inputFrame.setRaw(prevState, gamepad->state);
+
+    addons.PreprocessAddons();
+    gamepad->hotkey();
+    gamepad->process();
+    addons.ProcessAddons();
+
+    inputFrame.setProcessed(processedGamepad->state, gamepad->state);
+    if (inputFrame.changes != 0)
+        EventManager::getInstance().triggerEvent(inputFrame);
+
+    memcpy(&processedGamepad->state, &gamepad->state, sizeof(GamepadState));
+    Storage::getInstance().PublishProcessedGamepad();
+
+    bool processed = driver != nullptr && driver->process(gamepad);
+    tud_task();
+    addons.PostprocessAddons(processed);
+    return processed;
+}
+
+/**
+ * @brief GP2040::getReinitGamepad, less the GPIO setup.
+ */
+void HostLoop::reinitGamepad() {
+    const GamepadOptions& gamepadOptions = Storage::getInstance().getGamepadOptions();
+    if (gamepad->lastReinitProfileNumber == gamepadOptions.profileNumber)
+        return;
+
+    uint32_t previousProfile = gamepad->lastReinitProfileNumber;
+    uint32_t currentProfile = gamepadOptions.profileNumber;
+    Storage::getInstance().setFunctionalPinMappings();
+    updateStandardGpio();
+    gamepad->reinit();
+    if (!gamepad->sharesAddonPins(previousProfile, currentProfile))
+        addons.ReinitializeAddons();
+    gamepad->lastReinitProfileNumber = currentProfile;
+    EventManager::getInstance().triggerEvent(GPProfileChangeEvent(previousProfile, currentProfile));
+}
+
+void HostLoop::updateStandardGpio() {
+    GpioMappingInfo* pinMappings = Storage::getInstance().getProfilePinMappings();
+    buttonGpios = 0;
+    for (Pin_t pin = 0; pin < (Pin_t)NUM_BANK0_GPIOS; pin++) {
+        if (pinMappings[pin].action > 0)
+            buttonGpios |= 1 << pin;
+    }
+}
+
+/**
+ * @brief GP2040::debounceGpioGetAll, reading the pins once per loop.
+ */
+void HostLoop::debounceGpioGetAll() {
+    Mask_t raw_gpio = ~gpio_get_all() & buttonGpios;
+    if (gamepad->debouncedGpio == raw_gpio) {
+        debouncer.settle();
+        return;
+    }
+
+    const GamepadOptions& gamepadOptions = Storage::getInstance().getGamepadOptions();
+    debouncer.configure(gamepadOptions.debounceDelay, gamepadOptions.debounceMode);
+    gamepad->debouncedGpio = debouncer.update(raw_gpio, gamepad->debouncedGpio, getMillis());
+}
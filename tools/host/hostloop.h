@@ -0,0 +1,49 @@
+/*
+ * One core0 loop of GP2040::run on the host: events, debounce, read, the add-on phases, hotkeys,
+ * process and the driver's report, with the firmware's own Gamepad, AddonManager, EventManager,
+ * input add-ons and drivers. What the loop waits on (the start of frame, idle sleep) and what only
+ * the hardware has (oversampling, edge capture, USB host, the latency and loop statistics) is
+ * left out.
+ *
+ * The inputs come from HostHal, set them between loops. Storage::init() and the config changes
+ * go before setup().
+ */
+
+#ifndef HOST_LOOP_H_
+#define HOST_LOOP_H_
+
+#include "addonmanager.h"
+#include "eventmanager.h"
+#include "gamepad.h"
+#include "gamepad/GamepadDebouncer.h"
+#include "gpdriver.h"
+
+// The stick the host tools run, on top of Storage::init(): the dpad on pins 2-5 and B1 to R3 on
+// pins 6-17, turbo on 18 and input reverse on 19 with those add-ons on, S1 + S2 + up for up
+// priority SOCD, and the given debounce delay (0 for none)
+void configureHostStick(uint32_t debounceDelay);
+
+class HostLoop {
+public:
+    // Loads the input add-ons that build on the host, as GP2040::setup does
+    void setup(InputMode inputMode);
+    // Returns whether the driver sent a report
+    bool run();
+
+    Gamepad* getGamepad() { return gamepad; }
+    GPDriver* getDriver() { return driver; }
+private:
+    void reinitGamepad();
+    void updateStandardGpio();
+    void debounceGpioGetAll();
+
+    Gamepad* gamepad = nullptr;
+    Gamepad* processedGamepad = nullptr;
+    GPDriver* driver = nullptr;
+    AddonManager addons;
+    GamepadDebouncer debouncer;
+    Mask_t buttonGpios = 0;
+    GPInputFrameEvent inputFrame;
+};
+
+#endif
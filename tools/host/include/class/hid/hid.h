@@ -0,0 +1,15 @@
+// Host stand-in for the TinyUSB header of the same name, see tools/host/include/host_hal.h
+
+#ifndef HOST_CLASS_HID_H_
+#define HOST_CLASS_HID_H_
+
+#include <stdint.h>
+
+typedef enum {
+    HID_REPORT_TYPE_INVALID = 0,
+    HID_REPORT_TYPE_INPUT,
+    HID_REPORT_TYPE_OUTPUT,
+    HID_REPORT_TYPE_FEATURE
+} hid_report_type_t;
+
+#endif
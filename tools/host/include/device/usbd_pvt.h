@@ -0,0 +1,13 @@
+// Host stand-in for the TinyUSB header of the same name, see tools/host/include/tusb.h
+
+#ifndef HOST_DEVICE_USBD_PVT_H_
+#define HOST_DEVICE_USBD_PVT_H_
+
+#include "tusb.h"
+
+bool usbd_edpt_claim(uint8_t rhport, uint8_t ep_addr);
+bool usbd_edpt_release(uint8_t rhport, uint8_t ep_addr);
+bool usbd_edpt_busy(uint8_t rhport, uint8_t ep_addr);
+bool usbd_edpt_xfer(uint8_t rhport, uint8_t ep_addr, uint8_t* buffer, uint16_t total_bytes);
+
+#endif
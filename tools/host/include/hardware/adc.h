@@ -0,0 +1,16 @@
+// Host stand-in for the pico-sdk header of the same name, see tools/host/include/host_hal.h
+
+#ifndef HOST_HARDWARE_ADC_H_
+#define HOST_HARDWARE_ADC_H_
+
+#include "pico/types.h"
+
+void adc_select_input(uint input);
+uint adc_get_selected_input();
+uint16_t adc_read();
+
+static inline void adc_init() {}
+static inline void adc_gpio_init(uint) {}
+static inline void adc_set_temp_sensor_enabled(bool) {}
+
+#endif
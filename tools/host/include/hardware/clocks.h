@@ -0,0 +1,24 @@
+// Host stand-in for the pico-sdk header of the same name, see tools/host/include/host_hal.h
+
+#ifndef HOST_HARDWARE_CLOCKS_H_
+#define HOST_HARDWARE_CLOCKS_H_
+
+#include "pico/types.h"
+
+enum clock_index {
+    clk_gpout0 = 0,
+    clk_gpout1,
+    clk_gpout2,
+    clk_gpout3,
+    clk_ref,
+    clk_sys,
+    clk_peri,
+    clk_usb,
+    clk_adc,
+    clk_rtc,
+    CLK_COUNT
+};
+
+static inline uint32_t clock_get_hz(enum clock_index) { return 125000000; }
+
+#endif
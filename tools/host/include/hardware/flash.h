@@ -0,0 +1,13 @@
+// Host stand-in for the pico-sdk header of the same name, see tools/host/include/host_hal.h
+
+#ifndef HOST_HARDWARE_FLASH_H_
+#define HOST_HARDWARE_FLASH_H_
+
+#include "pico/types.h"
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+#define FLASH_BLOCK_SIZE (1u << 16)
+#define XIP_BASE 0x10000000u
+
+#endif
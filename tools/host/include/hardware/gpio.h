@@ -0,0 +1,44 @@
+// Host stand-in for the pico-sdk header of the same name, see tools/host/include/host_hal.h
+
+#ifndef HOST_HARDWARE_GPIO_H_
+#define HOST_HARDWARE_GPIO_H_
+
+#include "pico/types.h"
+
+#define GPIO_IN false
+#define GPIO_OUT true
+
+enum gpio_function {
+    GPIO_FUNC_XIP = 0,
+    GPIO_FUNC_SPI = 1,
+    GPIO_FUNC_UART = 2,
+    GPIO_FUNC_I2C = 3,
+    GPIO_FUNC_PWM = 4,
+    GPIO_FUNC_SIO = 5,
+    GPIO_FUNC_PIO0 = 6,
+    GPIO_FUNC_PIO1 = 7,
+    GPIO_FUNC_GPCK = 8,
+    GPIO_FUNC_USB = 9,
+    GPIO_FUNC_NULL = 0x1f,
+};
+
+uint32_t gpio_get_all();
+bool gpio_get(uint gpio);
+
+// Outputs and pin setup don't change what the inputs read
+static inline void gpio_init(uint) {}
+static inline void gpio_deinit(uint) {}
+static inline void gpio_init_mask(uint32_t) {}
+static inline void gpio_set_dir(uint, bool) {}
+static inline void gpio_set_dir_in_masked(uint32_t) {}
+static inline void gpio_set_dir_out_masked(uint32_t) {}
+static inline void gpio_pull_up(uint) {}
+static inline void gpio_pull_down(uint) {}
+static inline void gpio_disable_pulls(uint) {}
+static inline void gpio_set_function(uint, enum gpio_function) {}
+static inline void gpio_put(uint, bool) {}
+static inline void gpio_put_masked(uint32_t, uint32_t) {}
+static inline void gpio_set_mask(uint32_t) {}
+static inline void gpio_clr_mask(uint32_t) {}
+
+#endif
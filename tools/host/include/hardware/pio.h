@@ -0,0 +1,14 @@
+// Host stand-in for the pico-sdk header of the same name, see tools/host/include/host_hal.h
+
+#ifndef HOST_HARDWARE_PIO_H_
+#define HOST_HARDWARE_PIO_H_
+
+#include "pico/types.h"
+
+typedef struct pio_hw_t pio_hw_t;
+typedef pio_hw_t* PIO;
+
+#define pio0 ((PIO)nullptr)
+#define pio1 ((PIO)nullptr)
+
+#endif
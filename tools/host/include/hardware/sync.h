@@ -0,0 +1,25 @@
+// Host stand-in for the pico-sdk header of the same name, see tools/host/include/host_hal.h
+//
+// The host tools run the firmware code on one thread, so locks and interrupt masking are no-ops.
+
+#ifndef HOST_HARDWARE_SYNC_H_
+#define HOST_HARDWARE_SYNC_H_
+
+#include "pico/types.h"
+
+typedef volatile uint32_t spin_lock_t;
+
+static inline uint32_t save_and_disable_interrupts() { return 0; }
+static inline void restore_interrupts(uint32_t) {}
+static inline void restore_interrupts_from_disabled(uint32_t) {}
+
+spin_lock_t* spin_lock_instance(uint lock_num);
+static inline spin_lock_t* spin_lock_init(uint lock_num) { return spin_lock_instance(lock_num); }
+static inline uint next_striped_spin_lock_num() { return 0; }
+static inline uint spin_lock_claim_unused(bool) { return 0; }
+static inline uint32_t spin_lock_blocking(spin_lock_t*) { return 0; }
+static inline void spin_unlock(spin_lock_t*, uint32_t) {}
+static inline void spin_lock_unsafe_blocking(spin_lock_t*) {}
+static inline void spin_unlock_unsafe(spin_lock_t*) {}
+
+#endif
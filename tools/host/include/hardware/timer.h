@@ -0,0 +1,12 @@
+// Host stand-in for the pico-sdk header of the same name, see tools/host/include/host_hal.h
+
+#ifndef HOST_HARDWARE_TIMER_H_
+#define HOST_HARDWARE_TIMER_H_
+
+#include "pico/types.h"
+#include "host_hal.h"
+
+static inline uint64_t time_us_64() { return HostHal::timeUs(); }
+static inline uint32_t time_us_32() { return (uint32_t)HostHal::timeUs(); }
+
+#endif
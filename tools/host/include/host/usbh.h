@@ -0,0 +1,8 @@
+// Host stand-in for the TinyUSB header of the same name, see tools/host/usbhostmanager.cpp
+
+#ifndef HOST_HOST_USBH_H_
+#define HOST_HOST_USBH_H_
+
+#include "tusb.h"
+
+#endif
@@ -0,0 +1,10 @@
+// Host stand-in for the TinyUSB header of the same name, see tools/host/usbhostmanager.cpp
+
+#ifndef HOST_HOST_USBH_PVT_H_
+#define HOST_HOST_USBH_PVT_H_
+
+#include "host/usbh.h"
+
+typedef struct usbh_class_driver_t usbh_class_driver_t;
+
+#endif
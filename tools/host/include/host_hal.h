@@ -0,0 +1,29 @@
+/*
+ * What the host stand-ins for the pico-sdk and TinyUSB read from and write to: the GPIO levels,
+ * the ADC inputs and the microsecond timer, all set by the tool driving the firmware code, and the
+ * reports the drivers send. See tools/host/hal.cpp and tools/host/tusb.cpp.
+ */
+
+#ifndef HOST_HAL_H_
+#define HOST_HAL_H_
+
+#include <stdint.h>
+
+namespace HostHal {
+    // Levels returned by gpio_get_all/gpio_get, pulled up pins read high when not pressed
+    void setGpio(uint32_t levels);
+    // Value returned by adc_read for an input, 12 bits
+    void setAdc(uint32_t input, uint16_t value);
+    // The timer only moves when told to
+    void setTimeUs(uint64_t us);
+    void advanceUs(uint64_t us);
+    uint64_t timeUs();
+
+    // The drivers only send a report when the device stack is ready for one
+    void setUsbReady(bool ready);
+    // The last report a driver sent, and how many it has sent
+    const uint8_t* usbReport(uint16_t& length);
+    uint32_t usbReportCount();
+}
+
+#endif
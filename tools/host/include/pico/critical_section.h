@@ -0,0 +1,19 @@
+// Host stand-in for the pico-sdk header of the same name, see tools/host/include/hardware/sync.h
+
+#ifndef HOST_PICO_CRITICAL_SECTION_H_
+#define HOST_PICO_CRITICAL_SECTION_H_
+
+#include "pico/lock_core.h"
+
+typedef struct {
+    lock_core_t core;
+    uint32_t save;
+} critical_section_t;
+
+static inline void critical_section_init(critical_section_t*) {}
+static inline void critical_section_init_with_lock_num(critical_section_t*, uint) {}
+static inline void critical_section_enter_blocking(critical_section_t*) {}
+static inline void critical_section_exit(critical_section_t*) {}
+static inline void critical_section_deinit(critical_section_t*) {}
+
+#endif
@@ -0,0 +1,12 @@
+// Host stand-in for the pico-sdk header of the same name, see tools/host/include/hardware/sync.h
+
+#ifndef HOST_PICO_LOCK_CORE_H_
+#define HOST_PICO_LOCK_CORE_H_
+
+#include "hardware/sync.h"
+
+typedef struct {
+    spin_lock_t* spin_lock;
+} lock_core_t;
+
+#endif
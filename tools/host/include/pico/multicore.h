@@ -0,0 +1,19 @@
+// Host stand-in for the pico-sdk header of the same name, see tools/host/include/hardware/sync.h
+//
+// There is no second core: what core1 runs in the firmware, a host tool calls itself.
+
+#ifndef HOST_PICO_MULTICORE_H_
+#define HOST_PICO_MULTICORE_H_
+
+#include "pico/types.h"
+
+static inline void multicore_launch_core1(void (*)(void)) {}
+static inline void multicore_reset_core1() {}
+static inline void multicore_lockout_victim_init() {}
+static inline void multicore_lockout_start_blocking() {}
+static inline void multicore_lockout_end_blocking() {}
+static inline bool multicore_lockout_start_timeout_us(uint64_t) { return true; }
+static inline bool multicore_lockout_end_timeout_us(uint64_t) { return true; }
+static inline bool multicore_lockout_victim_is_initialized(uint) { return false; }
+
+#endif
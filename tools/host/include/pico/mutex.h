@@ -0,0 +1,24 @@
+// Host stand-in for the pico-sdk header of the same name, see tools/host/include/hardware/sync.h
+
+#ifndef HOST_PICO_MUTEX_H_
+#define HOST_PICO_MUTEX_H_
+
+#include "pico/lock_core.h"
+
+typedef struct {
+    lock_core_t core;
+} mutex_t;
+
+typedef struct {
+    lock_core_t core;
+} recursive_mutex_t;
+
+static inline void mutex_init(mutex_t*) {}
+static inline void mutex_enter_blocking(mutex_t*) {}
+static inline bool mutex_try_enter(mutex_t*, uint32_t*) { return true; }
+static inline void mutex_exit(mutex_t*) {}
+static inline void recursive_mutex_init(recursive_mutex_t*) {}
+static inline void recursive_mutex_enter_blocking(recursive_mutex_t*) {}
+static inline void recursive_mutex_exit(recursive_mutex_t*) {}
+
+#endif
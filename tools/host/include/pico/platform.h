@@ -0,0 +1,34 @@
+// Host stand-in for the pico-sdk header of the same name, see tools/host/include/host_hal.h
+
+#ifndef HOST_PICO_PLATFORM_H_
+#define HOST_PICO_PLATFORM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define NUM_BANK0_GPIOS 30
+#define NUM_ADC_CHANNELS 5
+#define NUM_CORES 2
+
+#ifndef _u
+#define _u(x) x ## u
+#endif
+
+#define __not_in_flash_func(func) func
+#define __time_critical_func(func) func
+#define __no_inline_not_in_flash_func(func) func
+#define __force_inline inline
+#define __isr
+#define __uninitialized_ram(name) name
+#define __unused __attribute__((unused))
+
+typedef unsigned int uint;
+
+static inline uint get_core_num() { return 0; }
+static inline void tight_loop_contents() {}
+static inline void __wfe() {}
+static inline void __wfi() {}
+static inline void __sev() {}
+static inline void __dmb() {}
+
+#endif
@@ -0,0 +1,11 @@
+// Host stand-in for the pico-sdk header of the same name, see tools/host/include/host_hal.h
+
+#ifndef HOST_PICO_STDLIB_H_
+#define HOST_PICO_STDLIB_H_
+
+#include <stdio.h>
+#include "pico/types.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+#endif
@@ -0,0 +1,29 @@
+// Host stand-in for the pico-sdk header of the same name, see tools/host/include/host_hal.h
+
+#ifndef HOST_PICO_TIME_H_
+#define HOST_PICO_TIME_H_
+
+#include "pico/types.h"
+#include "hardware/timer.h"
+
+static inline absolute_time_t get_absolute_time() { return time_us_64(); }
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000); }
+static inline absolute_time_t make_timeout_time_us(uint64_t us) { return time_us_64() + us; }
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) { return time_us_64() + ms * 1000ull; }
+static inline absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us) { return t + us; }
+static inline absolute_time_t delayed_by_ms(absolute_time_t t, uint32_t ms) { return t + ms * 1000ull; }
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) { return (int64_t)(to - from); }
+static inline bool time_reached(absolute_time_t t) { return time_us_64() >= t; }
+static inline absolute_time_t nil_time_value() { return 0; }
+#define nil_time nil_time_value()
+static inline bool is_nil_time(absolute_time_t t) { return t == 0; }
+
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+void sleep_until(absolute_time_t t);
+static inline void busy_wait_us(uint64_t us) { sleep_us(us); }
+static inline void busy_wait_us_32(uint32_t us) { sleep_us(us); }
+static inline void busy_wait_ms(uint32_t ms) { sleep_ms(ms); }
+
+#endif
@@ -0,0 +1,11 @@
+// Host stand-in for the pico-sdk header of the same name, see tools/host/include/host_hal.h
+
+#ifndef HOST_PICO_TYPES_H_
+#define HOST_PICO_TYPES_H_
+
+#include <assert.h>
+#include "pico/platform.h"
+
+typedef uint64_t absolute_time_t;
+
+#endif
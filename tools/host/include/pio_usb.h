@@ -0,0 +1,10 @@
+// Host stand-in for the Pico-PIO-USB header of the same name, see tools/host/usbhostmanager.cpp
+
+#ifndef HOST_PIO_USB_H_
+#define HOST_PIO_USB_H_
+
+#include <stdint.h>
+
+typedef struct usb_device_t usb_device_t;
+
+#endif
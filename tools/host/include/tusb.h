@@ -0,0 +1,90 @@
+// Host stand-in for the TinyUSB header of the same name, see tools/host/include/host_hal.h
+//
+// Only the device stack the gamepad drivers talk to, and only as far as the reports they send: a
+// report handed to tud_hid_report or usbd_edpt_xfer is what the host would have read.
+
+#ifndef HOST_TUSB_H_
+#define HOST_TUSB_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "tusb_config.h"
+#include "class/hid/hid.h"
+
+typedef enum {
+    TUSB_DIR_OUT = 0,
+    TUSB_DIR_IN = 1,
+    TUSB_DIR_IN_MASK = 0x80
+} tusb_dir_t;
+
+typedef enum {
+    TUSB_XFER_CONTROL = 0,
+    TUSB_XFER_ISOCHRONOUS,
+    TUSB_XFER_BULK,
+    TUSB_XFER_INTERRUPT
+} tusb_xfer_type_t;
+
+typedef enum {
+    XFER_RESULT_SUCCESS = 0,
+    XFER_RESULT_FAILED,
+    XFER_RESULT_STALLED,
+    XFER_RESULT_TIMEOUT,
+    XFER_RESULT_INVALID
+} xfer_result_t;
+
+typedef struct __attribute__((packed)) {
+    union {
+        struct __attribute__((packed)) {
+            uint8_t recipient : 5;
+            uint8_t type : 2;
+            uint8_t direction : 1;
+        } bmRequestType_bit;
+        uint8_t bmRequestType;
+    };
+    uint8_t bRequest;
+    uint16_t wValue;
+    uint16_t wIndex;
+    uint16_t wLength;
+} tusb_control_request_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint8_t bInterfaceNumber;
+    uint8_t bAlternateSetting;
+    uint8_t bNumEndpoints;
+    uint8_t bInterfaceClass;
+    uint8_t bInterfaceSubClass;
+    uint8_t bInterfaceProtocol;
+    uint8_t iInterface;
+} tusb_desc_interface_t;
+
+// TinyUSB's device class driver interface, which the drivers fill in
+typedef struct {
+#if CFG_TUSB_DEBUG >= 2
+    char const* name;
+#endif
+    void (*init)(void);
+    void (*reset)(uint8_t rhport);
+    uint16_t (*open)(uint8_t rhport, tusb_desc_interface_t const* desc_intf, uint16_t max_len);
+    bool (*control_xfer_cb)(uint8_t rhport, uint8_t stage, tusb_control_request_t const* request);
+    bool (*xfer_cb)(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes);
+    void (*sof)(uint8_t rhport, uint32_t frame_count);
+} usbd_class_driver_t;
+
+bool tud_ready(void);
+bool tud_mounted(void);
+bool tud_suspended(void);
+bool tud_remote_wakeup(void);
+void tud_task(void);
+
+bool tud_hid_ready(void);
+bool tud_hid_report(uint8_t report_id, void const* report, uint16_t len);
+
+void hidd_init(void);
+void hidd_reset(uint8_t rhport);
+uint16_t hidd_open(uint8_t rhport, tusb_desc_interface_t const* desc_intf, uint16_t max_len);
+bool hidd_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const* request);
+bool hidd_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes);
+
+#endif
@@ -0,0 +1,8 @@
+// Host stand-in for the header pioasm generates from lib/NeoPico/src/ws2812.pio, see tools/host/include/host_hal.h
+
+#ifndef HOST_WS2812_PIO_H_
+#define HOST_WS2812_PIO_H_
+
+#include "hardware/pio.h"
+
+#endif
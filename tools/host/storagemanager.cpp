@@ -0,0 +1,30 @@
+/*
+ * The parts of Storage that touch the flash, for the host build: the config is what the tool
+ * sets through the getters, starting from the proto defaults, and saving it goes nowhere.
+ * The profiles and the gamepads are the firmware's own, see src/storageprofiles.cpp.
+ */
+
+#include "storagemanager.h"
+#include "system.h"
+
+void Storage::init() {
+    static const Config defaults = Config_init_default;
+    config = defaults;
+    config.gamepadOptions.profileNumber = 1;
+    systemFlashSize = 0;
+}
+
+void Storage::loadDeferredConfig() {}
+
+bool Storage::save() {
+    return save(false);
+}
+
+bool Storage::save(const bool force) {
+    return true;
+}
+
+void Storage::ResetSettings() {}
+
+// There's nothing to reboot into, a hotkey asking for it is ignored
+void System::reboot(BootMode bootMode) {}
@@ -0,0 +1,64 @@
+/*
+ * The TinyUSB device functions the gamepad drivers call, keeping the last report they send so the
+ * host tools can compare it. See tools/host/include/tusb.h.
+ */
+
+#include "host_hal.h"
+
+#include "tusb.h"
+#include "device/usbd_pvt.h"
+
+#include <string.h>
+
+static bool usbReady = true;
+static uint8_t report[CFG_TUD_ENDPOINT0_SIZE];
+static uint16_t reportLength = 0;
+static uint32_t reportCount = 0;
+
+void HostHal::setUsbReady(bool ready) { usbReady = ready; }
+
+const uint8_t* HostHal::usbReport(uint16_t& length) {
+    length = reportLength;
+    return report;
+}
+
+uint32_t HostHal::usbReportCount() { return reportCount; }
+
+static bool sendReport(const void* data, uint16_t length) {
+    if (!usbReady)
+        return false;
+    reportLength = length < sizeof(report) ? length : sizeof(report);
+    memcpy(report, data, reportLength);
+    reportCount++;
+    return true;
+}
+
+bool tud_ready(void) { return usbReady; }
+bool tud_mounted(void) { return true; }
+bool tud_suspended(void) { return false; }
+bool tud_remote_wakeup(void) { return true; }
+void tud_task(void) {}
+
+bool tud_hid_ready(void) { return usbReady; }
+
+bool tud_hid_report(uint8_t report_id, void const* data, uint16_t len) {
+    // the report ID goes out first, as TinyUSB sends it
+    if (report_id == 0)
+        return sendReport(data, len);
+    uint8_t buffer[CFG_TUD_ENDPOINT0_SIZE];
+    buffer[0] = report_id;
+    const uint16_t length = len < sizeof(buffer) - 1 ? len : sizeof(buffer) - 1;
+    memcpy(buffer + 1, data, length);
+    return sendReport(buffer, length + 1);
+}
+
+void hidd_init(void) {}
+void hidd_reset(uint8_t) {}
+uint16_t hidd_open(uint8_t, tusb_desc_interface_t const*, uint16_t) { return 0; }
+bool hidd_control_xfer_cb(uint8_t, uint8_t, tusb_control_request_t const*) { return false; }
+bool hidd_xfer_cb(uint8_t, uint8_t, xfer_result_t, uint32_t) { return true; }
+
+bool usbd_edpt_claim(uint8_t, uint8_t) { return usbReady; }
+bool usbd_edpt_release(uint8_t, uint8_t) { return true; }
+bool usbd_edpt_busy(uint8_t, uint8_t) { return !usbReady; }
+bool usbd_edpt_xfer(uint8_t, uint8_t, uint8_t* buffer, uint16_t total_bytes) { return sendReport(buffer, total_bytes); }
@@ -0,0 +1,318 @@
+/*
+ * Host-side benchmark of the per-sample input path: the debouncer, the pin decoder, then SOCD
+ * cleaning and the 4-way filter, the way Gamepad::read/debounce/process run them every loop.
+ * Then of the whole core0 loop on the same stream (see tools/host/hostloop.h): the firmware's
+ * Gamepad, add-ons, events and driver, up to the report the driver sends, for the generic HID and
+ * the Switch driver.
+ *
+ * A synthetic GPIO stream presses and releases random buttons and dpad directions, with contact
+ * bounce on some of the edges, and the stream is precomputed so only the pipeline is timed. The
+ * benchmark reports the time per sample for each SOCD mode and per loop for each driver, and the
+ * heap allocations per sample or loop, which must be zero: the pipeline runs in the main loop
+ * where nothing may allocate.
+ *
+ * Build and run with the host build (tools/CMakeLists.txt):
+ *   cmake -S tools -B build-host && cmake --build build-host
+ *   ./build-host/input_bench [--check] [samples]
+ *
+ * --check exits with an error if anything allocated, or if the debouncer's vertical counters
+ * ever disagree with a plain per pin timestamp debouncer, for every mode and every delay the
+ * counters count in milliseconds.
+ */
+
+#include "GamepadDebouncer.h"
+#include "GamepadDecoder.h"
+#include "GamepadState.h"
+#include "SOCDState.h"
+#include "host_hal.h"
+#include "hostloop.h"
+#include "storagemanager.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <vector>
+
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* p = malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// Pins 2-5 are the dpad, 6-17 the buttons, as on a typical stick layout
+static const uint8_t DPAD_PINS[4] = { 2, 3, 4, 5 };
+static const uint8_t DPAD_MASKS[4] = { GAMEPAD_MASK_UP, GAMEPAD_MASK_DOWN, GAMEPAD_MASK_LEFT, GAMEPAD_MASK_RIGHT };
+static const uint8_t BUTTON_FIRST_PIN = 6;
+static const uint8_t BUTTON_COUNT = 12;
+
+struct Sample {
+    Mask_t raw;
+    uint32_t now;   // ms
+};
+
+// One sample every 125us, the way a busy loop would see the pins
+static std::vector<Sample> makeStream(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<Sample> stream;
+    stream.reserve(count);
+
+    Mask_t held = 0;
+    Mask_t bouncing = 0;
+    uint32_t bounceUntil = 0;
+    uint32_t us = 0;
+    for (size_t i = 0; i < count; i++, us += 125) {
+        if (rng() % 400 == 0) {
+            const uint32_t pin = (rng() % 2)
+                ? DPAD_PINS[rng() % 4]
+                : BUTTON_FIRST_PIN + rng() % BUTTON_COUNT;
+            held ^= 1U << pin;
+            if (rng() % 2) {
+                bouncing = 1U << pin;
+                bounceUntil = us + 1000 + rng() % 2000;
+            }
+        }
+        Mask_t raw = held;
+        if (us < bounceUntil && (rng() % 2))
+            raw ^= bouncing;
+        stream.push_back({ raw, us / 1000 });
+    }
+    return stream;
+}
+
+struct Pipeline {
+    GamepadDebouncer debouncer;
+    GamepadDecoder decoder;
+    SOCDState socd;
+    Mask_t debounced = 0;
+
+    Pipeline() {
+        debouncer.configure(5, DEBOUNCE_MODE_LOCKOUT);
+        decoder.clear();
+        for (int i = 0; i < 4; i++)
+            decoder.addDpad(1U << DPAD_PINS[i], DPAD_MASKS[i]);
+        for (int i = 0; i < BUTTON_COUNT; i++)
+            decoder.addButtons(1U << (BUTTON_FIRST_PIN + i), 1U << i);
+    }
+
+    uint32_t run(const Sample& sample, SOCDMode mode, bool fourWay) {
+        debounced = debouncer.update(sample.raw, debounced, sample.now);
+        GamepadDecoderEntry entry = decoder.decode(debounced);
+        uint8_t dpad = entry.dpad & 0x0F;
+        if (fourWay)
+            dpad = socd.filterToFourWay(dpad);
+        dpad = socd.clean(mode, dpad);
+        return entry.buttons | (dpad << 24);
+    }
+};
+
+// The debouncer with a start time per pin, what the vertical counters have to match
+struct ReferenceDebouncer {
+    uint32_t delayMs;
+    DebounceMode mode;
+    Mask_t pending = 0;
+    uint32_t start[32];
+
+    ReferenceDebouncer(uint32_t delayMs, DebounceMode mode) : delayMs(delayMs), mode(mode) {}
+
+    void settle() {
+        if (mode != DEBOUNCE_MODE_LOCKOUT)
+            pending = 0;
+    }
+
+    Mask_t update(Mask_t raw, Mask_t debounced, uint32_t now, uint32_t since, Mask_t bounced, uint32_t bouncedSince) {
+        if (mode == DEBOUNCE_MODE_LOCKOUT) {
+            Mask_t locked = 0;
+            for (uint8_t pin = 0; pin < 32; pin++) {
+                if ((pending & (1U << pin)) && now - start[pin] < delayMs)
+                    locked |= 1U << pin;
+            }
+            pending = locked;
+            const Mask_t edges = (raw ^ debounced) & ~locked;
+            for (uint8_t pin = 0; pin < 32; pin++) {
+                if (edges & (1U << pin))
+                    start[pin] = since;
+            }
+            pending |= edges;
+            return debounced ^ edges;
+        }
+
+        if (mode == DEBOUNCE_MODE_EAGER_PRESS)
+            debounced |= raw;
+        else if (mode == DEBOUNCE_MODE_DEFERRED_PRESS)
+            debounced &= raw;
+
+        const Mask_t changing = raw ^ debounced;
+        Mask_t settled = 0;
+        for (uint8_t pin = 0; pin < 32; pin++) {
+            const Mask_t bit = 1U << pin;
+            if (!(changing & bit)) {
+                pending &= ~bit;
+                continue;
+            }
+            if (bounced & bit)
+                start[pin] = bouncedSince;
+            else if (!(pending & bit))
+                start[pin] = since;
+            pending |= bit;
+            if (now - start[pin] >= delayMs)
+                settled |= bit;
+        }
+        pending &= ~settled;
+        return debounced ^ settled;
+    }
+};
+
+// Random bouncing pins read at random intervals, with edge times up to 3 ms before the read
+static uint32_t checkDebouncer(DebounceMode mode, uint32_t delayMs, uint32_t seed) {
+    std::mt19937 rng(seed);
+    GamepadDebouncer debouncer;
+    debouncer.configure(delayMs, mode);
+    ReferenceDebouncer reference(delayMs, mode);
+
+    Mask_t raw = 0;
+    Mask_t debounced = 0;
+    uint32_t now = rng();
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < 20000; i++) {
+        now += rng() % 4 == 0 ? rng() % (2 * delayMs + 2) : rng() % 2;
+        for (int n = rng() % 3; n > 0; n--)
+            raw ^= 1U << (rng() % 32);
+        const Mask_t bounced = rng() % 4 == 0 ? (Mask_t)rng() & (Mask_t)rng() : 0;
+        const uint32_t since = now - rng() % 4;
+        const uint32_t bouncedSince = since + rng() % (now - since + 1);
+
+        if (raw == debounced) {
+            debouncer.settle();
+            reference.settle();
+            continue;
+        }
+        const Mask_t expected = reference.update(raw, debounced, now, since, bounced, bouncedSince);
+        const Mask_t actual = debouncer.update(raw, debounced, now, since, bounced, bouncedSince);
+        if (expected != actual && mismatches++ < 3)
+            printf("  mode %d, %u ms, update %u: expected %08x, got %08x\n", mode, delayMs, i, expected, actual);
+        debounced = expected;
+    }
+    return mismatches;
+}
+
+// The turbo button is held every other 100 ms of the stream, so that turbo has something to do
+static Mask_t loopPins(const Sample& sample) {
+    return sample.raw | (((sample.now / 100) % 2) << 18);
+}
+
+struct LoopResult {
+    double ns;
+    size_t allocated;
+    uint32_t reports;
+};
+
+static LoopResult runLoop(const std::vector<Sample>& stream, InputMode inputMode) {
+    Storage::getInstance().init();
+    configureHostStick(5);
+    HostHal::setTimeUs(0);
+    HostHal::setGpio(~0U);
+    HostLoop loop;
+    loop.setup(inputMode);
+
+    uint32_t reports = 0;
+    const size_t allocationsBefore = allocations;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < stream.size(); i++) {
+        HostHal::setTimeUs(i * 125);
+        HostHal::setGpio(~loopPins(stream[i]));
+        reports += loop.run();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return {
+        std::chrono::duration<double, std::nano>(end - start).count() / stream.size(),
+        allocations - allocationsBefore,
+        reports,
+    };
+}
+
+struct ModeConfig {
+    const char* name;
+    SOCDMode mode;
+    bool fourWay;
+};
+
+int main(int argc, char** argv) {
+    bool check = false;
+    size_t samples = 1000000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--check") == 0)
+            check = true;
+        else
+            samples = (size_t)atol(argv[i]);
+    }
+
+    static const ModeConfig modes[] = {
+        { "neutral", SOCD_MODE_NEUTRAL, false },
+        { "up priority", SOCD_MODE_UP_PRIORITY, false },
+        { "second input priority", SOCD_MODE_SECOND_INPUT_PRIORITY, false },
+        { "first input priority", SOCD_MODE_FIRST_INPUT_PRIORITY, false },
+        { "bypass", SOCD_MODE_BYPASS, false },
+        { "4-way, second input priority", SOCD_MODE_SECOND_INPUT_PRIORITY, true },
+    };
+
+    const std::vector<Sample> stream = makeStream(samples, 1);
+    bool failed = false;
+    for (const ModeConfig& config : modes) {
+        Pipeline pipeline;
+        uint32_t sink = 0;
+
+        const size_t allocationsBefore = allocations;
+        const auto start = std::chrono::steady_clock::now();
+        for (const Sample& sample : stream)
+            sink += pipeline.run(sample, config.mode, config.fourWay);
+        const auto end = std::chrono::steady_clock::now();
+        const size_t allocated = allocations - allocationsBefore;
+
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count() / stream.size();
+        printf("%-30s %7.2f ns/sample  %.3f allocations/sample  (%08x)\n",
+            config.name, ns, (double)allocated / stream.size(), sink);
+        if (allocated != 0)
+            failed = true;
+    }
+
+    static const struct { const char* name; InputMode mode; } loopModes[] = {
+        { "loop, generic HID", INPUT_MODE_GENERIC },
+        { "loop, Switch", INPUT_MODE_SWITCH },
+    };
+    for (const auto& config : loopModes) {
+        const LoopResult result = runLoop(stream, config.mode);
+        printf("%-30s %7.2f ns/loop    %.3f allocations/loop    (%u reports)\n",
+            config.name, result.ns, (double)result.allocated / stream.size(), result.reports);
+        if (result.allocated != 0)
+            failed = true;
+    }
+
+    if (check && failed) {
+        printf("FAIL: the input path allocated\n");
+        return 1;
+    }
+
+    if (check) {
+        uint32_t mismatches = 0;
+        static const DebounceMode debounceModes[] = { DEBOUNCE_MODE_SYMMETRIC, DEBOUNCE_MODE_EAGER_PRESS,
+            DEBOUNCE_MODE_DEFERRED_PRESS, DEBOUNCE_MODE_LOCKOUT };
+        for (DebounceMode mode : debounceModes) {
+            for (uint32_t delayMs = 1; delayMs <= GAMEPAD_DEBOUNCER_MAX_TICKS; delayMs++)
+                mismatches += checkDebouncer(mode, delayMs, delayMs);
+        }
+        printf("debouncer against per pin start times: %u mismatches\n", mismatches);
+        if (mismatches != 0) {
+            printf("FAIL: the debouncer disagrees\n");
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * Host-side check of the GPIO oversampler's ring indexing and majority vote, against a fake of
+ * the ring the PIO state machine and DMA channels fill on the device.
+ *
+ * FakeSamplerRing writes one sample at a time the way the data channel does, and reports the
+ * write address the way GpioSampler::read sees it, including the moment after the last word of
+ * the ring when the address is one past the end until the control channel restarts the data
+ * channel. Pins bounce at random around their level. At every sample, the vote read through
+ * headOf and majority must match a plain per pin count over the latest samples, for every
+ * number of votes. Then the vote is timed.
+ *
+ * Build and run with the host build (tools/CMakeLists.txt):
+ *   cmake -S tools -B build-host && cmake --build build-host
+ *   ./build-host/sampler_check [samples]
+ */
+
+#include "gpiosampler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+// The ring as the DMA channels fill it
+struct FakeSamplerRing {
+    uint32_t samples[GPIO_SAMPLER_RING_SIZE];
+    uint32_t written = 0;       // samples written, wraps
+    bool restarted = true;      // the data channel was restarted after the last word of the ring
+
+    FakeSamplerRing() {
+        // released until the first samples come in, as GpioSampler::start leaves it
+        for (uint32_t& sample : samples)
+            sample = ~0U;
+    }
+
+    void push(uint32_t sample) {
+        samples[written & (GPIO_SAMPLER_RING_SIZE - 1)] = sample;
+        written++;
+        restarted = (written & (GPIO_SAMPLER_RING_SIZE - 1)) != 0;
+    }
+
+    // The control channel writes the start of the ring back into the data channel
+    void restart() { restarted = true; }
+
+    uintptr_t writeAddress() const {
+        const uint32_t index = written & (GPIO_SAMPLER_RING_SIZE - 1);
+        if (!restarted)
+            return (uintptr_t)&samples[0] + GPIO_SAMPLER_RING_SIZE * sizeof(uint32_t);
+        return (uintptr_t)&samples[index];
+    }
+};
+
+static uint32_t expectedMajority(const FakeSamplerRing& ring, uint8_t votes) {
+    if (votes > GPIO_SAMPLER_MAX_VOTES)
+        votes = GPIO_SAMPLER_MAX_VOTES;
+
+    uint32_t result = 0;
+    for (uint8_t pin = 0; pin < 32; pin++) {
+        uint32_t high = 0;
+        for (uint8_t vote = 1; vote <= votes; vote++)
+            high += (ring.samples[(ring.written - vote) & (GPIO_SAMPLER_RING_SIZE - 1)] >> pin) & 1;
+        if (high * 2 > votes)
+            result |= 1U << pin;
+    }
+    return result;
+}
+
+int main(int argc, char** argv) {
+    const uint32_t samples = argc > 1 ? (uint32_t)atol(argv[1]) : 20000;
+
+    std::mt19937 rng(1);
+    FakeSamplerRing ring;
+    uint32_t levels = ~0U;
+    uint32_t mismatches = 0;
+    uint64_t checks = 0;
+    for (uint32_t i = 0; i < samples; i++) {
+        // a button changes now and then, and pins read wrong at random around the change
+        if (rng() % 200 == 0)
+            levels ^= 1U << (rng() % 32);
+        uint32_t noise = 0;
+        for (int n = rng() % 4; n > 0; n--)
+            noise |= 1U << (rng() % 32);
+        ring.push(levels ^ noise);
+
+        // read both before and after the control channel restarted the data channel
+        for (int restart = 0; restart < 2; restart++) {
+            if (restart)
+                ring.restart();
+            const uint32_t head = GpioSampler::headOf(ring.writeAddress(), (uintptr_t)ring.samples);
+            if (head != (ring.written & (GPIO_SAMPLER_RING_SIZE - 1))) {
+                if (mismatches++ < 5)
+                    printf("  head %u after %u samples\n", head, ring.written);
+                continue;
+            }
+            for (uint8_t votes = 1; votes <= GPIO_SAMPLER_MAX_VOTES + 1; votes++) {
+                checks++;
+                const uint32_t expected = expectedMajority(ring, votes);
+                const uint32_t actual = GpioSampler::majority(ring.samples, head, votes);
+                if (expected != actual && mismatches++ < 5)
+                    printf("  %u votes after %u samples: expected %08x, got %08x\n", votes, ring.written, expected, actual);
+            }
+        }
+    }
+
+    uint32_t sink = 0;
+    const uint32_t reads = 1000000;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < reads; i++)
+        sink += GpioSampler::majority(ring.samples, i, GPIO_SAMPLER_VOTES);
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / reads;
+
+    printf("%llu votes checked, %u mismatches, %.2f ns per %d vote read (%08x)\n",
+        (unsigned long long)checks, mismatches, ns, GPIO_SAMPLER_VOTES, sink);
+    if (mismatches != 0) {
+        printf("FAIL\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,296 @@
+/*
+ * Host-side check of SOCDState against the SOCD cleaning and 4-way filtering it replaced.
+ *
+ * The old code is copied below from before SOCDState: the gamepad's runSOCDCleaner and
+ * filterToFourWayMode, and Dual Directional's SOCDDualClean and filterToFourWayModeDDI. Their
+ * function statics and add-on members are gathered in a struct, so every sequence starts from
+ * a fresh history, and their logic is otherwise unchanged.
+ *
+ * Every sequence of dpad inputs up to the given length is run through the old and the new code,
+ * in every SOCD mode, with and without 4-way mode, for the gamepad and for Dual Directional, and
+ * every output must match. Then both are timed on a long random sequence.
+ *
+ * Build and run with the host build (tools/CMakeLists.txt):
+ *   cmake -S tools -B build-host && cmake --build build-host
+ *   ./build-host/socd_check [length]
+ */
+
+#include "GamepadState.h"
+#include "SOCDState.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <random>
+#include <vector>
+
+using std::list;
+
+// GamepadState.cpp isn't in the host build
+uint8_t getMaskFromDirection(DpadDirection direction) {
+    return dpadMasks[direction - 1];
+}
+
+struct OldCleaner {
+    // updateDpad / updateDpadDDI
+    bool inList[5] = { false, false, false, false, false };
+    list<DpadDirection> dpadList;
+    // runSOCDCleaner / SOCDDualClean
+    DpadDirection lastUD = DIRECTION_NONE;
+    DpadDirection lastLR = DIRECTION_NONE;
+
+    uint8_t updateDpad(uint8_t dpad, DpadDirection direction) {
+        if (dpad & getMaskFromDirection(direction)) {
+            if (!inList[direction]) {
+                dpadList.push_back(direction);
+                inList[direction] = true;
+            }
+        } else {
+            if (inList[direction]) {
+                dpadList.remove(direction);
+                inList[direction] = false;
+            }
+        }
+
+        if (dpadList.empty())
+            return 0;
+        else
+            return getMaskFromDirection(dpadList.back());
+    }
+
+    uint8_t filterToFourWayMode(uint8_t dpad) {
+        updateDpad(dpad, DIRECTION_UP);
+        updateDpad(dpad, DIRECTION_DOWN);
+        updateDpad(dpad, DIRECTION_LEFT);
+        return updateDpad(dpad, DIRECTION_RIGHT);
+    }
+
+    uint8_t runSOCDCleaner(SOCDMode mode, uint8_t dpad) {
+        if (mode == SOCD_MODE_BYPASS)
+            return dpad;
+
+        uint8_t newDpad = 0;
+
+        switch (dpad & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN)) {
+            case (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN):
+                if (mode == SOCD_MODE_UP_PRIORITY) {
+                    newDpad |= GAMEPAD_MASK_UP;
+                    lastUD = DIRECTION_UP;
+                }
+                else if (mode == SOCD_MODE_SECOND_INPUT_PRIORITY && lastUD != DIRECTION_NONE)
+                    newDpad |= (lastUD == DIRECTION_UP) ? GAMEPAD_MASK_DOWN : GAMEPAD_MASK_UP;
+                else if (mode == SOCD_MODE_FIRST_INPUT_PRIORITY && lastUD != DIRECTION_NONE)
+                    newDpad |= (lastUD == DIRECTION_UP) ? GAMEPAD_MASK_UP : GAMEPAD_MASK_DOWN;
+                else
+                    lastUD = DIRECTION_NONE;
+                break;
+            case GAMEPAD_MASK_UP:
+                newDpad |= GAMEPAD_MASK_UP;
+                lastUD = DIRECTION_UP;
+                break;
+            case GAMEPAD_MASK_DOWN:
+                newDpad |= GAMEPAD_MASK_DOWN;
+                lastUD = DIRECTION_DOWN;
+                break;
+            default:
+                lastUD = DIRECTION_NONE;
+                break;
+        }
+
+        switch (dpad & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT)) {
+            case (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT):
+                if (mode == SOCD_MODE_SECOND_INPUT_PRIORITY && lastLR != DIRECTION_NONE)
+                    newDpad |= (lastLR == DIRECTION_LEFT) ? GAMEPAD_MASK_RIGHT : GAMEPAD_MASK_LEFT;
+                else if (mode == SOCD_MODE_FIRST_INPUT_PRIORITY && lastLR != DIRECTION_NONE)
+                    newDpad |= (lastLR == DIRECTION_LEFT) ? GAMEPAD_MASK_LEFT : GAMEPAD_MASK_RIGHT;
+                else
+                    lastLR = DIRECTION_NONE;
+                break;
+            case GAMEPAD_MASK_LEFT:
+                newDpad |= GAMEPAD_MASK_LEFT;
+                lastLR = DIRECTION_LEFT;
+                break;
+            case GAMEPAD_MASK_RIGHT:
+                newDpad |= GAMEPAD_MASK_RIGHT;
+                lastLR = DIRECTION_RIGHT;
+                break;
+            default:
+                lastLR = DIRECTION_NONE;
+                break;
+        }
+
+        return newDpad;
+    }
+
+    uint8_t SOCDDualClean(SOCDMode socdMode, uint8_t dualState) {
+        if (socdMode == SOCD_MODE_BYPASS)
+            return dualState;
+
+        switch (dualState & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN)) {
+            case (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN):
+                if (socdMode == SOCD_MODE_UP_PRIORITY) {
+                    dualState ^= GAMEPAD_MASK_DOWN;
+                    lastUD = DIRECTION_UP;
+                } else if (socdMode == SOCD_MODE_SECOND_INPUT_PRIORITY && lastUD != DIRECTION_NONE) {
+                    dualState ^= (lastUD == DIRECTION_UP) ? GAMEPAD_MASK_UP : GAMEPAD_MASK_DOWN;
+                } else if (socdMode == SOCD_MODE_FIRST_INPUT_PRIORITY && lastUD != DIRECTION_NONE) {
+                    dualState ^= (lastUD == DIRECTION_UP) ? GAMEPAD_MASK_DOWN : GAMEPAD_MASK_UP;
+                } else {
+                    dualState ^= (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN);
+                    lastUD = DIRECTION_NONE;
+                }
+                break;
+            case GAMEPAD_MASK_UP:
+                lastUD = DIRECTION_UP;
+                break;
+            case GAMEPAD_MASK_DOWN:
+                lastUD = DIRECTION_DOWN;
+                break;
+            default:
+                lastUD = DIRECTION_NONE;
+                break;
+        }
+        switch (dualState & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT)) {
+            case (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT):
+                if (socdMode == SOCD_MODE_UP_PRIORITY || socdMode == SOCD_MODE_NEUTRAL) {
+                    dualState ^= (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT);
+                    lastLR = DIRECTION_NONE;
+                } else if (socdMode == SOCD_MODE_SECOND_INPUT_PRIORITY || socdMode == SOCD_MODE_FIRST_INPUT_PRIORITY) {
+                    if (lastLR != DIRECTION_NONE)
+                        if (socdMode == SOCD_MODE_SECOND_INPUT_PRIORITY) dualState ^= (lastLR == DIRECTION_LEFT) ? GAMEPAD_MASK_LEFT : GAMEPAD_MASK_RIGHT;
+                        else dualState ^= (lastLR == DIRECTION_LEFT) ? GAMEPAD_MASK_RIGHT : GAMEPAD_MASK_LEFT;
+                    else
+                        lastLR = DIRECTION_NONE;
+                }
+                break;
+            case GAMEPAD_MASK_LEFT:
+                lastLR = DIRECTION_LEFT;
+                break;
+            case GAMEPAD_MASK_RIGHT:
+                lastLR = DIRECTION_RIGHT;
+                break;
+            default:
+                lastLR = DIRECTION_NONE;
+                break;
+        }
+        return dualState;
+    }
+};
+
+struct Config {
+    SOCDMode mode;
+    bool fourWay;
+    bool dual;
+};
+
+static uint8_t runOld(OldCleaner& old, const Config& config, uint8_t dpad) {
+    if (config.fourWay)
+        dpad = old.filterToFourWayMode(dpad);
+    return config.dual ? old.SOCDDualClean(config.mode, dpad) : old.runSOCDCleaner(config.mode, dpad);
+}
+
+static uint8_t runNew(SOCDState& state, const Config& config, uint8_t dpad) {
+    if (config.fourWay)
+        dpad = state.filterToFourWay(dpad);
+    return config.dual ? state.cleanDual(config.mode, dpad) : state.clean(config.mode, dpad);
+}
+
+struct Checker {
+    const Config& config;
+    uint32_t length;
+    uint8_t inputs[16];
+    uint64_t steps = 0;
+    uint64_t mismatches = 0;
+
+    // Depth first over every sequence, each prefix run once
+    void walk(uint32_t depth, const OldCleaner& old, const SOCDState& state) {
+        if (depth == length)
+            return;
+        for (uint8_t dpad = 0; dpad < 16; dpad++) {
+            OldCleaner nextOld = old;
+            SOCDState nextState = state;
+            const uint8_t expected = runOld(nextOld, config, dpad);
+            const uint8_t actual = runNew(nextState, config, dpad);
+            inputs[depth] = dpad;
+            steps++;
+            if (expected != actual) {
+                if (mismatches++ < 5) {
+                    printf("  mismatch: expected %x, got %x after", expected, actual);
+                    for (uint32_t i = 0; i <= depth; i++)
+                        printf(" %x", inputs[i]);
+                    printf("\n");
+                }
+                continue;
+            }
+            walk(depth + 1, nextOld, nextState);
+        }
+    }
+};
+
+static const char* modeName(SOCDMode mode) {
+    switch (mode) {
+        case SOCD_MODE_UP_PRIORITY: return "up priority";
+        case SOCD_MODE_NEUTRAL: return "neutral";
+        case SOCD_MODE_SECOND_INPUT_PRIORITY: return "last win";
+        case SOCD_MODE_FIRST_INPUT_PRIORITY: return "first win";
+        case SOCD_MODE_BYPASS: return "bypass";
+        default: return "?";
+    }
+}
+
+int main(int argc, char** argv) {
+    uint32_t length = argc > 1 ? (uint32_t)atoi(argv[1]) : 5;
+    if (length < 1 || length > 16)
+        length = 5;
+
+    static const SOCDMode modes[] = {
+        SOCD_MODE_UP_PRIORITY, SOCD_MODE_NEUTRAL, SOCD_MODE_SECOND_INPUT_PRIORITY,
+        SOCD_MODE_FIRST_INPUT_PRIORITY, SOCD_MODE_BYPASS,
+    };
+
+    std::mt19937 rng(1);
+    std::vector<uint8_t> stream(1000000);
+    for (uint8_t& dpad : stream)
+        dpad = rng() % 16;
+
+    uint64_t mismatches = 0;
+    printf("%-13s %-9s %-6s %10s %10s %10s %10s\n", "mode", "", "", "steps", "mismatch", "old ns", "new ns");
+    for (bool dual : { false, true }) {
+        for (bool fourWay : { false, true }) {
+            for (SOCDMode mode : modes) {
+                const Config config = { mode, fourWay, dual };
+                Checker checker = { config, length };
+                checker.walk(0, OldCleaner(), SOCDState());
+                mismatches += checker.mismatches;
+
+                OldCleaner old;
+                uint32_t sink = 0;
+                auto start = std::chrono::steady_clock::now();
+                for (uint8_t dpad : stream)
+                    sink += runOld(old, config, dpad);
+                const double oldNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / stream.size();
+
+                SOCDState state;
+                start = std::chrono::steady_clock::now();
+                for (uint8_t dpad : stream)
+                    sink -= runNew(state, config, dpad);
+                const double newNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / stream.size();
+
+                printf("%-13s %-9s %-6s %10llu %10llu %10.2f %10.2f%s\n", modeName(mode),
+                    dual ? "dual" : "gamepad", fourWay ? "4-way" : "",
+                    (unsigned long long)checker.steps, (unsigned long long)checker.mismatches, oldNs, newNs,
+                    sink == 0 ? "" : " (stream mismatch)");
+                if (sink != 0)
+                    mismatches++;
+            }
+        }
+    }
+
+    if (mismatches != 0) {
+        printf("FAIL: %llu mismatches\n", (unsigned long long)mismatches);
+        return 1;
+    }
+    printf("every sequence of up to %u inputs matches\n", length);
+    return 0;
+}
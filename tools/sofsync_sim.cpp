@@ -0,0 +1,251 @@
+/*
+ * Host-side simulation of the USB SOF synchronized input sampling (SOFSync).
+ *
+ * A fake device controller drives the real scheduler: the host sends a SOF every frame and
+ * polls the interrupt IN endpoint every few frames, a little after the SOF. The core0 loop is
+ * modelled as a few phases with random durations, and the driver arms a report whenever the
+ * endpoint is free, as if the inputs kept changing. At every poll the simulation records the
+ * age of the inputs the host holds, i.e. the time since they were sampled, for the free
+ * running loop and for the synchronized one.
+ *
+ * As on the device, the SOF interrupt latches the frame a report was taken in, and the driver
+ * only hears of it when tud_task() next runs. One loop holds the completions back by up to a
+ * few frames. The synchronized loop has to learn the host's poll interval in every case.
+ *
+ * Build and run with the host build (tools/CMakeLists.txt), or on its own from the repository root:
+ *   g++ -std=c++17 -O2 -Iheaders -o sofsync_sim tools/sofsync_sim.cpp src/sofsync.cpp
+ *   ./sofsync_sim [seconds]
+ */
+
+#include "sofsync.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+struct HostConfig {
+    const char* name;
+    uint32_t pollInterval;      // frames
+    uint32_t pollOffsetUs;      // IN token after the SOF
+    double clockPpm;            // host frame clock against ours
+};
+
+struct LoopConfig {
+    const char* name;
+    uint32_t eventsUs;          // before sampling
+    uint32_t workMinUs;         // debounce, read, add-ons and processing up to the driver
+    uint32_t workMaxUs;
+    uint32_t restMinUs;         // tud_task, postprocess add-ons
+    uint32_t restMaxUs;
+    uint32_t spikeUs;           // the odd slow loop, 1 in spikeEvery
+    uint32_t spikeEvery;
+    uint32_t callbackDelayMaxUs; // completions reach tud_task() up to this long after the poll
+};
+
+static const uint32_t TUD_TASK_US = 3;
+static const uint32_t SOF_ISR_MAX_LATENCY_US = 4;
+static const uint32_t TASK_GUARD_US = 100;  // as SOF_SYNC_TASK_GUARD_US in gp2040.cpp
+
+struct Result {
+    std::vector<uint32_t> ages;
+    uint32_t polls = 0;
+    uint32_t naks = 0;          // polls with no new report armed
+    uint32_t loops = 0;
+    uint8_t pollInterval = 0;   // learnt by the scheduler
+};
+
+class FakeDCD {
+public:
+    FakeDCD(const HostConfig& host, const LoopConfig& loop, SOFSync* sync, std::mt19937& rng, Result& result)
+        : host(host), loop(loop), sync(sync), rng(rng), result(result) {}
+
+    // Run the host side up to the given device time
+    void advance(uint64_t untilUs) {
+        while (true) {
+            uint64_t sofUs = frameStartUs(frame);
+            uint64_t pollUs = sofUs + host.pollOffsetUs;
+            bool polled = (frame % host.pollInterval) == 0;
+
+            if (!sofDone) {
+                if (sofUs + sofLatencyUs > untilUs)
+                    break;
+                sofDone = true;
+                if (sync)
+                    sync->onStartOfFrame((uint32_t)(sofUs + sofLatencyUs), takenInFrame);
+                takenInFrame = false;
+                sofLatencyUs = rng() % (SOF_ISR_MAX_LATENCY_US + 1);
+            }
+            if (polled && !pollDone) {
+                if (pollUs > untilUs)
+                    break;
+                pollDone = true;
+                poll(pollUs);
+            }
+            if (frameStartUs(frame + 1) > untilUs)
+                break;
+            frame++;
+            sofDone = false;
+            pollDone = false;
+        }
+        nowUs = untilUs;
+    }
+
+    void spend(uint32_t us) { advance(nowUs + us); }
+
+    // Completed transfers reach the class driver through tud_task()
+    void tudTask() {
+        spend(TUD_TASK_US);
+        if (completed && nowUs >= completedUs) {
+            completed = false;
+            busy = false;
+            uint32_t frame;
+            if (sync && sync->readTakenFrame(frame))
+                sync->onReportTaken(frame);
+        }
+    }
+
+    bool sendReport(uint64_t sampleUs) {
+        if (busy)
+            return false;
+        busy = true;
+        armed = true;
+        armedSampleUs = sampleUs;
+        return true;
+    }
+
+    uint64_t now() const { return nowUs; }
+private:
+    uint64_t frameStartUs(uint64_t n) const {
+        return (uint64_t)(n * SOF_SYNC_FRAME_US * (1.0 + host.clockPpm / 1e6));
+    }
+
+    void poll(uint64_t pollUs) {
+        result.polls++;
+        if (armed) {
+            armed = false;
+            completed = true;
+            completedUs = pollUs + (loop.callbackDelayMaxUs ? rng() % (loop.callbackDelayMaxUs + 1) : 0);
+            takenInFrame = true;
+            hostSampleUs = armedSampleUs;
+            hostHasReport = true;
+        } else {
+            result.naks++;
+        }
+        if (hostHasReport)
+            result.ages.push_back((uint32_t)(pollUs - hostSampleUs));
+    }
+
+    const HostConfig& host;
+    const LoopConfig& loop;
+    SOFSync* sync;
+    std::mt19937& rng;
+    Result& result;
+
+    uint64_t nowUs = 0;
+    uint64_t frame = 1;
+    uint32_t sofLatencyUs = 0;
+    bool sofDone = false;
+    bool pollDone = false;
+
+    bool busy = false;
+    bool armed = false;
+    bool completed = false;
+    uint64_t completedUs = 0;
+    bool takenInFrame = false;
+    uint64_t armedSampleUs = 0;
+    uint64_t hostSampleUs = 0;
+    bool hostHasReport = false;
+};
+
+static uint32_t randomBetween(std::mt19937& rng, uint32_t min, uint32_t max) {
+    return min + rng() % (max - min + 1);
+}
+
+static Result simulate(const HostConfig& host, const LoopConfig& loop, bool synchronized, uint32_t seconds) {
+    std::mt19937 rng(2040);
+    Result result;
+    SOFSync sync;
+    sync.setup(synchronized, DEFAULT_USB_SOF_SYNC_MARGIN_US);
+    FakeDCD dcd(host, loop, synchronized ? &sync : nullptr, rng, result);
+
+    const uint64_t endUs = (uint64_t)seconds * 1000000;
+    while (dcd.now() < endUs) {
+        result.loops++;
+        dcd.spend(loop.eventsUs);
+
+        // GP2040::waitForSampleTime()
+        uint32_t sampleUs = sync.nextSampleTime((uint32_t)dcd.now());
+        int32_t remainingUs;
+        while ((remainingUs = (int32_t)(sampleUs - (uint32_t)dcd.now())) > 0) {
+            if (remainingUs > (int32_t)TASK_GUARD_US)
+                dcd.tudTask();
+            else
+                dcd.spend(1);
+        }
+
+        uint64_t sampledUs = dcd.now();
+        uint32_t workUs = randomBetween(rng, loop.workMinUs, loop.workMaxUs);
+        if (loop.spikeEvery != 0 && rng() % loop.spikeEvery == 0)
+            workUs += loop.spikeUs;
+        dcd.spend(workUs);
+
+        bool processed = dcd.sendReport(sampledUs);
+        sync.onCycleDone((uint32_t)sampledUs, (uint32_t)dcd.now(), processed);
+
+        dcd.tudTask();
+        dcd.spend(randomBetween(rng, loop.restMinUs, loop.restMaxUs));
+    }
+    result.pollInterval = sync.getPollInterval();
+    return result;
+}
+
+static void printResult(const char* mode, Result& result) {
+    std::vector<uint32_t>& ages = result.ages;
+    std::sort(ages.begin(), ages.end());
+    uint64_t sum = 0;
+    for (uint32_t age : ages)
+        sum += age;
+    size_t n = ages.size();
+    printf("    %-12s loops %7u  polls %6u  naks %6u  age avg %5llu  p50 %5u  p99 %5u  max %5u (us)\n",
+        mode, result.loops, result.polls, result.naks, n ? (unsigned long long)(sum / n) : 0ULL,
+        n ? ages[n / 2] : 0, n ? ages[n - n / 100 - 1] : 0, n ? ages[n - 1] : 0);
+}
+
+int main(int argc, char** argv) {
+    uint32_t seconds = argc > 1 ? (uint32_t)atoi(argv[1]) : 20;
+
+    static const HostConfig hosts[] = {
+        { "1ms polls", 1, 15, 0 },
+        { "1ms polls, +400ppm", 1, 40, 400 },
+        { "4ms polls", 4, 15, -150 },
+        { "8ms polls", 8, 25, 0 },
+    };
+    static const LoopConfig loops[] = {
+        { "light loop", 20, 60, 120, 20, 60, 0, 0, 0 },
+        { "busy loop", 40, 200, 350, 150, 400, 600, 200, 0 },
+        { "late tud_task", 20, 60, 120, 20, 60, 0, 0, 3000 },
+    };
+
+    uint32_t failures = 0;
+    for (const LoopConfig& loop : loops) {
+        for (const HostConfig& host : hosts) {
+            printf("%s, %s\n", loop.name, host.name);
+            Result freeRun = simulate(host, loop, false, seconds);
+            printResult("free run", freeRun);
+            Result synced = simulate(host, loop, true, seconds);
+            printResult("synchronized", synced);
+            if (synced.pollInterval != host.pollInterval) {
+                printf("    learnt a poll interval of %u frames instead of %u\n", synced.pollInterval, host.pollInterval);
+                failures++;
+            }
+        }
+    }
+
+    if (failures != 0) {
+        printf("FAIL: %u poll intervals not learnt\n", failures);
+        return 1;
+    }
+    return 0;
+}
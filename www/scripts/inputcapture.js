@@ -0,0 +1,174 @@
+import { readFileSync, writeFileSync } from 'fs';
+import { parseArgs } from 'node:util';
+
+const TYPE_GPIO = 1;
+const TYPE_ADC = 2;
+const TYPE_REPORT = 3;
+const TYPE_REPORT_DATA = 4;
+
+const ADC_HE_TRIGGER = 0x80;
+
+const REPORT_WHOLE = 0x01;
+const REPORT_MAX = 64;
+const REPORT_PART = 8;
+
+function printUsage() {
+	console.log(
+		'usage:      npm run input-capture -- [option]\n' +
+			'on Windows: node ./scripts/inputcapture.js [option]\n' +
+			'Reads the inputs recorded in gamepad mode by a GP2040_INPUT_CAPTURE build. Reboot\n' +
+			'into web config mode after using the controller, the capture is kept across the reboot.\n' +
+			'options:\n' +
+			'  -u|--url <url>     Web config address (default: http://192.168.7.1)\n' +
+			'  -f|--file <path>   Read a saved /api/getInputCapture response instead\n' +
+			'  -o|--output <path> Write the decoded inputs as JSON, for replaying them\n' +
+			'  -r|--raw           Print every input\n' +
+			'Example: npm run input-capture -- -f capture.json -o inputs.json',
+	);
+}
+
+function adcSource(info) {
+	return info & ADC_HE_TRIGGER ? `he${info & ~ADC_HE_TRIGGER}` : `adc${info}`;
+}
+
+function finishReport(report) {
+	report.bytes = [...report.source.subarray(0, Math.min(report.length, REPORT_MAX))];
+	delete report.source;
+}
+
+function decode(capture) {
+	if (capture.version !== 2) {
+		throw new Error(`Unsupported capture version ${capture.version}`);
+	}
+
+	const data = Buffer.from(capture.data, 'base64');
+	const inputs = [];
+	// last report of each device and instance, the next one only records the parts that changed
+	const sources = new Map();
+	let gaps = 0;
+	let skipped = 0;
+	let lastSequence;
+	let report;
+	for (let offset = 0; offset + capture.recordSize <= data.length; offset += capture.recordSize) {
+		const timeUs = data.readUInt32LE(offset);
+		const sequence = data.readUInt16LE(offset + 4);
+		const type = data.readUInt8(offset + 6);
+		const info = data.readUInt8(offset + 7);
+		const payload = data.subarray(offset + 8, offset + capture.recordSize);
+
+		if (lastSequence !== undefined && ((lastSequence + 1) & 0xffff) !== sequence) gaps++;
+		lastSequence = sequence;
+
+		if (report && type !== TYPE_REPORT_DATA) {
+			finishReport(report);
+			report = undefined;
+		}
+
+		switch (type) {
+			case TYPE_GPIO:
+				inputs.push({ timeUs, type: 'gpio', value: payload.readUInt32LE(0) });
+				break;
+			case TYPE_ADC:
+				inputs.push({ timeUs, type: 'adc', source: adcSource(info), value: payload.readUInt16LE(0) });
+				break;
+			case TYPE_REPORT: {
+				const key = `${info}:${payload.readUInt8(0)}`;
+				const length = payload.readUInt16LE(1);
+				if (payload.readUInt8(4) & REPORT_WHOLE) {
+					sources.set(key, Buffer.alloc(REPORT_MAX));
+				}
+				const bytes = sources.get(key);
+				// builds on a report the ring wrapped over, wait for the next whole one
+				if (!bytes) {
+					skipped++;
+					report = undefined;
+					break;
+				}
+				report = {
+					timeUs,
+					type: 'report',
+					devAddr: info,
+					instance: payload.readUInt8(0),
+					length,
+					source: bytes,
+				};
+				inputs.push(report);
+				break;
+			}
+			case TYPE_REPORT_DATA:
+				if (report) {
+					payload.copy(report.source, info * REPORT_PART);
+				}
+				break;
+			default:
+				throw new Error(`Unknown record type ${type} at sequence ${sequence}`);
+		}
+	}
+	if (report) finishReport(report);
+	return { inputs, gaps, skipped };
+}
+
+function hex(bytes) {
+	return bytes.map((b) => b.toString(16).padStart(2, '0')).join('');
+}
+
+async function main() {
+	const { values } = parseArgs({
+		options: {
+			url: { type: 'string', short: 'u', default: 'http://192.168.7.1' },
+			file: { type: 'string', short: 'f' },
+			output: { type: 'string', short: 'o' },
+			raw: { type: 'boolean', short: 'r', default: false },
+			help: { type: 'boolean', short: 'h', default: false },
+		},
+	});
+
+	if (values.help) {
+		printUsage();
+		return;
+	}
+
+	const capture = values.file
+		? JSON.parse(readFileSync(values.file, 'utf8'))
+		: await fetch(`${values.url}/api/getInputCapture`).then((res) => res.json());
+	if (capture.enabled === false) {
+		console.log('The firmware was built without GP2040_INPUT_CAPTURE');
+		return;
+	}
+
+	const { inputs, gaps, skipped } = decode(capture);
+	if (inputs.length === 0) {
+		console.log('The capture is empty');
+		return;
+	}
+
+	if (values.raw) {
+		console.log('timeUs,type,source,value');
+		inputs.forEach((input) => {
+			if (input.type === 'gpio') {
+				console.log([input.timeUs, input.type, '', `0x${input.value.toString(16).padStart(8, '0')}`].join(','));
+			} else if (input.type === 'adc') {
+				console.log([input.timeUs, input.type, input.source, input.value].join(','));
+			} else {
+				console.log([input.timeUs, input.type, `${input.devAddr}:${input.instance}`, hex(input.bytes)].join(','));
+			}
+		});
+	}
+
+	if (values.output) {
+		writeFileSync(values.output, JSON.stringify(inputs, null, '\t'));
+	}
+
+	const count = (type) => inputs.filter((input) => input.type === type).length;
+	const durationMs = (inputs[inputs.length - 1].timeUs - inputs[0].timeUs) / 1000;
+	console.log(
+		`${inputs.length} inputs over ${durationMs.toFixed(1)} ms, ${gaps} gaps in sequence: ` +
+			`${count('gpio')} GPIO, ${count('adc')} ADC, ${count('report')} USB host reports ` +
+			`(${skipped} cut by the ring wrapping)`,
+	);
+}
+
+main().catch((error) => {
+	console.error(error.message);
+	process.exit(1);
+});
@@ -0,0 +1,137 @@
+import { readFileSync } from 'fs';
+import { parseArgs } from 'node:util';
+
+const INPUT_MODES = {
+	0: 'XInput',
+	1: 'Switch',
+	2: 'PS3',
+	3: 'Keyboard',
+	4: 'PS4',
+	5: 'Xbox One',
+	6: 'Mega Drive Mini',
+	7: 'NeoGeo Mini',
+	8: 'PC Engine Mini',
+	9: 'Egret II Mini',
+	10: 'Astro City Mini',
+	11: 'PS Classic',
+	12: 'Original Xbox',
+	13: 'PS5',
+	14: 'Generic HID',
+	15: 'Switch Pro',
+	16: 'P5General',
+};
+
+const FLAG_PRESS = 1 << 0;
+const FLAG_COALESCED = 1 << 1;
+
+function printUsage() {
+	console.log(
+		'usage:      npm run latency-trace -- [option]\n' +
+			'on Windows: node ./scripts/latencytrace.js [option]\n' +
+			'Reads the input-to-USB latency trace recorded in gamepad mode. Reboot into\n' +
+			'web config mode after using the controller, the trace is kept across the reboot.\n' +
+			'options:\n' +
+			'  -u|--url <url>    Web config address (default: http://192.168.7.1)\n' +
+			'  -f|--file <path>  Read a saved /api/getLatencyTrace response instead\n' +
+			'  -r|--raw          Print every sample\n' +
+			'Example: npm run latency-trace -- -f trace.json -r',
+	);
+}
+
+function decode(trace) {
+	if (trace.version !== 1) {
+		throw new Error(`Unsupported trace version ${trace.version}`);
+	}
+
+	const data = Buffer.from(trace.data, 'base64');
+	const samples = [];
+	for (let offset = 0; offset + trace.sampleSize <= data.length; offset += trace.sampleSize) {
+		const flags = data.readUInt8(offset + 9);
+		samples.push({
+			edgeUs: data.readUInt32LE(offset),
+			debounceUs: data.readUInt16LE(offset + 4),
+			reportUs: data.readUInt16LE(offset + 6),
+			inputMode: data.readUInt8(offset + 8),
+			press: (flags & FLAG_PRESS) !== 0,
+			coalesced: (flags & FLAG_COALESCED) !== 0,
+			sequence: data.readUInt16LE(offset + 10),
+		});
+	}
+	return samples;
+}
+
+function percentile(sorted, p) {
+	return sorted[Math.min(sorted.length - 1, Math.floor((sorted.length * p) / 100))];
+}
+
+function summarize(label, values) {
+	const sorted = [...values].sort((a, b) => a - b);
+	const avg = sorted.reduce((sum, value) => sum + value, 0) / sorted.length;
+	return (
+		`  ${label.padEnd(10)} n=${String(sorted.length).padEnd(5)}` +
+		` min ${sorted[0]}  avg ${avg.toFixed(0)}  p50 ${percentile(sorted, 50)}` +
+		`  p90 ${percentile(sorted, 90)}  p99 ${percentile(sorted, 99)}  max ${sorted[sorted.length - 1]} (us)`
+	);
+}
+
+async function main() {
+	const { values } = parseArgs({
+		options: {
+			url: { type: 'string', short: 'u', default: 'http://192.168.7.1' },
+			file: { type: 'string', short: 'f' },
+			raw: { type: 'boolean', short: 'r', default: false },
+			help: { type: 'boolean', short: 'h', default: false },
+		},
+	});
+
+	if (values.help) {
+		printUsage();
+		return;
+	}
+
+	const trace = values.file
+		? JSON.parse(readFileSync(values.file, 'utf8'))
+		: await fetch(`${values.url}/api/getLatencyTrace`).then((res) => res.json());
+	const samples = decode(trace);
+	if (samples.length === 0) {
+		console.log('The trace is empty');
+		return;
+	}
+
+	let gaps = 0;
+	for (let i = 1; i < samples.length; i++) {
+		if (((samples[i - 1].sequence + 1) & 0xffff) !== samples[i].sequence) gaps++;
+	}
+
+	if (values.raw) {
+		console.log('sequence,edgeUs,inputMode,press,coalesced,debounceUs,reportUs,totalUs');
+		samples.forEach((s) =>
+			console.log(
+				[s.sequence, s.edgeUs, s.inputMode, s.press ? 1 : 0, s.coalesced ? 1 : 0,
+					s.debounceUs, s.reportUs, s.debounceUs + s.reportUs].join(','),
+			),
+		);
+	}
+
+	const byMode = {};
+	samples.forEach((sample) => {
+		(byMode[sample.inputMode] ||= []).push(sample);
+	});
+
+	console.log(`${samples.length} samples, ${gaps} gaps in sequence`);
+	Object.entries(byMode).forEach(([mode, modeSamples]) => {
+		console.log(`${INPUT_MODES[mode] || `Input mode ${mode}`}:`);
+		console.log(summarize('total', modeSamples.map((s) => s.debounceUs + s.reportUs)));
+		console.log(summarize('debounce', modeSamples.map((s) => s.debounceUs)));
+		console.log(summarize('report', modeSamples.map((s) => s.reportUs)));
+		const presses = modeSamples.filter((s) => s.press);
+		if (presses.length > 0) {
+			console.log(summarize('press', presses.map((s) => s.debounceUs + s.reportUs)));
+		}
+	});
+}
+
+main().catch((error) => {
+	console.error(error.message);
+	process.exit(1);
+});
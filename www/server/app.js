@@ -33,6 +33,14 @@ const createPinMappings = ({ profileLabel = 'Profile', enabled = true }) => {
 
 const port = process.env.PORT || 8080;
 
+// Kept between requests, so the add-on profile shows the budgets as they are set
+const addonProfilerOptions = {
+	addonBudgetUs: 0,
+	addonDemoteOverBudget: 0,
+	addonDemotedInterval: 8,
+	addonBudgets: [{ name: 'Wii', budgetUs: 500 }],
+};
+
 const app = express();
 app.use(cors());
 app.use(express.json());
@@ -116,6 +124,12 @@ app.get('/api/getGamepadOptions', (req, res) => {
 		fnButtonPin: -1,
 		profileNumber: 2,
 		debounceDelay: 5,
+		debounceMode: 3,
+		usbSofSync: 0,
+		usbSofSyncMarginUs: 50,
+		gpioEdgeCapture: 0,
+		gpioOversampling: 0,
+		idleSleep: 0,
 		inputModeB1: 1,
 		inputModeB2: 0,
 		inputModeB3: 2,
@@ -216,6 +230,46 @@ app.get('/api/getGamepadOptions', (req, res) => {
 			buttonsMask: 0,
 			action: 0,
 		},
+		hotkey17: {
+			auxMask: 0,
+			buttonsMask: 0,
+			action: 0,
+		},
+		hotkey18: {
+			auxMask: 0,
+			buttonsMask: 0,
+			action: 0,
+		},
+		hotkey19: {
+			auxMask: 0,
+			buttonsMask: 0,
+			action: 0,
+		},
+		hotkey20: {
+			auxMask: 0,
+			buttonsMask: 0,
+			action: 0,
+		},
+		hotkey21: {
+			auxMask: 0,
+			buttonsMask: 0,
+			action: 0,
+		},
+		hotkey22: {
+			auxMask: 0,
+			buttonsMask: 0,
+			action: 0,
+		},
+		hotkey23: {
+			auxMask: 0,
+			buttonsMask: 0,
+			action: 0,
+		},
+		hotkey24: {
+			auxMask: 0,
+			buttonsMask: 0,
+			action: 0,
+		},
 	});
 });
 
@@ -577,6 +631,7 @@ app.get('/api/getAddonsOptions', (req, res) => {
 		tg16PadDataPin3: -1,
 		TG16padAddonEnabled: 1,
 		HETriggerEnabled: 1,
+		...addonProfilerOptions,
 		usedPins: Object.values(picoController),
 	});
 });
@@ -861,6 +916,150 @@ app.get('/api/getMemoryReport', (req, res) => {
 		staticAllocs: 200,
 		totalHeap: 2048 * 1024,
 		usedHeap: 1048 * 1024,
+		heapOperations: 0,
+		maxLoopHeapOperations: 0,
+		flashSaves: 3,
+		flashSectorsChanged: 1,
+		flashSectorsErased: 0,
+		flashPagesProgrammed: 4,
+		flashStallUs: 1850,
+		maxFlashStallUs: 47200,
+	});
+});
+
+app.post('/api/setAddonsOptions', (req, res) => {
+	console.log(req.body);
+	for (const key of Object.keys(addonProfilerOptions)) {
+		if (req.body[key] !== undefined) addonProfilerOptions[key] = req.body[key];
+	}
+	return res.send(req.body);
+});
+
+app.get('/api/getAddonProfile', (req, res) => {
+	const addon = (name, core, processUs, overruns = 0) => ({
+		name,
+		core,
+		budgetUs:
+			addonProfilerOptions.addonBudgets.find((budget) => budget.name === name)
+				?.budgetUs ?? addonProfilerOptions.addonBudgetUs,
+		overruns,
+		overBudget: overruns > 0,
+		interval: 1,
+		preprocess: { lastUs: 2, avgUs: 2, maxUs: 9 },
+		process: { lastUs: processUs, avgUs: processUs, maxUs: processUs * 3 },
+		postprocess: { lastUs: 0, avgUs: 0, maxUs: 1 },
+	});
+	return res.send({
+		previousBoot: true,
+		addons: [
+			addon('Turbo', 0, 3),
+			addon('Wii', 0, 640, 12),
+			addon('Display', 1, 11000),
+			addon('NeoPicoLED', 1, 1800),
+		],
+	});
+});
+
+app.get('/api/getBootProfile', (req, res) => {
+	return res.send({
+		version: 2,
+		phases: [
+			{ name: 'config loaded', us: 21400, previousUs: 21300 },
+			{ name: 'peripherals', us: 23100, previousUs: 23000 },
+			{ name: 'core0 add-ons', us: 46900, previousUs: 46800 },
+			{ name: 'core0 setup', us: 48200, previousUs: 48100 },
+			{ name: 'usb init', us: 48600, previousUs: 48500 },
+			{ name: 'config complete', us: 52700, previousUs: 52500 },
+			{ name: 'core1 setup', us: 112900, previousUs: 112400 },
+			{ name: 'loop', us: 113000, previousUs: 112500 },
+			{ name: 'usb mounted', us: 338200, previousUs: 341600 },
+		],
+	});
+});
+
+app.get('/api/getLatencyTrace', (req, res) => {
+	const count = 128;
+	const sampleSize = 12;
+	const data = Buffer.alloc(count * sampleSize);
+	for (let i = 0; i < count; i++) {
+		const offset = i * sampleSize;
+		data.writeUInt32LE(1000000 + i * 25000, offset);
+		data.writeUInt16LE(Math.round(Math.random() * 50), offset + 4);
+		data.writeUInt16LE(Math.round(150 + Math.random() * 1000), offset + 6);
+		data.writeUInt8(0, offset + 8);
+		data.writeUInt8(i % 2 ? 0 : 1, offset + 9);
+		data.writeUInt16LE(i, offset + 10);
+	}
+	return res.send({
+		version: 1,
+		sampleSize,
+		count,
+		data: data.toString('base64'),
+	});
+});
+
+app.get('/api/getInputCapture', (req, res) => {
+	const count = 64;
+	const recordSize = 16;
+	const data = Buffer.alloc(count * recordSize);
+	for (let i = 0; i < count; i++) {
+		const offset = i * recordSize;
+		data.writeUInt32LE(1000000 + i * 4000, offset);
+		data.writeUInt16LE(i, offset + 4);
+		if (i % 4 === 0) {
+			data.writeUInt8(1, offset + 6);
+			data.writeUInt32LE(i % 8 ? 1 << 2 : 0, offset + 8);
+		} else {
+			data.writeUInt8(2, offset + 6);
+			data.writeUInt8(i % 2, offset + 7);
+			data.writeUInt16LE(Math.round(2048 + (Math.random() - 0.5) * 400), offset + 8);
+		}
+	}
+	return res.send({
+		enabled: true,
+		version: 2,
+		recordSize,
+		count,
+		data: data.toString('base64'),
+	});
+});
+
+app.get('/api/getLoopStats', (req, res) => {
+	const phase = (name, core, avgNs) => ({
+		name,
+		core,
+		count: 120000,
+		minNs: Math.round(avgNs * 0.8),
+		avgNs,
+		p99Ns: Math.round(avgNs * 1.5),
+		maxNs: avgNs * 4,
+	});
+	return res.send({
+		enabled: true,
+		previousBoot: true,
+		phases: [
+			phase('core0 loop', 0, 33000),
+			phase('events', 0, 900),
+			phase('sof wait', 0, 0),
+			phase('debounce', 0, 400),
+			phase('read', 0, 2100),
+			phase('usb host', 0, 1200),
+			phase('preprocess', 0, 3500),
+			phase('hotkey', 0, 1800),
+			phase('process', 0, 2600),
+			phase('addons', 0, 4200),
+			phase('driver', 0, 5100),
+			phase('tud_task', 0, 9000),
+			phase('postprocess', 0, 700),
+			phase('edge gain', 0, 180000),
+			phase('idle', 0, 210000),
+			phase('wake latency', 0, 2500),
+			phase('core1 loop', 1, 15800),
+			phase('events', 1, 1100),
+			phase('preprocess', 1, 300),
+			phase('addons', 1, 14000),
+			phase('driver aux', 1, 200),
+		],
 	});
 });
 
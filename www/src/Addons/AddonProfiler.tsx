@@ -0,0 +1,150 @@
+import { useTranslation } from 'react-i18next';
+import { Button, FormCheck, Row } from 'react-bootstrap';
+import * as yup from 'yup';
+
+import Section from '../Components/Section';
+import FormControl from '../Components/FormControl';
+import { AddonPropTypes } from '../Pages/AddonsConfigPage';
+
+// AddonProfilerOptions.budgets max_count
+const MAX_ADDON_BUDGETS = 8;
+
+type AddonBudget = { name: string; budgetUs: number };
+
+export const addonProfilerScheme = {
+	addonBudgetUs: yup.number().label('Add-On Budget').min(0),
+	addonDemoteOverBudget: yup.number().label('Demote Over Budget').min(0).max(1),
+	addonDemotedInterval: yup
+		.number()
+		.label('Demoted Interval')
+		.min(1)
+		.max(1000),
+	addonBudgets: yup
+		.array()
+		.of(
+			yup.object().shape({
+				name: yup.string().max(31).required(),
+				budgetUs: yup.number().min(0).required(),
+			}),
+		)
+		.max(MAX_ADDON_BUDGETS),
+};
+
+export const addonProfilerState = {
+	addonBudgetUs: 0,
+	addonDemoteOverBudget: 0,
+	addonDemotedInterval: 8,
+	addonBudgets: [] as AddonBudget[],
+};
+
+const AddonProfiler = ({
+	values,
+	errors,
+	handleChange,
+	handleCheckbox,
+	setFieldValue,
+}: AddonPropTypes) => {
+	const { t } = useTranslation();
+	const budgets: AddonBudget[] = values.addonBudgets || [];
+
+	const setBudget = (index: number, budget: Partial<AddonBudget>) =>
+		setFieldValue(
+			'addonBudgets',
+			budgets.map((b, i) => (i === index ? { ...b, ...budget } : b)),
+		);
+
+	return (
+		<Section title={t('AddonsConfig:addon-profiler-header-text')}>
+			<div className="alert alert-info" role="alert">
+				{t('AddonsConfig:addon-profiler-sub-header-text')}
+			</div>
+			<Row className="mb-3">
+				<FormControl
+					type="number"
+					label={t('AddonsConfig:addon-profiler-budget-label')}
+					name="addonBudgetUs"
+					className="form-control-sm"
+					groupClassName="col-sm-3 mb-3"
+					value={values.addonBudgetUs}
+					error={errors.addonBudgetUs}
+					isInvalid={Boolean(errors.addonBudgetUs)}
+					onChange={handleChange}
+					min={0}
+				/>
+				<FormControl
+					type="number"
+					label={t('AddonsConfig:addon-profiler-demoted-interval-label')}
+					name="addonDemotedInterval"
+					className="form-control-sm"
+					groupClassName="col-sm-3 mb-3"
+					value={values.addonDemotedInterval}
+					error={errors.addonDemotedInterval}
+					isInvalid={Boolean(errors.addonDemotedInterval)}
+					onChange={handleChange}
+					min={1}
+					max={1000}
+				/>
+				<FormCheck
+					label={t('AddonsConfig:addon-profiler-demote-label')}
+					className="col-sm-3 ms-3 mt-4"
+					type="switch"
+					id="addonDemoteOverBudget"
+					isInvalid={false}
+					checked={Boolean(values.addonDemoteOverBudget)}
+					onChange={() => handleCheckbox('addonDemoteOverBudget')}
+				/>
+			</Row>
+			{budgets.map((budget, index) => (
+				<Row className="mb-2" key={`addonBudget-${index}`}>
+					<FormControl
+						type="text"
+						label={t('AddonsConfig:addon-profiler-addon-name-label')}
+						name={`addonBudgets.${index}.name`}
+						className="form-control-sm"
+						groupClassName="col-sm-3 mb-2"
+						value={budget.name}
+						maxLength={31}
+						onChange={(e) => setBudget(index, { name: e.target.value })}
+					/>
+					<FormControl
+						type="number"
+						label={t('AddonsConfig:addon-profiler-addon-budget-label')}
+						name={`addonBudgets.${index}.budgetUs`}
+						className="form-control-sm"
+						groupClassName="col-sm-3 mb-2"
+						value={budget.budgetUs}
+						min={0}
+						onChange={(e) =>
+							setBudget(index, { budgetUs: Number(e.target.value) })
+						}
+					/>
+					<div className="col-sm-2 mb-2 d-flex align-items-end">
+						<Button
+							size="sm"
+							variant="danger"
+							onClick={() =>
+								setFieldValue(
+									'addonBudgets',
+									budgets.filter((_, i) => i !== index),
+								)
+							}
+						>
+							{t('AddonsConfig:addon-profiler-remove-label')}
+						</Button>
+					</div>
+				</Row>
+			))}
+			<Button
+				size="sm"
+				disabled={budgets.length >= MAX_ADDON_BUDGETS}
+				onClick={() =>
+					setFieldValue('addonBudgets', [...budgets, { name: '', budgetUs: 0 }])
+				}
+			>
+				{t('AddonsConfig:addon-profiler-add-label')}
+			</Button>
+		</Section>
+	);
+};
+
+export default AddonProfiler;
@@ -217,4 +217,14 @@ export default {
 	'tg16-extension-data-pin2-label': 'Data GPIO Pin 2 (D_SELECT)',
 	'tg16-extension-data-pin3-label': 'Data GPIO Pin 3 (L_RUN)',
 	'tg16-extension-desc-header': 'PC Engine/TurboGrafx-16 Extension Mapping',
+	'addon-profiler-header-text': 'Add-On Time Budgets',
+	'addon-profiler-sub-header-text':
+		'An add-on that takes longer than its budget per loop for several loops in a row is reported on the display and on the home page. The budget below applies to every add-on, 0 for none, and can be set per add-on by the name shown on the home page. Add-ons that feed inputs keep reading them every loop when run less often.',
+	'addon-profiler-budget-label': 'Budget per Add-On (us)',
+	'addon-profiler-demote-label': 'Run Add-Ons Over Budget Less Often',
+	'addon-profiler-demoted-interval-label': 'Loops per Call When Over Budget',
+	'addon-profiler-addon-name-label': 'Add-On Name',
+	'addon-profiler-addon-budget-label': 'Budget (us)',
+	'addon-profiler-add-label': 'Add Add-On Budget',
+	'addon-profiler-remove-label': 'Remove',
 };
@@ -1,4 +1,15 @@
 export default {
+	'addon-profile-budget-text': 'Budget (us)',
+	'addon-profile-core-text': 'Core',
+	'addon-profile-demoted-text': 'every {{interval}} loops',
+	'addon-profile-header-text': 'Add-on Timing (avg / max us)',
+	'addon-profile-name-text': 'Add-on',
+	'addon-profile-overruns-text': 'Over Budget',
+	'addon-profile-postprocess-text': 'Postprocess',
+	'addon-profile-previous-boot-text':
+		'Measured while playing before rebooting into the web configurator.',
+	'addon-profile-preprocess-text': 'Preprocess',
+	'addon-profile-process-text': 'Process',
 	'architecture-text': 'Architecture: {{architecture}}',
 	'build-type-text': 'Build Type: {{build}}',
 	'build-text': 'Build: {{build}}',
@@ -59,6 +59,26 @@ export default {
 	},
 	'profile-label': 'Profile',
 	'debounce-delay-label': 'Debounce Delay in milliseconds',
+	'debounce-mode-label': 'Debounce Mode',
+	'debounce-mode-options': {
+		lockout: 'Instant Press and Release, Then Ignore',
+		symmetric: 'Delay Press and Release',
+		'eager-press': 'Instant Press, Delay Release',
+		'deferred-press': 'Delay Press, Instant Release',
+	},
+	'gpio-edge-capture-label': 'Timestamp Button Edges',
+	'gpio-edge-capture-explanation-text':
+		'Button pins raise an interrupt when they change, so the debounce delay is measured from the actual press or release instead of from when the pins were next read.',
+	'gpio-oversampling-label': 'Oversample Buttons',
+	'gpio-oversampling-explanation-text':
+		'Samples the button pins in the background at 1 MHz and reads each button as the majority of its latest samples, so the buttons are read the same way however long the rest of the loop takes. If another feature already uses the PIO state machines or DMA channels it needs, the display shows an error and the buttons are read with timestamped edges instead.',
+	'idle-sleep-label': 'Sleep While Idle',
+	'idle-sleep-explanation-text':
+		'When the inputs stop changing, waits for the next USB poll or a button press asleep instead of running flat out. Uses less power and runs cooler, button presses wake it up immediately. Not used with USB host add-ons.',
+	'usb-sof-sync-label': 'Synchronize Input Sampling to USB Polls',
+	'usb-sof-sync-explanation-text':
+		'Reads the inputs just before the host asks for them, instead of as often as possible. The report the host receives is fresher, at the cost of reading the inputs less often.',
+	'usb-sof-sync-margin-label': 'USB Poll Margin in microseconds',
 	'mini-menu-gamepad-input': 'Use Gamepad Input for Display Mini Menu',
 	'ps4-mode-explanation-text':
 		'PS4 mode allows GP2040-CE to run as an authenticated PS4 controller.',
@@ -90,6 +110,9 @@ export default {
 		'The <strong>Fn</strong> slider provides a mappable Function button in the <link_pinmap>Pin Mapping</link_pinmap> page. By selecting the <strong>Fn</strong> slider option, the Function button must be held along with the selected hotkey settings. <br /> Additionally, select <strong>None</strong> from the dropdown to unassign any button.',
 	'hotkey-settings-warning':
 		'Function button is not mapped. The Fn slider will be disabled.',
+	'hotkey-chord-first-step-label':
+		'Optional first step: press this button, then the combination on the right',
+	'hotkey-chord-then': 'then',
 	'hotkey-actions': {
 		'no-action': 'No Action',
 		'dpad-digital': 'Dpad Digital',
@@ -61,6 +61,10 @@ import HETrigger, {
 	HETriggerScheme,
 	HETriggerState,
 } from '../Addons/HETrigger';
+import AddonProfiler, {
+	addonProfilerScheme,
+	addonProfilerState,
+} from '../Addons/AddonProfiler';
 
 export type AddonPropTypes = {
 	values: typeof DEFAULT_VALUES;
@@ -91,6 +95,7 @@ const schema = yup.object().shape({
 	...reactiveLEDScheme,
 	...gamepadUSBHostScheme,
 	...HETriggerScheme,
+	...addonProfilerScheme,
 });
 
 export const DEFAULT_VALUES = {
@@ -116,6 +121,7 @@ export const DEFAULT_VALUES = {
 	...reactiveLEDState,
 	...gamepadUSBHostState,
 	...HETriggerState,
+	...addonProfilerState,
 } as const;
 
 const ADDONS = [
@@ -141,6 +147,7 @@ const ADDONS = [
 	DRV8833Rumble,
 	ReactiveLED,
 	HETrigger,
+	AddonProfiler,
 ];
 
 const FormContext = ({ setStoredData }) => {
@@ -222,6 +229,10 @@ export default function AddonsConfigPage() {
 				set(resultObject, key, newVal);
 			}
 		});
+		// the budgets list is replaced as a whole, not field by field
+		if (JSON.stringify(values.addonBudgets) !== JSON.stringify(get(storedData, 'addonBudgets'))) {
+			set(resultObject, 'addonBudgets', valuesSchema.addonBudgets);
+		}
 		sanitizeData(resultObject);
 		const success = await WebApi.setAddonsOptions(resultObject);
 		setStoredData(JSON.parse(JSON.stringify(values))); // Update to reflect saved data
@@ -1,8 +1,9 @@
 import { useEffect } from 'react';
 import { useTranslation } from 'react-i18next';
-import { ProgressBar } from 'react-bootstrap';
+import { ProgressBar, Table } from 'react-bootstrap';
 
 import useSystemStats from '../Store/useSystemStats';
+import useAddonProfileStore from '../Store/useAddonProfileStore';
 import Section from '../Components/Section';
 
 export default function HomePage() {
@@ -17,9 +18,11 @@ export default function HomePage() {
 		getSystemStats,
 		loading,
 	} = useSystemStats();
+	const { addons, previousBoot, fetchAddonProfile } = useAddonProfileStore();
 
 	useEffect(() => {
 		getSystemStats();
+		fetchAddonProfile();
 	}, []);
 
 	if (loading) {
@@ -104,6 +107,46 @@ export default function HomePage() {
 					/>
 				</div>
 			</Section>
+			{addons.length > 0 && (
+				<Section title={t('HomePage:addon-profile-header-text')}>
+					{previousBoot && <p>{t('HomePage:addon-profile-previous-boot-text')}</p>}
+					<Table responsive bordered hover variant="dark" size="sm">
+						<thead>
+							<tr>
+								<th>{t('HomePage:addon-profile-name-text')}</th>
+								<th>{t('HomePage:addon-profile-core-text')}</th>
+								<th>{t('HomePage:addon-profile-preprocess-text')}</th>
+								<th>{t('HomePage:addon-profile-process-text')}</th>
+								<th>{t('HomePage:addon-profile-postprocess-text')}</th>
+								<th>{t('HomePage:addon-profile-budget-text')}</th>
+								<th>{t('HomePage:addon-profile-overruns-text')}</th>
+							</tr>
+						</thead>
+						<tbody>
+							{addons.map((addon) => (
+								<tr
+									key={`${addon.core}-${addon.name}`}
+									className={addon.overBudget ? 'table-danger' : ''}
+								>
+									<td>{addon.name}</td>
+									<td>{addon.core}</td>
+									<td>{`${addon.preprocess.avgUs} / ${addon.preprocess.maxUs}`}</td>
+									<td>{`${addon.process.avgUs} / ${addon.process.maxUs}`}</td>
+									<td>{`${addon.postprocess.avgUs} / ${addon.postprocess.maxUs}`}</td>
+									<td>{addon.budgetUs || '-'}</td>
+									<td>
+										{addon.overruns}
+										{addon.interval > 1 &&
+											` (${t('HomePage:addon-profile-demoted-text', {
+												interval: addon.interval,
+											})})`}
+									</td>
+								</tr>
+							))}
+						</tbody>
+					</Table>
+				</Section>
+			)}
 		</div>
 	);
 }
@@ -285,6 +285,13 @@ const PS4_ID_MODES = [
 	{ labelKey: 'ps4-id-mode-options.emulation', value: 1 },
 ];
 
+const DEBOUNCE_MODES = [
+	{ labelKey: 'debounce-mode-options.lockout', value: 3 },
+	{ labelKey: 'debounce-mode-options.symmetric', value: 0 },
+	{ labelKey: 'debounce-mode-options.eager-press', value: 1 },
+	{ labelKey: 'debounce-mode-options.deferred-press', value: 2 },
+];
+
 const AUTHENTICATION_TYPES = [
 	{ labelKey: 'input-mode-authentication.none', value: 0 },
 	{ labelKey: 'input-mode-authentication.key', value: 1 },
@@ -387,9 +394,13 @@ const hotkeySchema = {
 		.label('Hotkey Action'),
 	buttonsMask: yup.number().required().label('Button Mask'),
 	auxMask: yup.number().required().label('Function Key'),
+	firstButtonsMask: yup.number().label('Chord Button Mask'),
+	firstAuxMask: yup.number().label('Chord Function Key'),
 };
 
-const hotkeyFields = Array(16)
+const HOTKEY_COUNT = 24;
+
+const hotkeyFields = Array(HOTKEY_COUNT)
 	.fill(0)
 	.reduce((acc, a, i) => {
 		const number = String(i + 1).padStart(2, '0');
@@ -402,7 +413,7 @@ const hotkeyFields = Array(16)
 				'Duplicate button combinations are not allowed',
 				function (currentValue) {
 					return !Object.entries(this.parent).some(
-						([key, { buttonsMask, auxMask }]) => {
+						([key, { buttonsMask, auxMask, firstButtonsMask, firstAuxMask }]) => {
 							if (
 								!key.includes('hotkey') || // Skip non-hotkey rows
 								key === 'hotkey' + number || // Skip current hotkey
@@ -412,7 +423,9 @@ const hotkeyFields = Array(16)
 							}
 							return (
 								buttonsMask === currentValue.buttonsMask &&
-								auxMask === currentValue.auxMask
+								auxMask === currentValue.auxMask &&
+								(firstButtonsMask || 0) === (currentValue.firstButtonsMask || 0) &&
+								(firstAuxMask || 0) === (currentValue.firstAuxMask || 0)
 							);
 						},
 					);
@@ -477,6 +490,21 @@ const schema = yup.object().shape({
 		.oneOf(AUTHENTICATION_TYPES.map((o) => o.value))
 		.label('X-Input Authentication Type'),
 	debounceDelay: yup.number().required().label('Debounce Delay'),
+	debounceMode: yup
+		.number()
+		.required()
+		.oneOf(DEBOUNCE_MODES.map((o) => o.value))
+		.label('Debounce Mode'),
+	gpioEdgeCapture: yup.number().required().label('Button Edge Capture'),
+	gpioOversampling: yup.number().required().label('Button Oversampling'),
+	idleSleep: yup.number().required().label('Idle Sleep'),
+	usbSofSync: yup.number().required().label('USB Poll Synchronized Sampling'),
+	usbSofSyncMarginUs: yup
+		.number()
+		.required()
+		.min(0)
+		.max(500)
+		.label('USB Poll Margin'),
 	miniMenuGamepadInput: yup.number().required().label('Mini Menu'),
 	inputModeB1: yup
 		.number()
@@ -561,6 +589,8 @@ const FormContext = ({ setButtonLabels, setKeyMappings }) => {
 		if (!!values.ps4ControllerIDMode)
 			values.ps4ControllerIDMode = parseInt(values.ps4ControllerIDMode);
 		if (!!values.inputDeviceType) values.inputDeviceType = parseInt(values.inputDeviceType);
+		if (!!values.debounceMode)
+			values.debounceMode = parseInt(values.debounceMode);
 
 		setButtonLabels({
 			swapTpShareLabels:
@@ -574,6 +604,8 @@ const FormContext = ({ setButtonLabels, setKeyMappings }) => {
 					action: parseInt(value.action),
 					buttonsMask: parseInt(value.buttonsMask),
 					auxMask: parseInt(value.auxMask),
+					firstButtonsMask: parseInt(value.firstButtonsMask) || 0,
+					firstAuxMask: parseInt(value.firstAuxMask) || 0,
 				};
 			}
 		});
@@ -1751,6 +1783,129 @@ export default function SettingsPage() {
 															/>
 														</Col>
 													</Form.Group>
+													<Form.Group className="row mb-3">
+														<Form.Label>
+															{t('SettingsPage:debounce-mode-label')}
+														</Form.Label>
+														<Col sm={3}>
+															<Form.Select
+																name="debounceMode"
+																className="form-select-sm"
+																value={values.debounceMode}
+																onChange={handleChange}
+																isInvalid={errors.debounceMode}
+															>
+																{DEBOUNCE_MODES.map((o) => (
+																	<option
+																		key={`debounce-mode-option-${o.value}`}
+																		value={o.value}
+																	>
+																		{t('SettingsPage:' + o.labelKey)}
+																	</option>
+																))}
+															</Form.Select>
+														</Col>
+													</Form.Group>
+													<Form.Group className="row mb-3">
+														<Col sm={5}>
+															<Form.Check
+																label={t('SettingsPage:gpio-edge-capture-label')}
+																type="switch"
+																id="gpioEdgeCapture"
+																isInvalid={false}
+																checked={Boolean(values.gpioEdgeCapture)}
+																onChange={(e) => {
+																	setFieldValue(
+																		'gpioEdgeCapture',
+																		e.target.checked ? 1 : 0,
+																	);
+																}}
+															/>
+															<Form.Text muted>
+																{t('SettingsPage:gpio-edge-capture-explanation-text')}
+															</Form.Text>
+														</Col>
+													</Form.Group>
+													<Form.Group className="row mb-3">
+														<Col sm={5}>
+															<Form.Check
+																label={t('SettingsPage:gpio-oversampling-label')}
+																type="switch"
+																id="gpioOversampling"
+																isInvalid={false}
+																checked={Boolean(values.gpioOversampling)}
+																onChange={(e) => {
+																	setFieldValue(
+																		'gpioOversampling',
+																		e.target.checked ? 1 : 0,
+																	);
+																}}
+															/>
+															<Form.Text muted>
+																{t('SettingsPage:gpio-oversampling-explanation-text')}
+															</Form.Text>
+														</Col>
+													</Form.Group>
+													<Form.Group className="row mb-3">
+														<Col sm={5}>
+															<Form.Check
+																label={t('SettingsPage:idle-sleep-label')}
+																type="switch"
+																id="idleSleep"
+																isInvalid={false}
+																checked={Boolean(values.idleSleep)}
+																onChange={(e) => {
+																	setFieldValue(
+																		'idleSleep',
+																		e.target.checked ? 1 : 0,
+																	);
+																}}
+															/>
+															<Form.Text muted>
+																{t('SettingsPage:idle-sleep-explanation-text')}
+															</Form.Text>
+														</Col>
+													</Form.Group>
+													<Form.Group className="row mb-3">
+														<Col sm={5}>
+															<Form.Check
+																label={t('SettingsPage:usb-sof-sync-label')}
+																type="switch"
+																id="usbSofSync"
+																isInvalid={false}
+																checked={Boolean(values.usbSofSync)}
+																onChange={(e) => {
+																	setFieldValue(
+																		'usbSofSync',
+																		e.target.checked ? 1 : 0,
+																	);
+																}}
+															/>
+															<Form.Text muted>
+																{t('SettingsPage:usb-sof-sync-explanation-text')}
+															</Form.Text>
+														</Col>
+													</Form.Group>
+													{Boolean(values.usbSofSync) && (
+														<Form.Group className="row mb-3">
+															<Form.Label>
+																{t('SettingsPage:usb-sof-sync-margin-label')}
+															</Form.Label>
+															<Col sm={3}>
+																<Form.Control
+																	type="number"
+																	name="usbSofSyncMarginUs"
+																	className="form-control-sm"
+																	value={values.usbSofSyncMarginUs}
+																	error={errors.usbSofSyncMarginUs}
+																	isInvalid={errors.usbSofSyncMarginUs}
+																	onChange={handleChange}
+																	min={0}
+																	max={500}
+																/>
+															</Col>
+														</Form.Group>
+													)}
 													<Form.Group className="row mb-5">
 														<Col sm={5}>
 															<Form.Check
@@ -1867,6 +2022,34 @@ export default function SettingsPage() {
 																	key={`hotkey-${i}-base`}
 																	className={`row row-gap-2 align-items-center gx-2`}
 																>
+																	<Col sm="auto">
+																		<Form.Select
+																			name={`${o}.firstButtonsMask`}
+																			className="form-select-sm sm-1"
+																			title={t('SettingsPage:hotkey-chord-first-step-label')}
+																			value={(values[o] && values[o]?.firstButtonsMask) || 0}
+																			onChange={(e) => {
+																				setFieldValue(
+																					`${o}.firstButtonsMask`,
+																					parseInt(e.target.value),
+																				);
+																			}}
+																		>
+																			{BUTTON_MASKS_OPTIONS.map((o, i2) => (
+																				<option
+																					key={`hotkey-${i}-firstButton-${i2}`}
+																					value={o.value}
+																				>
+																					{o.label in currentButtonLabels
+																						? currentButtonLabels[o.label]
+																						: o.label}
+																				</option>
+																			))}
+																		</Form.Select>
+																	</Col>
+																	<Col sm="auto">
+																		{t('SettingsPage:hotkey-chord-then')}
+																	</Col>
 																	<Col
 																		sm="auto"
 																		className="d-flex align-items-center"
@@ -2006,6 +2189,8 @@ export default function SettingsPage() {
 																				onClick={() => {
 																					setFieldValue(`${o}.action`, 0);
 																					setFieldValue(`${o}.buttonsMask`, 0);
+																					setFieldValue(`${o}.firstButtonsMask`, 0);
+																					setFieldValue(`${o}.firstAuxMask`, 0);
 																				}}
 																			>
 																				{'✕'}
@@ -0,0 +1,56 @@
+import { create } from 'zustand';
+import { baseUrl } from '../Services/WebApi';
+
+type PhaseStats = {
+	lastUs: number;
+	avgUs: number;
+	maxUs: number;
+};
+
+export type AddonProfile = {
+	name: string;
+	core: number;
+	budgetUs: number;
+	overruns: number;
+	overBudget: boolean;
+	interval: number;
+	preprocess: PhaseStats;
+	process: PhaseStats;
+	postprocess: PhaseStats;
+};
+
+type State = {
+	addons: AddonProfile[];
+	previousBoot: boolean;
+	loading: boolean;
+	error: boolean;
+};
+
+type Actions = {
+	fetchAddonProfile: () => void;
+};
+
+const INITIAL_STATE: State = {
+	addons: [],
+	previousBoot: false,
+	loading: false,
+	error: false,
+};
+
+const useAddonProfileStore = create<State & Actions>()((set) => ({
+	...INITIAL_STATE,
+	fetchAddonProfile: async () => {
+		set({ loading: true });
+
+		try {
+			const { addons, previousBoot } = await fetch(
+				`${baseUrl}/api/getAddonProfile`,
+			).then((res) => res.json());
+			set({ addons, previousBoot: Boolean(previousBoot), loading: false, error: false });
+		} catch (error) {
+			set({ error: true, loading: false });
+		}
+	},
+}));
+
+export default useAddonProfileStore;